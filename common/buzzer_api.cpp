@@ -5,6 +5,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include "buzzer_api.h"
+#include "thread_plan.h"
 #include <cstdio>
 
 typedef struct {
@@ -33,6 +34,8 @@ static void *beep_worker(void *arg)
 	int freq = p->frequencyHz;
 	int dur  = p->durationMs;
 
+	thread_plan_apply("buzzer");
+
 	/* Bắt đầu tone */
 	pinMode(pin, PWM_OUTPUT);
 	pwmToneWrite(pin, freq);
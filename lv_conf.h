@@ -93,6 +93,17 @@
  * (Not so important, you can adjust it to modify default sizes and spaces.) */
 #define LV_DPI_DEF 130              /**< [px/inch] */
 
+/** Invalidated areas are joined if it adds at most this many percent of redrawn pixels
+ * over the pixels actually invalidated by the two areas.
+ * When more areas are invalidated than the area buffer can hold, the two areas adding
+ * the least overdraw are joined instead of redrawing the whole screen. */
+#define LV_REFR_JOIN_OVERDRAW 25    /**< [%] */
+
+/** Before drawing an area, collect at most this many opaque widgets covering parts of it, front to back.
+ * Widgets fully hidden behind them are not drawn, and the drawing of partially hidden ones
+ * is clipped to the uncovered part where it remains a rectangle. Set it to 0 to disable. */
+#define LV_REFR_OCCLUDER_MAX 16
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -106,7 +117,7 @@
  * - LV_OS_MQX
  * - LV_OS_SDL2
  * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+#define LV_USE_OS   LV_OS_PTHREAD
 
 #if LV_USE_OS == LV_OS_CUSTOM
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
@@ -150,6 +161,16 @@
  * Set it to 0 to have no limit. */
 #define LV_DRAW_LAYER_MAX_MEMORY 0  /**< No limit by default [bytes]*/
 
+/** Index the draw tasks of a layer on a grid once checking the dependencies of a draw task
+ * had to look at more than this many older tasks. It keeps dispatching fast on complex screens
+ * with hundreds of draw tasks. Set it to 0 to always check all the older tasks. */
+#define LV_DRAW_TASK_GRID_THRESHOLD 32
+
+/** Keep up to this many finished draw tasks to reuse them for the next draw tasks
+ * instead of allocating and freeing every draw task and its descriptor on the heap.
+ * Set it to 0 to allocate each draw task separately. */
+#define LV_DRAW_TASK_POOL_CNT 4096
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -193,6 +214,16 @@
      *  - > 1 means multiple threads will render the screen in parallel. */
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
+    /** Split large draw tasks into horizontal bands rendered in parallel by this many threads:
+     *  the render thread of the draw unit and LV_DRAW_SW_BAND_THREAD_CNT - 1 helper threads.
+     *  Unlike more draw units it helps also when a single task (e.g. a full screen fill or image) dominates.
+     *  - 1: disabled
+     *  - > 1 requires operating system to be enabled in `LV_USE_OS`. */
+    #define LV_DRAW_SW_BAND_THREAD_CNT  4
+
+    /** Only draw tasks covering at least this many pixels (after clipping) are split into bands. */
+    #define LV_DRAW_SW_BAND_MIN_PX      (64 * 1024)
+
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
 
@@ -207,8 +238,12 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /** Allow buffering some shadow calculation.
          *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
+         *  `shadow_width + radius`.  A buffered corner has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost
+         *  at most.  The most recently used corners are kept for each rectangle size, radius and
+         *  shadow width until they fit into LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE bytes.
+         *  - 0: disables caching */
+        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 64
+        #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE (64 * 1024)
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
@@ -217,7 +252,13 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
-    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    /** The H618 is AArch64: the NEON blend kernels are built from intrinsics there
+     *  (see src/draw/sw/blend/neon/lv_blend_neon.h). Other hosts use the C implementation. */
+    #if defined(__aarch64__)
+        #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NEON
+    #else
+        #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    #endif
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
         #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
@@ -226,6 +267,11 @@
     /** Enable drawing complex gradients in software: linear at an angle, radial or conical */
     #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    1
 
+    /** Size of the cache of gradient color ramps in bytes. The widgets with the same gradient stops
+     *  share the ramps instead of interpolating the colors again on every redraw.
+     *  - 0: disables caching */
+    #define LV_DRAW_SW_GRADIENT_CACHE_SIZE      (32 * 1024)
+
 #endif
 
 /*Use TSi's aka (Think Silicon) NemaGFX */
@@ -485,11 +531,21 @@
  *  If size is not set to 0, the decoder will fail to decode when the cache is full.
  *  If size is 0, the cache function is not enabled and the decoded memory will be
  *  released immediately after use. */
-#define LV_CACHE_DEF_SIZE       0
+#define LV_CACHE_DEF_SIZE       (16 * 1024 * 1024)
 
 /** Default number of image header cache entries. The cache is used to store the headers of images
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
-#define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT 32
+
+/** Decode large images on this many worker threads instead of the LVGL thread.
+ *  Until an image is decoded into the image cache its widget draws a placeholder
+ *  and it's invalidated when the image is ready.
+ *  - 0: disabled
+ *  - > 0 requires operating system to be enabled in `LV_USE_OS` and `LV_CACHE_DEF_SIZE` > 0. */
+#define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 2
+
+/** Only images having at least this many pixels are decoded asynchronously. */
+#define LV_IMAGE_DECODER_ASYNC_MIN_PX (128 * 128)
 
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
@@ -506,6 +562,14 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      1
 
+/** 1: Enable `LV_OBJ_FLAG_RENDER_CACHE` to keep static widget subtrees rendered in a draw buffer
+ *  and blit it on later redraws instead of drawing the widgets again. */
+#define LV_USE_OBJ_RENDER_CACHE 1
+#if LV_USE_OBJ_RENDER_CACHE
+    /** Memory limit of all render caches in bytes. The least recently used caches are freed to stay below it. */
+    #define LV_OBJ_RENDER_CACHE_SIZE    (16 * 1024 * 1024)
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -1240,6 +1304,20 @@
     #define LV_LINUX_FBDEV_BUFFER_COUNT  2
     #define LV_LINUX_FBDEV_BUFFER_SIZE   1080
     #define LV_LINUX_FBDEV_MMAP          1
+    /** Render directly into a double-height framebuffer (`yres_virtual = 2*yres`) and flip with `FBIOPAN_DISPLAY`.
+     *  Falls back to the buffers above if the driver can't pan. Requires `LV_LINUX_FBDEV_MMAP`.
+     *  Off on this target: it replaces the tiled draw buffers, the async flush thread and the STNP copy below,
+     *  and blending straight into the uncached framebuffer is slower on the H618*/
+    #define LV_LINUX_FBDEV_PAGE_FLIP     0
+    /** Copy the draw buffer to the framebuffer in a separate thread so LVGL can render into the other buffer meanwhile.
+     *  Used only with `LV_LINUX_FBDEV_BUFFER_COUNT 2` (and not with page flipping). */
+    #define LV_LINUX_FBDEV_ASYNC_FLUSH   1
+    /** Split the partial buffer into tiles of about this many bytes (e.g. 1920x34 rows or 256x256 px at 16 bpp)
+     *  so a tile stays in the L2 cache while it's blended. 0: render as much as the buffer holds. PARTIAL mode only. */
+    #define LV_LINUX_FBDEV_TILE_SIZE     (256 * 1024)
+    /** Measure the render time of a few tile sizes around `LV_LINUX_FBDEV_TILE_SIZE` and the whole buffer
+     *  on the first frames, then keep the fastest one. */
+    #define LV_LINUX_FBDEV_TILE_AUTO     1
 #endif
 
 /** Use Nuttx to open window and handle touchscreen */
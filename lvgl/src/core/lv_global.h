@@ -22,6 +22,7 @@ extern "C" {
 #endif
 #include "../misc/lv_anim.h"
 #include "../misc/lv_area.h"
+#include "../misc/lv_array.h"
 #include "../misc/lv_color_op.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_log.h"
@@ -49,6 +50,7 @@ extern "C" {
 #include "../tick/lv_tick_private.h"
 #include "../draw/lv_draw_buf_private.h"
 #include "../draw/lv_draw_private.h"
+#include "../draw/lv_image_decoder_private.h"
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
@@ -89,6 +91,16 @@ typedef struct _lv_global_t {
     lv_display_t * disp_refresh;
     lv_display_t * disp_default;
 
+#if LV_REFR_OCCLUDER_MAX
+    bool refr_occlusion_disabled;
+    lv_layer_t * refr_occlusion_layer;                  /**< The layer the occlusion was calculated for*/
+    lv_area_t refr_occluders[LV_REFR_OCCLUDER_MAX];     /**< Opaque areas collected front to back*/
+    uint32_t refr_occluder_cnt;
+    lv_array_t refr_occlusion_entries;                  /**< The widgets to skip or clip on `refr_occlusion_layer`*/
+    lv_obj_t * refr_occlusion_hole_obj;                 /**< Draw the main part of this widget around the hole*/
+    lv_area_t refr_occlusion_hole;
+#endif
+
     lv_ll_t style_trans_ll;
     bool style_refresh;
     uint32_t style_custom_table_size;
@@ -98,6 +110,12 @@ typedef struct _lv_global_t {
     lv_ll_t group_ll;
     lv_group_t * group_default;
 
+#if LV_USE_OBJ_RENDER_CACHE
+    lv_ll_t obj_render_cache_ll;        /**< `lv_obj_render_cache_t`s, the most recently drawn first*/
+    uint32_t obj_render_cache_size;     /**< Size of all render cache buffers in bytes*/
+    uint32_t obj_render_cache_pass;     /**< Incremented before rendering each area*/
+#endif
+
     lv_ll_t indev_ll;
     lv_indev_t * indev_active;
     lv_obj_t * indev_obj_active;
@@ -125,12 +143,19 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+    lv_ll_t img_cache_pinned_ll;    /**< Image cache entries held by `lv_image_cache_pin()` */
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    lv_image_decoder_async_t img_decoder_async;
+#endif
 
     lv_draw_global_info_t draw_info;
     lv_ll_t draw_sw_blend_handler_ll;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
     lv_draw_sw_shadow_cache_t sw_shadow_cache;
 #endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    lv_cache_t * sw_grad_cache;
+#endif
 #if LV_DRAW_SW_COMPLEX
     lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
 #endif
@@ -26,6 +26,7 @@
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
 #include "lv_obj_draw_private.h"
+#include "lv_obj_render_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -293,6 +294,9 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+#if LV_USE_OBJ_RENDER_CACHE
+    if(f & LV_OBJ_FLAG_RENDER_CACHE) lv_obj_render_cache_delete(obj);
+#endif
 }
 
 void lv_obj_set_flag(lv_obj_t * obj, lv_obj_flag_t f, bool v)
@@ -535,6 +539,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         }
 
         lv_event_remove_all(&obj->spec_attr->event_list);
+#if LV_USE_OBJ_RENDER_CACHE
+        lv_obj_render_cache_delete(obj);
+#endif
 #if LV_USE_OBJ_NAME
         if(obj->spec_attr->name && !obj->spec_attr->name_static) {
             lv_free((void *)obj->spec_attr->name);
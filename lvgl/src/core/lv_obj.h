@@ -115,6 +115,8 @@ typedef enum {
 #if LV_USE_FLEX
     LV_OBJ_FLAG_FLEX_IN_NEW_TRACK = (1L << 21),     /**< Start a new flex track on this item*/
 #endif
+    LV_OBJ_FLAG_RENDER_CACHE    = (1L << 22), /**< Keep the widget and its children rendered in a buffer and redraw them
+                                                *   only where they were invalidated. Requires `LV_USE_OBJ_RENDER_CACHE`*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
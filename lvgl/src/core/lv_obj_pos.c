@@ -12,6 +12,7 @@
 #include "lv_obj_draw_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_render_cache_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
@@ -823,6 +824,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_USE_OBJ_RENDER_CACHE
+    /*Update the caches even if the area is not visible now, e.g. on an other screen*/
+    lv_obj_render_cache_invalidate(obj, area);
+#endif
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
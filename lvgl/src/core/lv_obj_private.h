@@ -35,6 +35,9 @@ struct _lv_obj_spec_attr_t {
     lv_matrix_t * matrix;           /**< The transform matrix*/
 #endif
     lv_event_list_t event_list;
+#if LV_USE_OBJ_RENDER_CACHE
+    lv_obj_render_cache_t * render_cache;   /**< The rendered widget if `LV_OBJ_FLAG_RENDER_CACHE` is set*/
+#endif
 #if LV_USE_OBJ_NAME
     const char * name;              /**< Pointer to the name */
 #endif
@@ -76,6 +79,9 @@ struct _lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+#if LV_REFR_OCCLUDER_MAX
+    uint16_t refr_occluded : 1;     /**< Hidden by opaque widgets, it has an entry in `refr_occlusion_entries`*/
+#endif
 };
 
 
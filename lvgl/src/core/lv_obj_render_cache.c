@@ -0,0 +1,273 @@
+/**
+ * @file lv_obj_render_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_render_cache_private.h"
+#if LV_USE_OBJ_RENDER_CACHE
+
+#include "lv_obj_private.h"
+#include "lv_obj_draw_private.h"
+#include "lv_obj_event_private.h"
+#include "lv_refr_private.h"
+#include "lv_global.h"
+#include "../display/lv_display_private.h"
+#include "../draw/lv_draw_private.h"
+#include "../draw/lv_draw_image.h"
+#include "../misc/lv_area_private.h"
+#include "../misc/cache/instance/lv_image_cache.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define cache_ll        (LV_GLOBAL_DEFAULT()->obj_render_cache_ll)
+#define cache_size      (LV_GLOBAL_DEFAULT()->obj_render_cache_size)
+#define cache_pass      (LV_GLOBAL_DEFAULT()->obj_render_cache_pass)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void get_cache_area(const lv_obj_t * obj, lv_area_t * area);
+static lv_color_format_t get_color_format(lv_layer_t * layer, lv_obj_t * obj, const lv_area_t * area);
+static bool make_room(uint32_t size);
+static void free_draw_buf(lv_obj_render_cache_t * cache);
+static void render(lv_obj_t * obj, lv_obj_render_cache_t * cache, const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_render_cache_init(void)
+{
+    lv_ll_init(&cache_ll, sizeof(lv_obj_render_cache_t));
+    cache_size = 0;
+    cache_pass = 0;
+}
+
+void lv_obj_render_cache_deinit(void)
+{
+    lv_obj_render_cache_t * cache = lv_ll_get_head(&cache_ll);
+    while(cache) {
+        lv_obj_render_cache_t * cache_next = lv_ll_get_next(&cache_ll, cache);
+        lv_obj_render_cache_delete(cache->obj);
+        cache = cache_next;
+    }
+}
+
+lv_result_t lv_obj_render_cache_draw(lv_layer_t * layer, lv_obj_t * obj)
+{
+    /*The cache is rendered without the opacity and recoloring of the parents,
+     *with an other blend mode the widget would blend with the cache's background,
+     *and overflowing children would be clipped*/
+    if(layer->opa < LV_OPA_MAX || layer->recolor.alpha > LV_OPA_MIN) return LV_RESULT_INVALID;
+    if(lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) != LV_BLEND_MODE_NORMAL) return LV_RESULT_INVALID;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return LV_RESULT_INVALID;
+    if(lv_refr_get_disp_refreshing() == NULL) return LV_RESULT_INVALID;
+
+    lv_area_t area;
+    get_cache_area(obj, &area);
+
+    lv_area_t clip_area;
+    if(!lv_area_intersect(&clip_area, &layer->_clip_area, &area)) return LV_RESULT_OK;
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr == NULL) return LV_RESULT_INVALID;
+
+    lv_obj_render_cache_t * cache = obj->spec_attr->render_cache;
+    if(cache == NULL) {
+        cache = lv_ll_ins_head(&cache_ll);
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return LV_RESULT_INVALID;
+        lv_memzero(cache, sizeof(lv_obj_render_cache_t));
+        cache->obj = obj;
+        obj->spec_attr->render_cache = cache;
+    }
+    else {
+        lv_ll_move_before(&cache_ll, cache, lv_ll_get_head(&cache_ll));
+    }
+    cache->pass = cache_pass;
+
+    int32_t w = lv_area_get_width(&area);
+    int32_t h = lv_area_get_height(&area);
+    lv_color_format_t cf = get_color_format(layer, obj, &area);
+    lv_draw_buf_t * draw_buf = cache->draw_buf;
+    if(draw_buf == NULL || draw_buf->header.w != w || draw_buf->header.h != h || draw_buf->header.cf != cf) {
+        free_draw_buf(cache);
+
+        if(!make_room(lv_draw_buf_width_to_stride(w, cf) * h)) return LV_RESULT_INVALID;
+        draw_buf = lv_draw_buf_create(w, h, cf, LV_STRIDE_AUTO);
+        if(draw_buf == NULL) return LV_RESULT_INVALID;
+
+        cache->draw_buf = draw_buf;
+        cache_size += draw_buf->data_size;
+        lv_area_set(&cache->dirty, 0, 0, w - 1, h - 1);
+        cache->has_dirty = true;
+    }
+
+    if(cache->has_dirty) {
+        render(obj, cache, &area);
+        cache->has_dirty = false;
+    }
+
+    lv_draw_image_dsc_t draw_dsc;
+    lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.src = draw_buf;
+    lv_draw_image(layer, &draw_dsc, &area);
+
+    return LV_RESULT_OK;
+}
+
+void lv_obj_render_cache_invalidate(const lv_obj_t * obj, const lv_area_t * area)
+{
+    if(lv_ll_is_empty(&cache_ll)) return;
+
+    /*The cache of every parent shows the invalidated area too*/
+    while(obj) {
+        lv_obj_render_cache_t * cache = obj->spec_attr ? obj->spec_attr->render_cache : NULL;
+        if(cache && cache->draw_buf) {
+            lv_area_t cache_area;
+            lv_area_t a;
+            get_cache_area(obj, &cache_area);
+            if(lv_area_intersect(&a, area, &cache_area)) {
+                lv_area_move(&a, -cache_area.x1, -cache_area.y1);
+                if(cache->has_dirty) lv_area_join(&cache->dirty, &cache->dirty, &a);
+                else cache->dirty = a;
+                cache->has_dirty = true;
+            }
+        }
+        obj = obj->parent;
+    }
+}
+
+void lv_obj_render_cache_delete(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->render_cache == NULL) return;
+
+    lv_obj_render_cache_t * cache = obj->spec_attr->render_cache;
+    free_draw_buf(cache);
+    obj->spec_attr->render_cache = NULL;
+    lv_ll_remove(&cache_ll, cache);
+    lv_free(cache);
+}
+
+void lv_obj_render_cache_next_pass(void)
+{
+    cache_pass++;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void get_cache_area(const lv_obj_t * obj, lv_area_t * area)
+{
+    int32_t ext_size = lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, area);
+    lv_area_increase(area, ext_size, ext_size);
+}
+
+/**
+ * Use the layer's color format if the widget covers its whole cached area so that the cache
+ * is copied as it is. Else an alpha channel is needed.
+ */
+static lv_color_format_t get_color_format(lv_layer_t * layer, lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_color_format_t cf = layer->color_format;
+    if(cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB888 && cf != LV_COLOR_FORMAT_XRGB8888) {
+        return LV_COLOR_FORMAT_ARGB8888;
+    }
+
+    if(!lv_area_is_in(area, &obj->coords, 0)) return LV_COLOR_FORMAT_ARGB8888;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = area;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    return info.res == LV_COVER_RES_COVER ? cf : LV_COLOR_FORMAT_ARGB8888;
+}
+
+/**
+ * Free the draw buffer of the least recently used caches until `size` bytes fit into the budget.
+ * The caches drawn in the current pass are kept as draw tasks might still read them.
+ */
+static bool make_room(uint32_t size)
+{
+    if(size > LV_OBJ_RENDER_CACHE_SIZE) return false;
+
+    lv_obj_render_cache_t * cache = lv_ll_get_tail(&cache_ll);
+    while(cache && cache_size + size > LV_OBJ_RENDER_CACHE_SIZE) {
+        if(cache->pass != cache_pass) free_draw_buf(cache);
+        cache = lv_ll_get_prev(&cache_ll, cache);
+    }
+
+    return cache_size + size <= LV_OBJ_RENDER_CACHE_SIZE;
+}
+
+static void free_draw_buf(lv_obj_render_cache_t * cache)
+{
+    if(cache->draw_buf == NULL) return;
+
+    lv_image_cache_drop(cache->draw_buf);
+    cache_size -= cache->draw_buf->data_size;
+    lv_draw_buf_destroy(cache->draw_buf);
+    cache->draw_buf = NULL;
+    cache->has_dirty = false;
+}
+
+/**
+ * Render the dirty area of the cache like `lv_snapshot_take_to_draw_buf` and wait until it's ready
+ */
+static void render(lv_obj_t * obj, lv_obj_render_cache_t * cache, const lv_area_t * area)
+{
+    LV_PROFILER_REFR_BEGIN;
+    lv_draw_buf_t * draw_buf = cache->draw_buf;
+    if(draw_buf->header.cf == LV_COLOR_FORMAT_ARGB8888) lv_draw_buf_clear(draw_buf, &cache->dirty);
+
+    lv_area_t clip_area = cache->dirty;
+    lv_area_move(&clip_area, area->x1, area->y1);
+
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = draw_buf;
+    layer.buf_area = *area;
+    layer.color_format = draw_buf->header.cf;
+    layer._clip_area = clip_area;
+    layer.phy_clip_area = clip_area;
+
+    /*Dispatch only the cache's layer (and the layers created on it) until it's ready.
+     *The tasks of the display's layers are continued after it*/
+    lv_display_t * disp = lv_refr_get_disp_refreshing();
+    lv_layer_t * layer_head_ori = disp->layer_head;
+    disp->layer_head = &layer;
+
+    lv_obj_redraw(&layer, obj);
+    while(layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp->layer_head = layer_head_ori;
+
+    /*Decoders might have cached the old content*/
+    lv_image_cache_drop(draw_buf);
+    LV_PROFILER_REFR_END;
+}
+
+#endif /*LV_USE_OBJ_RENDER_CACHE*/
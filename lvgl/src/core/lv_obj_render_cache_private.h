@@ -0,0 +1,97 @@
+/**
+ * @file lv_obj_render_cache_private.h
+ *
+ */
+
+#ifndef LV_OBJ_RENDER_CACHE_PRIVATE_H
+#define LV_OBJ_RENDER_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_conf_internal.h"
+
+#if LV_USE_OBJ_RENDER_CACHE
+
+#include "../misc/lv_types.h"
+#include "../misc/lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The rendered image of a widget with `LV_OBJ_FLAG_RENDER_CACHE` and its children.
+ * Stored in the `obj_render_cache_ll` global list, the most recently drawn first.
+ */
+struct _lv_obj_render_cache_t {
+    lv_obj_t * obj;
+    lv_draw_buf_t * draw_buf;   /**< The widget's area with the ext. draw size. NULL if freed to stay in the budget*/
+    lv_area_t dirty;            /**< Invalidated area relative to `draw_buf` to render again*/
+    uint32_t pass;              /**< `obj_render_cache_pass` when the cache was drawn last*/
+    bool has_dirty;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the list of render caches
+ */
+void lv_obj_render_cache_init(void);
+
+/**
+ * Free all render caches
+ */
+void lv_obj_render_cache_deinit(void);
+
+/**
+ * Draw a widget and its children from its render cache.
+ * The cache is created if needed and the invalidated areas are rendered again into it first.
+ * @param layer     the layer to draw to
+ * @param obj       a widget with `LV_OBJ_FLAG_RENDER_CACHE`
+ * @return          LV_RESULT_OK: drawn from the cache;
+ *                  LV_RESULT_INVALID: the cache can't be used, the widget needs to be drawn normally
+ */
+lv_result_t lv_obj_render_cache_draw(lv_layer_t * layer, lv_obj_t * obj);
+
+/**
+ * Mark an area as invalid in the render caches of a widget and its parents.
+ * @param obj       the invalidated widget
+ * @param area      the invalidated area in absolute coordinates
+ */
+void lv_obj_render_cache_invalidate(const lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Free the render cache of a widget
+ * @param obj       pointer to a widget
+ */
+void lv_obj_render_cache_delete(lv_obj_t * obj);
+
+/**
+ * Start a new render pass. The caches drawn in the current pass are not freed to make room
+ * for others as the draw tasks might still use them.
+ */
+void lv_obj_render_cache_next_pass(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OBJ_RENDER_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_RENDER_CACHE_PRIVATE_H*/
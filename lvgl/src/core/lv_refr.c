@@ -9,10 +9,12 @@
 #include "lv_refr_private.h"
 #include "lv_obj_draw_private.h"
 #include "../misc/lv_area_private.h"
+#include "../misc/lv_event_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../draw/lv_draw_mask_private.h"
 #include "lv_obj_private.h"
 #include "lv_obj_event_private.h"
+#include "lv_obj_render_cache_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../tick/lv_tick.h"
@@ -32,14 +34,37 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+#if LV_REFR_OCCLUDER_MAX
+    #define occl_layer      (LV_GLOBAL_DEFAULT()->refr_occlusion_layer)
+    #define occluders       (LV_GLOBAL_DEFAULT()->refr_occluders)
+    #define occluder_cnt    (LV_GLOBAL_DEFAULT()->refr_occluder_cnt)
+    #define occl_entries    (LV_GLOBAL_DEFAULT()->refr_occlusion_entries)
+    #define occl_hole_obj   (LV_GLOBAL_DEFAULT()->refr_occlusion_hole_obj)
+    #define occl_hole       (LV_GLOBAL_DEFAULT()->refr_occlusion_hole)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_REFR_OCCLUDER_MAX
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t clip_area;    /*Draw the widget and its children only here*/
+    lv_area_t hole;         /*Hidden part of the widget's main draw, e.g. by its children*/
+    bool has_hole;
+    bool culled;            /*Fully hidden, not drawn at all*/
+} occlusion_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static uint32_t get_join_overdraw(const lv_display_t * disp, uint32_t i1, uint32_t i2, lv_area_t * joined,
+                                  uint32_t * joined_px);
+static void inv_area_join_cheapest(lv_display_t * disp);
+static uint32_t get_union_size(const lv_area_t * areas, uint32_t cnt);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p, int32_t y_offset);
@@ -47,6 +72,14 @@ static void refr_configured_layer(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
+static void obj_draw_main(lv_layer_t * layer, lv_obj_t * obj);
+#if LV_REFR_OCCLUDER_MAX
+    static void occlusion_calc(lv_layer_t * layer);
+    static void occlusion_walk(lv_obj_t * obj, const lv_area_t * clip_area, bool can_occlude);
+    static void occlusion_clear(void);
+    static bool has_draw_main_event_cb(lv_obj_t * obj);
+    static void refr_obj_occluded(lv_layer_t * layer, lv_obj_t * obj);
+#endif
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
@@ -74,10 +107,22 @@ static void wait_for_flushing(lv_display_t * disp);
  */
 void lv_refr_init(void)
 {
+#if LV_USE_OBJ_RENDER_CACHE
+    lv_obj_render_cache_init();
+#endif
+#if LV_REFR_OCCLUDER_MAX
+    lv_array_init(&occl_entries, 32, sizeof(occlusion_entry_t));
+#endif
 }
 
 void lv_refr_deinit(void)
 {
+#if LV_USE_OBJ_RENDER_CACHE
+    lv_obj_render_cache_deinit();
+#endif
+#if LV_REFR_OCCLUDER_MAX
+    lv_array_deinit(&occl_entries);
+#endif
 }
 
 void lv_refr_now(lv_display_t * disp)
@@ -116,9 +161,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     /*If the object is visible on the current clip area*/
     layer->_clip_area = clip_coords_for_obj;
 
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+    obj_draw_main(layer, obj);
 #if LV_USE_REFR_DEBUG
     lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
     lv_draw_rect_dsc_t draw_dsc;
@@ -279,6 +322,7 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+        disp->inv_overdraw_px = 0;
         return;
     }
 
@@ -304,6 +348,7 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
     if(disp->render_mode == LV_DISPLAY_RENDER_MODE_FULL) {
         disp->inv_areas[0] = scr_area;
+        disp->inv_area_px[0] = lv_area_get_size(&scr_area);
         disp->inv_p = 1;
         lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
         return;
@@ -318,13 +363,15 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
         if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*If no place for the area join the two areas whose bounding box adds the least pixels.
+     *It keeps many small areas instead of redrawing the whole screen*/
+    if(disp->inv_p >= LV_INV_BUF_SIZE) {
+        inv_area_join_cheapest(disp);
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
+
+    /*Save the area*/
+    lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+    disp->inv_area_px[disp->inv_p] = lv_area_get_size(&com_area);
     disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
@@ -398,6 +445,11 @@ void lv_display_refr_timer(lv_timer_t * tmr)
         goto refr_finish;
     }
 
+    /*The overdraw of the areas joined on overflow is already in the areas*/
+    disp_refr->refr_dirty_px = get_union_size(disp_refr->inv_areas, disp_refr->inv_p);
+    if(disp_refr->refr_dirty_px > disp_refr->inv_overdraw_px) disp_refr->refr_dirty_px -= disp_refr->inv_overdraw_px;
+    disp_refr->refr_redrawn_px = 0;
+
     lv_refr_join_area();
     refr_sync_areas();
     refr_invalid_areas();
@@ -419,6 +471,7 @@ void lv_display_refr_timer(lv_timer_t * tmr)
     lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
     lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
     disp_refr->inv_p = 0;
+    disp_refr->inv_overdraw_px = 0;
 
 refr_finish:
 
@@ -432,12 +485,31 @@ refr_finish:
     LV_PROFILER_REFR_END;
 }
 
+void lv_refr_get_damage_px(lv_display_t * disp, uint32_t * redrawn_px, uint32_t * dirty_px)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(redrawn_px) *redrawn_px = disp ? disp->refr_redrawn_px : 0;
+    if(dirty_px) *dirty_px = disp ? disp->refr_dirty_px : 0;
+}
+
+void lv_refr_enable_occlusion(bool en)
+{
+#if LV_REFR_OCCLUDER_MAX
+    LV_GLOBAL_DEFAULT()->refr_occlusion_disabled = !en;
+#else
+    LV_UNUSED(en);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas whose bounding box doesn't add more than `LV_REFR_JOIN_OVERDRAW` percent
+ * of extra pixels. Repeat until nothing can be joined as a joined area can become joinable to others.
+ * The overdraw is measured against the invalidated pixels of the areas, not their bounding boxes,
+ * so it can't add up over repeated joins.
  */
 static void lv_refr_join_area(void)
 {
@@ -445,34 +517,171 @@ static void lv_refr_join_area(void)
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
+    uint32_t joined_px;
+    bool joined;
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
+                uint32_t overdraw = get_join_overdraw(disp_refr, join_in, join_from, &joined_area, &joined_px);
+
+                /*Join two areas only if the overdraw is in the limit*/
+                if((uint64_t)overdraw * 100 <= (uint64_t)joined_px * LV_REFR_JOIN_OVERDRAW) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+                    disp_refr->inv_area_px[join_in] = joined_px;
+
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
             }
+        }
+    } while(joined);
+    LV_PROFILER_REFR_END;
+}
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+/**
+ * Get how many pixels the bounding box of two invalidated areas adds to their invalidated pixels
+ * @param disp          pointer to a display
+ * @param i1            index of an area in `inv_areas`
+ * @param i2            index of an other area in `inv_areas`
+ * @param joined        store the bounding box here
+ * @param joined_px     store the invalidated pixels of the bounding box here
+ * @return              the number of pixels in `joined` which weren't invalidated
+ */
+static uint32_t get_join_overdraw(const lv_display_t * disp, uint32_t i1, uint32_t i2, lv_area_t * joined,
+                                  uint32_t * joined_px)
+{
+    const lv_area_t * a1 = &disp->inv_areas[i1];
+    const lv_area_t * a2 = &disp->inv_areas[i2];
+    uint32_t px1 = disp->inv_area_px[i1];
+    uint32_t px2 = disp->inv_area_px[i2];
+
+    /*Only the bounding boxes are known, so assume that the invalidated pixels of the areas
+     *overlap as much as possible. It never counts more invalidated pixels than there are.*/
+    lv_area_t common;
+    uint32_t common_px = 0;
+    if(lv_area_intersect(&common, a1, a2)) common_px = LV_MIN3(lv_area_get_size(&common), px1, px2);
+
+    lv_area_join(joined, a1, a2);
+    *joined_px = px1 + px2 - common_px;
+    return lv_area_get_size(joined) - *joined_px;
+}
+
+/**
+ * Make place in a full invalidated area buffer by joining the two areas whose bounding box adds
+ * the least pixels to redraw
+ * @param disp      pointer to a display
+ */
+static void inv_area_join_cheapest(lv_display_t * disp)
+{
+    uint32_t best_added = UINT32_MAX;
+    uint32_t best_i = 0;
+    uint32_t best_j = 1;
+    uint32_t best_px = 0;
+    lv_area_t joined_area;
+    uint32_t joined_px;
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < disp->inv_p && best_added; i++) {
+        for(j = i + 1; j < disp->inv_p; j++) {
+            /*Two areas have to be joined anyway, so compare the boxes: the overdraw of earlier joins
+             *is redrawn either way*/
+            lv_area_t pair[2] = {disp->inv_areas[i], disp->inv_areas[j]};
+            get_join_overdraw(disp, i, j, &joined_area, &joined_px);
+            uint32_t added = lv_area_get_size(&joined_area) - get_union_size(pair, 2);
+            if(added < best_added) {
+                best_added = added;
+                best_px = joined_px;
+                best_i = i;
+                best_j = j;
+                if(added == 0) break;
             }
+        }
+    }
 
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+    lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], &disp->inv_areas[best_j]);
+    disp->inv_area_px[best_i] = best_px;
+    disp->inv_overdraw_px += best_added;
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    /*Fill the place of the joined area with the last one*/
+    disp->inv_p--;
+    disp->inv_areas[best_j] = disp->inv_areas[disp->inv_p];
+    disp->inv_area_px[best_j] = disp->inv_area_px[disp->inv_p];
+}
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+/**
+ * Get the number of pixels covered by a list of areas, counting overlapping pixels only once
+ * @param areas     array of areas
+ * @param cnt       number of areas
+ * @return          size of the union of the areas
+ */
+static uint32_t get_union_size(const lv_area_t * areas, uint32_t cnt)
+{
+    /*Split the areas into horizontal bands on every top and bottom edge,
+     *and add up the covered spans of each band*/
+    int32_t ys[LV_INV_BUF_SIZE * 2];
+    int32_t xs1[LV_INV_BUF_SIZE];
+    int32_t xs2[LV_INV_BUF_SIZE];
+    uint32_t ys_cnt = 0;
+    uint32_t i;
+    uint32_t j;
+    uint32_t size = 0;
+
+    if(cnt > LV_INV_BUF_SIZE) cnt = LV_INV_BUF_SIZE;
+
+    for(i = 0; i < cnt; i++) {
+        ys[ys_cnt++] = areas[i].y1;
+        ys[ys_cnt++] = areas[i].y2 + 1;
+    }
+
+    /*Sort the band edges*/
+    for(i = 1; i < ys_cnt; i++) {
+        int32_t y = ys[i];
+        for(j = i; j > 0 && ys[j - 1] > y; j--) ys[j] = ys[j - 1];
+        ys[j] = y;
+    }
+
+    for(i = 0; i + 1 < ys_cnt; i++) {
+        int32_t band_y1 = ys[i];
+        int32_t band_y2 = ys[i + 1];
+        if(band_y1 == band_y2) continue;
+
+        /*Collect the spans crossing the band sorted by their start*/
+        uint32_t span_cnt = 0;
+        for(j = 0; j < cnt; j++) {
+            if(areas[j].y1 > band_y1 || areas[j].y2 < band_y2 - 1) continue;
+            uint32_t k;
+            for(k = span_cnt; k > 0 && xs1[k - 1] > areas[j].x1; k--) {
+                xs1[k] = xs1[k - 1];
+                xs2[k] = xs2[k - 1];
             }
+            xs1[k] = areas[j].x1;
+            xs2[k] = areas[j].x2;
+            span_cnt++;
         }
+
+        /*Merge the overlapping spans*/
+        uint32_t covered = 0;
+        int32_t x_end = INT32_MIN;
+        for(j = 0; j < span_cnt; j++) {
+            int32_t x_start = LV_MAX(xs1[j], x_end);
+            if(xs2[j] + 1 > x_start) covered += xs2[j] + 1 - x_start;
+            x_end = LV_MAX(x_end, xs2[j] + 1);
+        }
+
+        size += covered * (uint32_t)(band_y2 - band_y1);
     }
-    LV_PROFILER_REFR_END;
+
+    return size;
 }
 
 /**
@@ -610,6 +819,7 @@ static void refr_invalid_areas(void)
         disp_refr->last_part = 0;
 
         lv_area_t inv_a = disp_refr->inv_areas[i];
+        disp_refr->refr_redrawn_px += lv_area_get_size(&inv_a);
         if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
             /*Calculate the max row num*/
             int32_t w = lv_area_get_width(&inv_a);
@@ -682,6 +892,11 @@ static void layer_reshape_draw_buf(lv_layer_t * layer, uint32_t stride)
 static void refr_area(const lv_area_t * area_p, int32_t y_offset)
 {
     LV_PROFILER_REFR_BEGIN;
+#if LV_USE_OBJ_RENDER_CACHE
+    /*The draw tasks of the previous area are finished, the render caches used there can be freed*/
+    lv_obj_render_cache_next_pass();
+#endif
+
     lv_layer_t * layer = disp_refr->layer_head;
     layer->draw_buf = disp_refr->buf_act;
     layer->_clip_area = *area_p;
@@ -869,6 +1084,11 @@ static void refr_configured_layer(lv_layer_t * layer)
         top_prev_scr = lv_refr_get_top_obj(&layer->_clip_area, disp_refr->prev_scr);
     }
 
+#if LV_REFR_OCCLUDER_MAX
+    /*Find the widgets hidden behind opaque ones before drawing*/
+    if(!LV_GLOBAL_DEFAULT()->refr_occlusion_disabled) occlusion_calc(layer);
+#endif
+
     /*Draw a bottom layer background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         refr_obj_and_children(layer, lv_display_get_layer_bottom(disp_refr));
@@ -899,6 +1119,10 @@ static void refr_configured_layer(lv_layer_t * layer)
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
 
+#if LV_REFR_OCCLUDER_MAX
+    occlusion_clear();
+#endif
+
     LV_PROFILER_REFR_END;
 }
 
@@ -1185,10 +1409,52 @@ static bool refr_check_obj_clip_overflow(lv_layer_t * layer, lv_obj_t * obj)
 
 #endif /* LV_DRAW_TRANSFORM_USE_MATRIX */
 
+static void obj_draw_main(lv_layer_t * layer, lv_obj_t * obj)
+{
+#if LV_REFR_OCCLUDER_MAX
+    /*Draw only around the part hidden by the widget's children or the widgets in front of it.
+     *The children are drawn normally later.*/
+    if(obj == occl_hole_obj && layer == occl_layer) {
+        occl_hole_obj = NULL;
+
+        const lv_area_t * h = &occl_hole;
+        lv_area_t clip_area_ori = layer->_clip_area;
+        lv_area_t pieces[4];
+        lv_area_set(&pieces[0], clip_area_ori.x1, clip_area_ori.y1, clip_area_ori.x2, h->y1 - 1);
+        lv_area_set(&pieces[1], clip_area_ori.x1, h->y1, h->x1 - 1, h->y2);
+        lv_area_set(&pieces[2], h->x2 + 1, h->y1, clip_area_ori.x2, h->y2);
+        lv_area_set(&pieces[3], clip_area_ori.x1, h->y2 + 1, clip_area_ori.x2, clip_area_ori.y2);
+
+        uint32_t i;
+        for(i = 0; i < 4; i++) {
+            if(!lv_area_intersect(&layer->_clip_area, &clip_area_ori, &pieces[i])) continue;
+            lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+            lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
+            lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+        }
+        layer->_clip_area = clip_area_ori;
+        return;
+    }
+#endif
+
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+}
+
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
+#if LV_REFR_OCCLUDER_MAX
+    /*The occlusion is valid only for the layer it was calculated for,
+     *not e.g. for a snapshot or the layer of a transformed parent*/
+    if(obj->refr_occluded && layer == occl_layer) {
+        refr_obj_occluded(layer, obj);
+        return;
+    }
+#endif
+
     /*If `opa_layered != LV_OPA_COVER` draw the widget on a new layer and blend that layer with the given opacity.*/
     const lv_opa_t opa_layered = lv_obj_get_style_opa_layered(obj, LV_PART_MAIN);
     if(opa_layered <= LV_OPA_MIN) return;
@@ -1206,7 +1472,11 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 
     lv_layer_type_t layer_type = lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
-        lv_obj_redraw(layer, obj);
+#if LV_USE_OBJ_RENDER_CACHE
+        /*Blit the cached image of the widget and its children if possible*/
+        if(!lv_obj_has_flag(obj, LV_OBJ_FLAG_RENDER_CACHE) || lv_obj_render_cache_draw(layer, obj) != LV_RESULT_OK)
+#endif
+            lv_obj_redraw(layer, obj);
     }
 #if LV_DRAW_TRANSFORM_USE_MATRIX
     /*If the layer opa is full then use the matrix transform*/
@@ -1296,6 +1566,263 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     layer->recolor = layer_recolor;
 }
 
+#if LV_REFR_OCCLUDER_MAX
+
+/**
+ * Walk the widgets on the area of a layer from front to back, collect the opaque ones and mark
+ * the widgets behind them to be skipped or clipped by `refr_obj`
+ * @param layer     the layer to draw, its clip area is the area to refresh
+ */
+static void occlusion_calc(lv_layer_t * layer)
+{
+    LV_PROFILER_REFR_BEGIN;
+    occl_layer = layer;
+    occluder_cnt = 0;
+
+    /*In the reverse order of drawing in `refr_configured_layer`*/
+    lv_obj_t * scr_front = disp_refr->act_scr;
+    lv_obj_t * scr_back = disp_refr->prev_scr;
+    if(disp_refr->draw_prev_over_act) {
+        scr_front = disp_refr->prev_scr;
+        scr_back = disp_refr->act_scr;
+    }
+
+    occlusion_walk(lv_display_get_layer_sys(disp_refr), &layer->_clip_area, true);
+    occlusion_walk(lv_display_get_layer_top(disp_refr), &layer->_clip_area, true);
+    occlusion_walk(scr_front, &layer->_clip_area, true);
+    occlusion_walk(scr_back, &layer->_clip_area, true);
+    occlusion_walk(lv_display_get_layer_bottom(disp_refr), &layer->_clip_area, true);
+    LV_PROFILER_REFR_END;
+}
+
+static occlusion_entry_t * occlusion_add_entry(lv_obj_t * obj, const lv_area_t * clip_area, bool culled)
+{
+    occlusion_entry_t entry;
+    lv_memzero(&entry, sizeof(entry));
+    entry.obj = obj;
+    entry.clip_area = *clip_area;
+    entry.culled = culled;
+
+    /*If there is no memory the widget is simply drawn*/
+    if(lv_array_push_back(&occl_entries, &entry) != LV_RESULT_OK) return NULL;
+    obj->refr_occluded = 1;
+    return lv_array_back(&occl_entries);
+}
+
+/**
+ * Add the part of a widget which surely covers everything behind it to the occluders
+ * @param obj           an opaque widget without transformation
+ * @param clip_area     the area where the widget is drawn
+ */
+static void occlusion_add_occluder(lv_obj_t * obj, const lv_area_t * clip_area)
+{
+    lv_area_t area;
+    if(!lv_area_intersect(&area, clip_area, &obj->coords)) return;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &area;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    if(info.res == LV_COVER_RES_NOT_COVER) {
+        /*With rounded corners the part between the corners might still cover*/
+        int32_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+        int32_t short_side = LV_MIN(lv_area_get_width(&obj->coords), lv_area_get_height(&obj->coords));
+        r = LV_MIN(r, short_side / 2);
+        if(r == 0) return;
+
+        lv_area_t mid = obj->coords;
+        mid.y1 += r + 1;
+        mid.y2 -= r + 1;
+        if(!lv_area_intersect(&area, clip_area, &mid)) return;
+
+        info.res = LV_COVER_RES_COVER;
+        lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    }
+    if(info.res != LV_COVER_RES_COVER) return;
+
+    if(occluder_cnt < LV_REFR_OCCLUDER_MAX) {
+        occluders[occluder_cnt] = area;
+        occluder_cnt++;
+        return;
+    }
+
+    /*If there are too many, keep the largest ones*/
+    uint32_t i;
+    uint32_t min_i = 0;
+    for(i = 1; i < occluder_cnt; i++) {
+        if(lv_area_get_size(&occluders[i]) < lv_area_get_size(&occluders[min_i])) min_i = i;
+    }
+    if(lv_area_get_size(&occluders[min_i]) < lv_area_get_size(&area)) occluders[min_i] = area;
+}
+
+/**
+ * Check a widget and its children against the occluders in front of them, then add the widget as occluder
+ * @param obj           the widget to check
+ * @param clip_area     the area where the widget can be drawn
+ * @param can_occlude   false if the widget can't cover anything, e.g. because of the opacity of a parent
+ */
+static void occlusion_walk(lv_obj_t * obj, const lv_area_t * clip_area, bool can_occlude)
+{
+    if(obj == NULL) return;
+
+    /*Skip what `refr_obj` skips*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    if(lv_obj_get_style_opa_layered(obj, LV_PART_MAIN) <= LV_OPA_MIN) return;
+
+    /*The transformed and blended widgets are drawn on their own layer, leave them as they are*/
+    if(lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return;
+
+    /*The widget and its children are drawn only on this area in `lv_obj_redraw`*/
+    lv_area_t obj_area;
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &obj_area);
+    lv_area_increase(&obj_area, ext_draw_size, ext_draw_size);
+
+    lv_area_t draw_area;
+    if(!lv_area_intersect(&draw_area, clip_area, &obj_area)) return;
+
+    /*Cut the parts hidden by the occluders in front of it as long as the rest is a rectangle*/
+    lv_area_t draw_area_ori = draw_area;
+    bool cut = true;
+    while(cut) {
+        cut = false;
+        uint32_t i;
+        for(i = 0; i < occluder_cnt; i++) {
+            const lv_area_t * o = &occluders[i];
+            if(lv_area_is_in(&draw_area, o, 0)) {
+                occlusion_add_entry(obj, &draw_area, true);
+                return;
+            }
+            if(!lv_area_is_on(&draw_area, o)) continue;
+
+            if(o->x1 <= draw_area.x1 && o->x2 >= draw_area.x2) {
+                if(o->y1 <= draw_area.y1) draw_area.y1 = o->y2 + 1;
+                else if(o->y2 >= draw_area.y2) draw_area.y2 = o->y1 - 1;
+                else continue;
+                cut = true;
+            }
+            else if(o->y1 <= draw_area.y1 && o->y2 >= draw_area.y2) {
+                if(o->x1 <= draw_area.x1) draw_area.x1 = o->x2 + 1;
+                else if(o->x2 >= draw_area.x2) draw_area.x2 = o->x1 - 1;
+                else continue;
+                cut = true;
+            }
+        }
+    }
+    uint32_t entry_idx = UINT32_MAX;
+    if(!lv_area_is_equal(&draw_area, &draw_area_ori) && occlusion_add_entry(obj, &draw_area, false)) {
+        entry_idx = lv_array_size(&occl_entries) - 1;
+    }
+
+    /*With rounded clipping the children are drawn on other layers and masked*/
+    bool opaque = lv_obj_get_style_opa(obj, LV_PART_MAIN) >= LV_OPA_MAX;
+    bool children_can_occlude = can_occlude && opaque && !lv_obj_get_style_clip_corner(obj, LV_PART_MAIN);
+
+    lv_area_t children_area;
+    const lv_area_t * obj_coords = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE) ? &obj_area : &obj->coords;
+    if(lv_area_intersect(&children_area, &draw_area, obj_coords)) {
+        int32_t i;
+        int32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = child_cnt - 1; i >= 0; i--) {
+            occlusion_walk(obj->spec_attr->children[i], &children_area, children_can_occlude);
+        }
+    }
+
+    /*The children are drawn after the main part of the widget too. If the largest occluder hides
+     *a considerable part of it, draw the main part around it. It sends the draw events once for each piece,
+     *so don't do it if the widget has its own draw handlers: they expect the events once per refresh.*/
+    lv_area_t hole;
+    uint32_t hole_size = 0;
+    uint32_t i;
+    for(i = 0; i < occluder_cnt; i++) {
+        lv_area_t a;
+        if(!lv_area_intersect(&a, &draw_area, &occluders[i])) continue;
+        uint32_t size = lv_area_get_size(&a);
+        if(size > hole_size) {
+            hole = a;
+            hole_size = size;
+        }
+    }
+    if(hole_size >= lv_area_get_size(&draw_area) / 4 && !has_draw_main_event_cb(obj)) {
+        occlusion_entry_t * entry;
+        if(entry_idx != UINT32_MAX) entry = lv_array_at(&occl_entries, entry_idx);
+        else entry = occlusion_add_entry(obj, &draw_area, false);
+
+        if(entry) {
+            entry->hole = hole;
+            entry->has_hole = true;
+        }
+    }
+
+    if(can_occlude && opaque) occlusion_add_occluder(obj, &draw_area);
+}
+
+static void occlusion_clear(void)
+{
+    uint32_t i;
+    uint32_t entry_cnt = lv_array_size(&occl_entries);
+    for(i = 0; i < entry_cnt; i++) {
+        occlusion_entry_t * entry = lv_array_at(&occl_entries, i);
+        entry->obj->refr_occluded = 0;
+    }
+    lv_array_clear(&occl_entries);
+    occl_layer = NULL;
+    occl_hole_obj = NULL;
+    occluder_cnt = 0;
+}
+
+/**
+ * Check if an event callback was added to a widget for the main draw events
+ * @param obj       pointer to a widget
+ * @return          true: an added callback receives `LV_EVENT_DRAW_MAIN_BEGIN/MAIN/END`
+ */
+static bool has_draw_main_event_cb(lv_obj_t * obj)
+{
+    uint32_t i;
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    for(i = 0; i < event_cnt; i++) {
+        uint32_t filter = lv_obj_get_event_dsc(obj, i)->filter & ~LV_EVENT_PREPROCESS;
+        if(filter == LV_EVENT_ALL || filter == LV_EVENT_DRAW_MAIN_BEGIN || filter == LV_EVENT_DRAW_MAIN ||
+           filter == LV_EVENT_DRAW_MAIN_END) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Skip a widget hidden by opaque widgets or draw it only where it's visible
+ */
+static void refr_obj_occluded(lv_layer_t * layer, lv_obj_t * obj)
+{
+    occlusion_entry_t * entry = NULL;
+    uint32_t i;
+    uint32_t entry_cnt = lv_array_size(&occl_entries);
+    for(i = 0; i < entry_cnt; i++) {
+        occlusion_entry_t * e = lv_array_at(&occl_entries, i);
+        if(e->obj == obj) {
+            entry = e;
+            break;
+        }
+    }
+    if(entry == NULL || entry->culled) return;
+
+    lv_area_t clip_area_ori = layer->_clip_area;
+    if(lv_area_intersect(&layer->_clip_area, &clip_area_ori, &entry->clip_area)) {
+        if(entry->has_hole) {
+            occl_hole_obj = obj;
+            occl_hole = entry->hole;
+        }
+        obj->refr_occluded = 0;
+        refr_obj(layer, obj);
+        obj->refr_occluded = 1;
+        occl_hole_obj = NULL;
+    }
+    layer->_clip_area = clip_area_ori;
+}
+
+#endif /*LV_REFR_OCCLUDER_MAX*/
+
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 {
     lv_color_format_t cf = disp->color_format;
@@ -63,6 +63,23 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj);
  */
 void lv_display_refr_timer(lv_timer_t * timer);
 
+/**
+ * Get the pixel counters of the last refresh of a display.
+ * The difference is the overdraw caused by joining the invalidated areas.
+ * @param disp          pointer to a display, NULL to use the default display
+ * @param redrawn_px    store the number of rendered pixels here (can be NULL)
+ * @param dirty_px      store the number of invalidated pixels here (can be NULL)
+ */
+void lv_refr_get_damage_px(lv_display_t * disp, uint32_t * redrawn_px, uint32_t * dirty_px);
+
+/**
+ * Enable or disable skipping the widgets hidden behind opaque widgets while refreshing.
+ * It's enabled by default if `LV_REFR_OCCLUDER_MAX > 0`. Disabling it is useful to compare the
+ * overdraw and render time.
+ * @param en    true: enable; false: disable
+ */
+void lv_refr_enable_occlusion(bool en);
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -104,8 +104,12 @@ struct _lv_display_t {
     /** Invalidated (marked to redraw) areas*/
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
+    uint32_t inv_area_px[LV_INV_BUF_SIZE];  /**< Invalidated pixels of each area, less than its size if areas were joined into it */
     uint32_t inv_p;
     int32_t inv_en_cnt;
+    uint32_t inv_overdraw_px;   /**< Pixels added to `inv_areas` by joining areas on buffer overflow */
+    uint32_t refr_redrawn_px;   /**< Pixels rendered in the last refresh */
+    uint32_t refr_dirty_px;     /**< Pixels invalidated for the last refresh */
 
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
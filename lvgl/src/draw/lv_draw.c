@@ -27,9 +27,27 @@
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+/*Don't split the layers to smaller cells than this*/
+#define TASK_GRID_MIN_CELL_SIZE     32
+
+/*Size of the pooled draw tasks. The vector and 3D descriptors are larger, those tasks are not pooled.*/
+#define TASK_POOL_BLOCK_SIZE        (LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + sizeof(draw_dsc_union_t))
+
 /**********************
  *      TYPEDEFS
  **********************/
+typedef union {
+    lv_draw_fill_dsc_t fill;
+    lv_draw_border_dsc_t border;
+    lv_draw_box_shadow_dsc_t box_shadow;
+    lv_draw_letter_dsc_t letter;
+    lv_draw_label_dsc_t label;
+    lv_draw_image_dsc_t image;
+    lv_draw_line_dsc_t line;
+    lv_draw_arc_dsc_t arc;
+    lv_draw_triangle_dsc_t triangle;
+    lv_draw_mask_rect_dsc_t mask_rect;
+} draw_dsc_union_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -38,6 +56,16 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
 static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
 static inline size_t get_draw_dsc_size(lv_draw_task_type_t type);
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer);
+static lv_draw_task_t * task_alloc(size_t dsc_size);
+static void task_free(lv_draw_task_t * t);
+
+#if LV_DRAW_TASK_GRID_THRESHOLD
+    static void task_grid_create(lv_layer_t * layer);
+    static void task_grid_delete(lv_layer_t * layer);
+    static bool task_grid_add(lv_draw_task_grid_t * grid, lv_draw_task_t * t);
+    static void task_grid_remove(lv_draw_task_grid_t * grid, lv_draw_task_t * t);
+    static bool task_grid_is_independent(lv_draw_task_grid_t * grid, lv_draw_task_t * t_check);
+#endif
 
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
@@ -80,6 +108,15 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+#if LV_DRAW_TASK_POOL_CNT
+    while(_draw_info.task_pool) {
+        lv_draw_task_t * t = _draw_info.task_pool;
+        _draw_info.task_pool = t->next;
+        lv_free(t);
+    }
+    _draw_info.task_pool_cnt = 0;
+#endif
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -101,7 +138,7 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     LV_PROFILER_DRAW_BEGIN;
     size_t dsc_size = get_draw_dsc_size(type);
     LV_ASSERT_FORMAT_MSG(dsc_size > 0, "Draw task size is 0 for type %d", type);
-    lv_draw_task_t * new_task = lv_malloc_zeroed(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size);
+    lv_draw_task_t * new_task = task_alloc(dsc_size);
     LV_ASSERT_MALLOC(new_task);
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -113,6 +150,7 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     new_task->type = type;
     new_task->draw_dsc = (uint8_t *)new_task + LV_ALIGN_UP(sizeof(lv_draw_task_t), 8);
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
+    _draw_info.task_created_cnt++;
 
     /*Find the tail*/
     if(layer->draw_task_head == NULL) {
@@ -135,8 +173,17 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
     lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
     base_dsc->layer = layer;
 
+#if LV_DRAW_TASK_GRID_THRESHOLD
+    /*Add it here, as `_real_area` might be updated after `lv_draw_add_task`.
+     *If it fails, continue without the grid and check the tasks linearly.*/
+    if(layer->task_grid && !task_grid_add(layer->task_grid, t)) task_grid_delete(layer);
+#endif
+
     lv_draw_global_info_t * info = &_draw_info;
 
+    lv_area_t draw_area;
+    if(lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) info->task_px_cnt += lv_area_get_size(&draw_area);
+
     /*Send LV_EVENT_DRAW_TASK_ADDED and dispatch only on the "main" draw_task
      *and not on the draw tasks added in the event.
      *Sending LV_EVENT_DRAW_TASK_ADDED events might cause recursive event sends and besides
@@ -241,6 +288,9 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
     while(t) {
         t_next = t->next;
         if(t->state == LV_DRAW_TASK_STATE_READY) {
+#if LV_DRAW_TASK_GRID_THRESHOLD
+            if(layer->task_grid) task_grid_remove(layer->task_grid, t);
+#endif
             cleanup_task(t, disp);
             remove_task = true;
             if(t_prev != NULL)
@@ -254,6 +304,11 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
         t = t_next;
     }
 
+#if LV_DRAW_TASK_GRID_THRESHOLD
+    /*The grid will be created again if the layer gets many tasks again*/
+    if(layer->draw_task_head == NULL && layer->task_grid) task_grid_delete(layer);
+#endif
+
     bool task_dispatched = false;
 
     /*This layer is ready, enable blending its buffer*/
@@ -384,6 +439,16 @@ uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
     return cnt;
 }
 
+uint32_t lv_draw_get_task_created_count(void)
+{
+    return _draw_info.task_created_cnt;
+}
+
+uint32_t lv_draw_get_task_px_count(void)
+{
+    return _draw_info.task_px_cnt;
+}
+
 void lv_layer_init(lv_layer_t * layer)
 {
     LV_ASSERT_NULL(layer);
@@ -525,6 +590,16 @@ void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area)
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 {
     LV_PROFILER_DRAW_BEGIN;
+#if LV_DRAW_TASK_GRID_THRESHOLD
+    if(layer->task_grid) {
+        bool independent = task_grid_is_independent(layer->task_grid, t_check);
+        LV_PROFILER_DRAW_END;
+        return independent;
+    }
+    uint32_t checked_cnt = 0;
+#endif
+
+    bool independent = true;
     lv_draw_task_t * t = layer->draw_task_head;
 
     /*If t_check is outside of the older tasks then it's independent*/
@@ -532,17 +607,182 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
         if(t->state != LV_DRAW_TASK_STATE_READY) {
             lv_area_t a;
             if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
-                LV_PROFILER_DRAW_END;
-                return false;
+                independent = false;
+                break;
             }
         }
         t = t->next;
+#if LV_DRAW_TASK_GRID_THRESHOLD
+        checked_cnt++;
+#endif
+    }
+
+#if LV_DRAW_TASK_GRID_THRESHOLD
+    /*There are many tasks, index them to make the next checks faster*/
+    if(checked_cnt > LV_DRAW_TASK_GRID_THRESHOLD) task_grid_create(layer);
+#endif
+
+    LV_PROFILER_DRAW_END;
+    return independent;
+}
+
+#if LV_DRAW_TASK_GRID_THRESHOLD
+
+/**
+ * Get the range of cells touched by an area
+ * @param grid      pointer to a grid
+ * @param area      an area with absolute coordinates
+ * @param cells     store the first and last column and row here
+ */
+static void task_grid_get_cells(const lv_draw_task_grid_t * grid, const lv_area_t * area, lv_area_t * cells)
+{
+    cells->x1 = LV_CLAMP(0, (area->x1 - grid->area.x1) / grid->cell_w, grid->col_cnt - 1);
+    cells->x2 = LV_CLAMP(0, (area->x2 - grid->area.x1) / grid->cell_w, grid->col_cnt - 1);
+    cells->y1 = LV_CLAMP(0, (area->y1 - grid->area.y1) / grid->cell_h, grid->row_cnt - 1);
+    cells->y2 = LV_CLAMP(0, (area->y2 - grid->area.y1) / grid->cell_h, grid->row_cnt - 1);
+}
+
+/**
+ * Create a grid for a layer and add its current draw tasks
+ * @param layer     pointer to a layer
+ */
+static void task_grid_create(lv_layer_t * layer)
+{
+    LV_PROFILER_DRAW_BEGIN;
+    lv_draw_task_grid_t * grid = lv_malloc_zeroed(sizeof(lv_draw_task_grid_t));
+    LV_ASSERT_MALLOC(grid);
+    if(grid == NULL) {
+        LV_PROFILER_DRAW_END;
+        return;
+    }
+
+    int32_t w = lv_area_get_width(&layer->buf_area);
+    int32_t h = lv_area_get_height(&layer->buf_area);
+    grid->area = layer->buf_area;
+    grid->col_cnt = LV_CLAMP(1, w / TASK_GRID_MIN_CELL_SIZE, LV_DRAW_TASK_GRID_MAX_SIZE);
+    grid->row_cnt = LV_CLAMP(1, h / TASK_GRID_MIN_CELL_SIZE, LV_DRAW_TASK_GRID_MAX_SIZE);
+    grid->cell_w = LV_MAX((w + grid->col_cnt - 1) / grid->col_cnt, 1);
+    grid->cell_h = LV_MAX((h + grid->row_cnt - 1) / grid->row_cnt, 1);
+    layer->task_grid = grid;
+
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        if(!task_grid_add(grid, t)) {
+            task_grid_delete(layer);
+            break;
+        }
+        t = t->next;
     }
     LV_PROFILER_DRAW_END;
+}
+
+/**
+ * Free the grid of a layer
+ * @param layer     pointer to a layer
+ */
+static void task_grid_delete(lv_layer_t * layer)
+{
+    lv_draw_task_grid_t * grid = layer->task_grid;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_GRID_MAX_SIZE * LV_DRAW_TASK_GRID_MAX_SIZE; i++) {
+        lv_free(grid->cells[i].tasks);
+    }
+    lv_free(grid);
+    layer->task_grid = NULL;
+}
+
+/**
+ * Add a draw task to the end of the cells it touches
+ * @param grid      pointer to a grid
+ * @param t         the draw task to add
+ * @return          true: added; false: out of memory, the grid can't be used anymore
+ */
+static bool task_grid_add(lv_draw_task_grid_t * grid, lv_draw_task_t * t)
+{
+    lv_area_t cells;
+    task_grid_get_cells(grid, &t->_real_area, &cells);
+
+    int32_t row;
+    int32_t col;
+    for(row = cells.y1; row <= cells.y2; row++) {
+        for(col = cells.x1; col <= cells.x2; col++) {
+            lv_draw_task_grid_cell_t * cell = &grid->cells[row * grid->col_cnt + col];
+            if(cell->cnt == cell->size) {
+                uint32_t new_size = cell->size ? cell->size * 2 : 8;
+                lv_draw_task_t ** tasks = lv_realloc(cell->tasks, new_size * sizeof(lv_draw_task_t *));
+                if(tasks == NULL) return false;
+                cell->tasks = tasks;
+                cell->size = new_size;
+            }
+            cell->tasks[cell->cnt] = t;
+            cell->cnt++;
+        }
+    }
 
     return true;
 }
 
+/**
+ * Remove a draw task from the cells it touches
+ * @param grid      pointer to a grid
+ * @param t         the draw task to remove
+ */
+static void task_grid_remove(lv_draw_task_grid_t * grid, lv_draw_task_t * t)
+{
+    lv_area_t cells;
+    task_grid_get_cells(grid, &t->_real_area, &cells);
+
+    int32_t row;
+    int32_t col;
+    for(row = cells.y1; row <= cells.y2; row++) {
+        for(col = cells.x1; col <= cells.x2; col++) {
+            lv_draw_task_grid_cell_t * cell = &grid->cells[row * grid->col_cnt + col];
+            /*The tasks are usually finished in order, so it's typically the first one*/
+            uint32_t i;
+            for(i = 0; i < cell->cnt; i++) {
+                if(cell->tasks[i] == t) {
+                    lv_memmove(&cell->tasks[i], &cell->tasks[i + 1], (cell->cnt - i - 1) * sizeof(lv_draw_task_t *));
+                    cell->cnt--;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Same as `is_independent` but check only the older tasks in the cells touched by `t_check`
+ * @param grid      pointer to a grid
+ * @param t_check   check this task if it overlaps with the older ones
+ * @return          true: `t_check` is not overlapping with older tasks so it's independent
+ */
+static bool task_grid_is_independent(lv_draw_task_grid_t * grid, lv_draw_task_t * t_check)
+{
+    lv_area_t cells;
+    task_grid_get_cells(grid, &t_check->_real_area, &cells);
+
+    int32_t row;
+    int32_t col;
+    for(row = cells.y1; row <= cells.y2; row++) {
+        for(col = cells.x1; col <= cells.x2; col++) {
+            const lv_draw_task_grid_cell_t * cell = &grid->cells[row * grid->col_cnt + col];
+            uint32_t i;
+            for(i = 0; i < cell->cnt; i++) {
+                lv_draw_task_t * t = cell->tasks[i];
+                if(t == t_check) break;
+                if(t->state != LV_DRAW_TASK_STATE_READY) {
+                    lv_area_t a;
+                    if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif /*LV_DRAW_TASK_GRID_THRESHOLD*/
+
 /**
  * Get the size of the draw descriptor of a draw task
  * @param type      type of the draw task
@@ -640,6 +880,9 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
                 disp->layer_deinit(disp, layer_drawn);
                 LV_PROFILER_DRAW_END_TAG("layer_deinit");
             }
+#if LV_DRAW_TASK_GRID_THRESHOLD
+            if(layer_drawn->task_grid) task_grid_delete(layer_drawn);
+#endif
             lv_free(layer_drawn);
         }
     }
@@ -649,10 +892,52 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
         draw_label_dsc->text = NULL;
     }
 
-    lv_free(t);
+    task_free(t);
     LV_PROFILER_DRAW_END;
 }
 
+/**
+ * Allocate a zeroed draw task with its descriptor. Reuse a finished task if possible.
+ * @param dsc_size  size of the draw descriptor
+ * @return          the new draw task or NULL on error
+ */
+static lv_draw_task_t * task_alloc(size_t dsc_size)
+{
+    size_t size = LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size;
+#if LV_DRAW_TASK_POOL_CNT
+    if(size <= TASK_POOL_BLOCK_SIZE) {
+        lv_draw_task_t * t = _draw_info.task_pool;
+        if(t) {
+            _draw_info.task_pool = t->next;
+            _draw_info.task_pool_cnt--;
+            lv_memzero(t, size);
+            return t;
+        }
+        /*Allocate the full block so that it can be reused for any type later*/
+        return lv_malloc_zeroed(TASK_POOL_BLOCK_SIZE);
+    }
+#endif
+    return lv_malloc_zeroed(size);
+}
+
+/**
+ * Free a draw task or keep it for reuse
+ * @param t         pointer to a draw task
+ */
+static void task_free(lv_draw_task_t * t)
+{
+#if LV_DRAW_TASK_POOL_CNT
+    if(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + get_draw_dsc_size(t->type) <= TASK_POOL_BLOCK_SIZE &&
+       _draw_info.task_pool_cnt < LV_DRAW_TASK_POOL_CNT) {
+        t->next = _draw_info.task_pool;
+        _draw_info.task_pool = t;
+        _draw_info.task_pool_cnt++;
+        return;
+    }
+#endif
+    lv_free(t);
+}
+
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
 {
     LV_PROFILER_DRAW_BEGIN;
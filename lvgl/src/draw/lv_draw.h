@@ -115,6 +115,9 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** Grid index of the draw tasks to find the overlapping ones quickly. Used internally. */
+    lv_draw_task_grid_t * task_grid;
+
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
@@ -248,6 +251,21 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
  */
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check);
 
+/**
+ * Get the number of draw tasks created since `lv_init`.
+ * The counter wraps around, so compare two readings to get the number of tasks of a frame.
+ * @return          total number of draw tasks added with `lv_draw_add_task`
+ */
+uint32_t lv_draw_get_task_created_count(void);
+
+/**
+ * Get the number of pixels covered by the draw tasks (clipped to their clip area) since `lv_init`.
+ * Divided by the number of refreshed pixels of a frame it gives the overdraw.
+ * The counter wraps around, so compare two readings.
+ * @return          total number of pixels of the draw tasks
+ */
+uint32_t lv_draw_get_task_px_count(void);
+
 /**
  * Initialize a layer
  * @param layer pointer to a layer to initialize
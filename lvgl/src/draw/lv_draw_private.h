@@ -26,6 +26,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Max. number of columns and rows of a layer's draw task grid*/
+#define LV_DRAW_TASK_GRID_MAX_SIZE  16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -87,6 +90,28 @@ struct _lv_draw_mask_t {
     void * user_data;
 };
 
+typedef struct {
+    /** The draw tasks touching the cell, in the same order as in the layer's list */
+    lv_draw_task_t ** tasks;
+    uint32_t cnt;
+    uint32_t size;
+} lv_draw_task_grid_cell_t;
+
+/**
+ * Splits a layer into cells and stores which draw tasks touch which cells.
+ * This way only the older tasks in the same cells need to be checked to tell if a draw task
+ * depends on an other one, instead of all the older tasks of the layer.
+ */
+struct _lv_draw_task_grid_t {
+    /** Area covered by the cells. Tasks reaching out of it are added to the edge cells too. */
+    lv_area_t area;
+    int32_t cell_w;
+    int32_t cell_h;
+    int32_t col_cnt;
+    int32_t row_cnt;
+    lv_draw_task_grid_cell_t cells[LV_DRAW_TASK_GRID_MAX_SIZE * LV_DRAW_TASK_GRID_MAX_SIZE];
+};
+
 struct _lv_draw_unit_t {
     lv_draw_unit_t * next;
 
@@ -177,6 +202,8 @@ typedef struct {
     lv_draw_unit_t * unit_head;
     uint32_t unit_cnt;
     uint32_t used_memory_for_layers; /* measured as bytes */
+    uint32_t task_created_cnt;       /* total number of draw tasks added since `lv_init` */
+    uint32_t task_px_cnt;            /* total number of pixels covered by the draw tasks since `lv_init` */
 #if LV_USE_OS
     lv_thread_sync_t sync;
 #else
@@ -184,6 +211,10 @@ typedef struct {
 #endif
     lv_mutex_t circle_cache_mutex;
     bool task_running;
+#if LV_DRAW_TASK_POOL_CNT
+    lv_draw_task_t * task_pool;      /* finished draw tasks to reuse, linked by `next` */
+    uint32_t task_pool_cnt;
+#endif
 } lv_draw_global_info_t;
 
 /**********************
@@ -63,6 +63,10 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
     /*Initialize the cache*/
     lv_image_cache_init(image_cache_size);
     lv_image_header_cache_init(image_header_count);
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    lv_image_decoder_async_init();
+#endif
 }
 
 /**
@@ -70,6 +74,11 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void)
 {
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    /*Stop the workers before the cache they decode into is destroyed*/
+    lv_image_decoder_async_deinit();
+#endif
+    lv_image_cache_unpin(NULL);
     lv_cache_destroy(img_cache_p, NULL);
     lv_cache_destroy(img_header_cache_p, NULL);
 
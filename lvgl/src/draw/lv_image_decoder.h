@@ -85,6 +85,14 @@ typedef void (*lv_image_decoder_close_f_t)(lv_image_decoder_t * decoder, lv_imag
  */
 typedef void (*lv_image_decoder_custom_draw_t)(lv_layer_t * layer, const lv_image_decoder_dsc_t * dsc,
                                                const lv_area_t * coords, const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * clip_area);
+
+/**
+ * Called on the LVGL thread when an image requested by `lv_image_decoder_decode_async()` was decoded.
+ * @param src       the image source which was requested
+ * @param user_data the `user_data` passed to `lv_image_decoder_decode_async()`
+ */
+typedef void (*lv_image_decoder_ready_cb_t)(const void * src, void * user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -132,6 +140,25 @@ lv_result_t lv_image_decoder_get_area(lv_image_decoder_dsc_t * dsc, const lv_are
  */
 void lv_image_decoder_close(lv_image_decoder_dsc_t * dsc);
 
+/**
+ * Decode an image into the image cache on a worker thread.
+ * Until `ready_cb` is called the image can't be drawn without decoding it on the caller's thread.
+ * @note Requires `LV_IMAGE_DECODER_ASYNC_THREAD_CNT > 0`, else the image is always reported as ready.
+ * @param src       the image source. File name or pointer to an `lv_image_dsc_t` variable
+ * @param ready_cb  called on the LVGL thread when the image is in the cache, or it failed to decode. Can be `NULL`.
+ * @param user_data passed to `ready_cb` and used to cancel the request with `lv_image_decoder_cancel_async()`
+ * @return          LV_RESULT_OK: the image can be drawn now (it's cached, it's not encoded, it can't be cached or it failed to decode);
+ *                  LV_RESULT_INVALID: the image is being decoded and `ready_cb` will be called
+ */
+lv_result_t lv_image_decoder_decode_async(const void * src, lv_image_decoder_ready_cb_t ready_cb, void * user_data);
+
+/**
+ * Cancel every request made with `user_data` by `lv_image_decoder_decode_async()`.
+ * Their `ready_cb` won't be called anymore. Images being decoded will still be added to the cache.
+ * @param user_data the `user_data` passed to `lv_image_decoder_decode_async()`
+ */
+void lv_image_decoder_cancel_async(void * user_data);
+
 /**
  * Create a new image decoder
  * @return pointer to the new image decoder
@@ -0,0 +1,350 @@
+/**
+ * @file lv_image_decoder_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_image_decoder_private.h"
+#include "../misc/cache/lv_cache_private.h"
+#include "../misc/lv_assert.h"
+#include "../stdlib/lv_string.h"
+#include "../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+#define async (LV_GLOBAL_DEFAULT()->img_decoder_async)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    static void worker_thread_cb(void * ptr);
+    static bool decode_next(void);
+    static void ready_timer_cb(lv_timer_t * t);
+    static bool is_cached(const void * src, lv_image_src_t src_type);
+    static bool src_equal(const lv_image_decoder_async_req_t * req, const void * src, lv_image_src_t src_type);
+    static lv_image_decoder_async_req_t * find_req(const void * src, lv_image_src_t src_type, void * user_data);
+    static void req_free(lv_image_decoder_async_req_t * req);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+
+void lv_image_decoder_async_init(void)
+{
+    lv_mutex_init(&async.lock);
+    lv_ll_init(&async.req_ll, sizeof(lv_image_decoder_async_req_t));
+
+    async.ready_timer = lv_timer_create(ready_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+    lv_timer_pause(async.ready_timer);
+
+    uint32_t i;
+    for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+        lv_image_decoder_async_thread_t * thread_dsc = &async.threads[i];
+        thread_dsc->exit_status = false;
+        lv_thread_sync_init(&thread_dsc->sync);
+        lv_thread_init(&thread_dsc->thread, "imgdec", LV_THREAD_PRIO_LOW, worker_thread_cb,
+                       LV_DRAW_THREAD_STACK_SIZE, thread_dsc);
+    }
+}
+
+void lv_image_decoder_async_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+        lv_image_decoder_async_thread_t * thread_dsc = &async.threads[i];
+        LV_LOG_INFO("cancel image decoder thread");
+        thread_dsc->exit_status = true;
+        lv_thread_sync_signal(&thread_dsc->sync);
+        lv_thread_delete(&thread_dsc->thread);
+        lv_thread_sync_delete(&thread_dsc->sync);
+    }
+
+    lv_image_decoder_async_req_t * req;
+    while((req = lv_ll_get_head(&async.req_ll)) != NULL) {
+        lv_ll_remove(&async.req_ll, req);
+        req_free(req);
+    }
+
+    lv_timer_delete(async.ready_timer);
+    async.ready_timer = NULL;
+    lv_mutex_delete(&async.lock);
+}
+
+lv_result_t lv_image_decoder_decode_async(const void * src, lv_image_decoder_ready_cb_t ready_cb, void * user_data)
+{
+    if(src == NULL || !lv_image_cache_is_enabled()) return LV_RESULT_OK;
+
+    /*Symbols are not decoded and plain variables are drawn from where they are*/
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    if(src_type == LV_IMAGE_SRC_VARIABLE) {
+        lv_color_format_t cf = ((const lv_image_dsc_t *)src)->header.cf;
+        if(cf != LV_COLOR_FORMAT_RAW && cf != LV_COLOR_FORMAT_RAW_ALPHA) return LV_RESULT_OK;
+    }
+    else if(src_type != LV_IMAGE_SRC_FILE) return LV_RESULT_OK;
+
+    lv_mutex_lock(&async.lock);
+
+    lv_image_decoder_async_req_t * req = find_req(src, src_type, user_data);
+    if(req) {
+        lv_image_decoder_async_state_t state = req->state;
+        if(state == LV_IMAGE_DECODER_ASYNC_QUEUED || state == LV_IMAGE_DECODER_ASYNC_DECODING) {
+            lv_mutex_unlock(&async.lock);
+            return LV_RESULT_INVALID;
+        }
+
+        /*The decoder couldn't cache it, so it has to be drawn the slow way*/
+        if(state == LV_IMAGE_DECODER_ASYNC_FAILED) {
+            lv_mutex_unlock(&async.lock);
+            return LV_RESULT_OK;
+        }
+    }
+
+    if(is_cached(src, src_type)) {
+        lv_mutex_unlock(&async.lock);
+        return LV_RESULT_OK;
+    }
+
+    /*A ready image was evicted again before it was drawn, so decode it again*/
+    if(req == NULL) {
+        req = lv_ll_ins_tail(&async.req_ll);
+        LV_ASSERT_MALLOC(req);
+        if(req == NULL) {
+            lv_mutex_unlock(&async.lock);
+            return LV_RESULT_OK;
+        }
+
+        req->src_type = src_type;
+        req->src = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+        req->user_data = user_data;
+        req->cancelled = false;
+    }
+    req->ready_cb = ready_cb;
+    req->state = LV_IMAGE_DECODER_ASYNC_QUEUED;
+
+    lv_mutex_unlock(&async.lock);
+
+    uint32_t i;
+    for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+        lv_thread_sync_signal(&async.threads[i].sync);
+    }
+    lv_timer_resume(async.ready_timer);
+
+    return LV_RESULT_INVALID;
+}
+
+void lv_image_decoder_cancel_async(void * user_data)
+{
+    lv_mutex_lock(&async.lock);
+
+    lv_image_decoder_async_req_t * req = lv_ll_get_head(&async.req_ll);
+    while(req) {
+        lv_image_decoder_async_req_t * next = lv_ll_get_next(&async.req_ll, req);
+        if(req->user_data == user_data && !req->cancelled) {
+            /*The worker still uses it, the ready timer will free it*/
+            if(req->state == LV_IMAGE_DECODER_ASYNC_DECODING) {
+                req->ready_cb = NULL;
+                req->cancelled = true;
+            }
+            else {
+                lv_ll_remove(&async.req_ll, req);
+                req_free(req);
+            }
+        }
+        req = next;
+    }
+
+    lv_mutex_unlock(&async.lock);
+}
+
+#else /*LV_IMAGE_DECODER_ASYNC_THREAD_CNT*/
+
+lv_result_t lv_image_decoder_decode_async(const void * src, lv_image_decoder_ready_cb_t ready_cb, void * user_data)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(ready_cb);
+    LV_UNUSED(user_data);
+    return LV_RESULT_OK;
+}
+
+void lv_image_decoder_cancel_async(void * user_data)
+{
+    LV_UNUSED(user_data);
+}
+
+#endif /*LV_IMAGE_DECODER_ASYNC_THREAD_CNT*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+
+static void worker_thread_cb(void * ptr)
+{
+    lv_image_decoder_async_thread_t * thread_dsc = ptr;
+
+    while(1) {
+        lv_thread_sync_wait(&thread_dsc->sync);
+        if(thread_dsc->exit_status) break;
+
+        while(!thread_dsc->exit_status && decode_next()) {}
+    }
+
+    LV_LOG_INFO("exit image decoder thread");
+}
+
+/**
+ * Decode the oldest queued image on the calling worker thread
+ * @return  false if there was nothing to decode
+ */
+static bool decode_next(void)
+{
+    lv_mutex_lock(&async.lock);
+
+    /*Skip the images another worker is decoding, they will be ready with it*/
+    lv_image_decoder_async_req_t * req;
+    LV_LL_READ(&async.req_ll, req) {
+        if(req->state != LV_IMAGE_DECODER_ASYNC_QUEUED) continue;
+
+        lv_image_decoder_async_req_t * other;
+        LV_LL_READ(&async.req_ll, other) {
+            if(other->state == LV_IMAGE_DECODER_ASYNC_DECODING && src_equal(other, req->src, req->src_type)) break;
+        }
+        if(other == NULL) break;
+    }
+
+    if(req == NULL) {
+        lv_mutex_unlock(&async.lock);
+        return false;
+    }
+
+    req->state = LV_IMAGE_DECODER_ASYNC_DECODING;
+    lv_mutex_unlock(&async.lock);
+
+    /*Requests being decoded are not freed, so `req` stays valid without the lock*/
+    lv_image_decoder_dsc_t decoder_dsc;
+    lv_result_t res = lv_image_decoder_open(&decoder_dsc, req->src, NULL);
+    bool cached = res == LV_RESULT_OK && decoder_dsc.cache_entry != NULL;
+    if(res == LV_RESULT_OK) lv_image_decoder_close(&decoder_dsc);
+
+    lv_mutex_lock(&async.lock);
+
+    /*Every request of this image was waiting for this decoding*/
+    lv_image_decoder_async_req_t * done;
+    LV_LL_READ(&async.req_ll, done) {
+        if(done->state != LV_IMAGE_DECODER_ASYNC_QUEUED && done->state != LV_IMAGE_DECODER_ASYNC_DECODING) continue;
+        if(done != req && !src_equal(done, req->src, req->src_type)) continue;
+
+        done->state = cached ? LV_IMAGE_DECODER_ASYNC_READY : LV_IMAGE_DECODER_ASYNC_FAILED;
+    }
+
+    lv_mutex_unlock(&async.lock);
+
+    return true;
+}
+
+/**
+ * Call the `ready_cb` of the finished requests on the LVGL thread
+ */
+static void ready_timer_cb(lv_timer_t * t)
+{
+    while(1) {
+        lv_mutex_lock(&async.lock);
+
+        bool busy = false;
+        lv_image_decoder_async_req_t * req;
+        LV_LL_READ(&async.req_ll, req) {
+            if(req->state == LV_IMAGE_DECODER_ASYNC_QUEUED || req->state == LV_IMAGE_DECODER_ASYNC_DECODING) {
+                busy = true;
+                continue;
+            }
+
+            if(req->ready_cb || req->cancelled) break;
+        }
+
+        if(req == NULL) {
+            if(!busy) lv_timer_pause(t);
+            lv_mutex_unlock(&async.lock);
+            return;
+        }
+
+        lv_image_decoder_ready_cb_t ready_cb = req->ready_cb;
+        void * user_data = req->user_data;
+        req->ready_cb = NULL;
+
+        /*Failed requests are kept to not queue them again on the next draw*/
+        bool ready = req->state == LV_IMAGE_DECODER_ASYNC_READY || req->cancelled;
+        if(ready) lv_ll_remove(&async.req_ll, req);
+
+        lv_mutex_unlock(&async.lock);
+
+        /*The callback might cancel or add requests, so start over after it*/
+        if(ready_cb) ready_cb(req->src, user_data);
+        if(ready) req_free(req);
+    }
+}
+
+/**
+ * Look up the image without acquiring it, so the probe is not counted as a cache hit
+ */
+static bool is_cached(const void * src, lv_image_src_t src_type)
+{
+    lv_image_cache_data_t search_key;
+    search_key.src_type = src_type;
+    search_key.src = src;
+
+    lv_mutex_lock(&img_cache_p->lock);
+    bool cached = img_cache_p->size != 0 && img_cache_p->clz->get_cb(img_cache_p, &search_key, NULL) != NULL;
+    lv_mutex_unlock(&img_cache_p->lock);
+
+    return cached;
+}
+
+static bool src_equal(const lv_image_decoder_async_req_t * req, const void * src, lv_image_src_t src_type)
+{
+    if(req->src_type != src_type) return false;
+    if(src_type == LV_IMAGE_SRC_FILE) return lv_strcmp(req->src, src) == 0;
+    return req->src == src;
+}
+
+static lv_image_decoder_async_req_t * find_req(const void * src, lv_image_src_t src_type, void * user_data)
+{
+    lv_image_decoder_async_req_t * req;
+    LV_LL_READ(&async.req_ll, req) {
+        if(req->user_data == user_data && !req->cancelled && src_equal(req, src, src_type)) return req;
+    }
+
+    return NULL;
+}
+
+/**
+ * Free a request already removed from the list
+ */
+static void req_free(lv_image_decoder_async_req_t * req)
+{
+    if(req->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)req->src);
+    lv_free(req);
+}
+
+#endif /*LV_IMAGE_DECODER_ASYNC_THREAD_CNT*/
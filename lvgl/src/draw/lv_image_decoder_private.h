@@ -15,6 +15,9 @@ extern "C" {
  *********************/
 #include "lv_image_decoder.h"
 #include "../misc/cache/lv_cache.h"
+#include "../misc/lv_ll.h"
+#include "../misc/lv_timer.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -73,6 +76,40 @@ struct _lv_image_header_cache_data_t {
     lv_image_decoder_t * decoder;
 };
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+
+typedef enum {
+    LV_IMAGE_DECODER_ASYNC_QUEUED,
+    LV_IMAGE_DECODER_ASYNC_DECODING,
+    LV_IMAGE_DECODER_ASYNC_READY,
+    LV_IMAGE_DECODER_ASYNC_FAILED,
+} lv_image_decoder_async_state_t;
+
+/**An image waiting to be decoded by a worker thread*/
+typedef struct {
+    const void * src;                       /**< Copy of the path for files*/
+    lv_image_src_t src_type;
+    lv_image_decoder_ready_cb_t ready_cb;
+    void * user_data;
+    lv_image_decoder_async_state_t state;
+    bool cancelled;                         /**< Cancelled while decoding, free it when it's done*/
+} lv_image_decoder_async_req_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;          /**< Signaled when there is a queued request*/
+    bool exit_status;
+} lv_image_decoder_async_thread_t;
+
+typedef struct {
+    lv_image_decoder_async_thread_t threads[LV_IMAGE_DECODER_ASYNC_THREAD_CNT];
+    lv_mutex_t lock;                /**< Protects `req_ll` and the state of the requests*/
+    lv_ll_t req_ll;                 /**< `lv_image_decoder_async_req_t`s in the order they were queued*/
+    lv_timer_t * ready_timer;       /**< Calls the `ready_cb`s on the LVGL thread*/
+} lv_image_decoder_async_t;
+
+#endif /*LV_IMAGE_DECODER_ASYNC_THREAD_CNT*/
+
 /**Describe an image decoding session. Stores data about the decoding*/
 struct _lv_image_decoder_dsc_t {
     /**The decoder which was able to open the image source*/
@@ -133,6 +170,18 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void);
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+/**
+ * Start the worker threads of `lv_image_decoder_decode_async()`
+ */
+void lv_image_decoder_async_init(void);
+
+/**
+ * Stop the worker threads and drop the pending requests without calling their `ready_cb`
+ */
+void lv_image_decoder_async_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
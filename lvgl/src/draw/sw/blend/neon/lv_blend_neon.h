@@ -23,8 +23,27 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+
+/*The kernels in lv_blend_neon.S are ARMv7 (AArch32) assembly and can't be built for AArch64.
+ *There the blend functions are implemented with NEON intrinsics instead.
+ *Can be set to 1 manually to test the intrinsics on another architecture with an arm_neon.h replacement.*/
+#ifndef LV_DRAW_SW_NEON_INTRINSICS
+#ifdef __aarch64__
+#define LV_DRAW_SW_NEON_INTRINSICS 1
+#else
+#define LV_DRAW_SW_NEON_INTRINSICS 0
+#endif
+#endif
+
 #if !defined(__ASSEMBLY__)
 
+#if LV_DRAW_SW_NEON_INTRINSICS
+
+#include "lv_draw_sw_blend_neon_to_rgb565.h"
+#include "lv_draw_sw_blend_neon_to_rgb888.h"
+
+#else /*LV_DRAW_SW_NEON_INTRINSICS*/
+
 #if __GNUC__ >= 4
 #define LVGL_HIDDEN __attribute__((visibility("hidden")))
 #else
@@ -1288,6 +1307,8 @@ static inline lv_result_t lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_neon
     return LV_RESULT_OK;
 }
 
+#endif /*LV_DRAW_SW_NEON_INTRINSICS*/
+
 #endif /* !defined(__ASSEMBLY__) */
 
 /**********************
@@ -0,0 +1,491 @@
+/**
+ * @file lv_draw_sw_blend_neon_to_rgb565.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_draw_sw_blend_private.h"
+#include "lv_blend_neon.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && LV_DRAW_SW_NEON_INTRINSICS
+
+#include "../../../../stdlib/lv_string.h"
+#include <arm_neon.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels processed in one step*/
+#define BLEND_STEP  8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint16x8_t color;   /*The fill color*/
+    uint8x8_t opa;
+    uint16x4_t opa16;
+    uint32_t src_px_size;
+} blend_param_t;
+
+/*Blend BLEND_STEP pixels. `src` and `mask` can be NULL if not used*/
+typedef void (*blend_kernel_t)(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                               const blend_param_t * p);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline void blend_area(void * dest_buf, int32_t dest_stride, int32_t w, int32_t h,
+                              const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              const blend_param_t * p, blend_kernel_t kernel);
+static inline void init_param(blend_param_t * p, lv_color_t color, lv_opa_t opa, uint32_t src_px_size);
+
+static void color_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void color_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void color_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb565_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb565_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb565_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_copy(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_normal(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                  const blend_param_t * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    uint16x8_t color = vdupq_n_u16(lv_color_to_u16(dsc->color));
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+    uint8_t * dest_row = dsc->dest_buf;
+    int32_t w = dsc->dest_w;
+    int32_t x;
+    int32_t y;
+
+    for(y = 0; y < dsc->dest_h; y++) {
+        uint16_t * dest = (uint16_t *)dest_row;
+        for(x = 0; x <= w - 16; x += 16) {
+            vst1q_u16(&dest[x], color);
+            vst1q_u16(&dest[x + 8], color);
+        }
+        for(; x < w; x++) {
+            dest[x] = color16;
+        }
+        dest_row += dsc->dest_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565_with_opa(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_param_t p;
+    init_param(&p, dsc->color, dsc->opa, 0);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, NULL, 0, NULL, 0, &p, color_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565_with_mask(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_param_t p;
+    init_param(&p, dsc->color, dsc->opa, 0);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, NULL, 0,
+               dsc->mask_buf, dsc->mask_stride, &p, color_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565_mix_mask_opa(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_param_t p;
+    init_param(&p, dsc->color, dsc->opa, 0);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, NULL, 0,
+               dsc->mask_buf, dsc->mask_stride, &p, color_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    /*RGB565_SWAPPED images are also passed here*/
+    if(dsc->src_color_format == LV_COLOR_FORMAT_RGB565_SWAPPED) return LV_RESULT_INVALID;
+
+    uint8_t * dest_row = dsc->dest_buf;
+    const uint8_t * src_row = dsc->src_buf;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        lv_memcpy(dest_row, src_row, dsc->dest_w * 2);
+        dest_row += dsc->dest_stride;
+        src_row += dsc->src_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565_with_opa(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(dsc->src_color_format == LV_COLOR_FORMAT_RGB565_SWAPPED) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 2);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, rgb565_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565_with_mask(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(dsc->src_color_format == LV_COLOR_FORMAT_RGB565_SWAPPED) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 2);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb565_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(dsc->src_color_format == LV_COLOR_FORMAT_RGB565_SWAPPED) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 2);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb565_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, rgb888_copy);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565_with_opa(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, rgb888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565_with_mask(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                 uint32_t src_px_size)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, argb8888_normal);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565_with_opa(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, argb8888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565_with_mask(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, argb8888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, argb8888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline void init_param(blend_param_t * p, lv_color_t color, lv_opa_t opa, uint32_t src_px_size)
+{
+    p->color = vdupq_n_u16(lv_color_to_u16(color));
+    p->opa = vdup_n_u8(opa);
+    p->opa16 = vdup_n_u16(opa);
+    p->src_px_size = src_px_size;
+}
+
+/**
+ * Call `kernel` for every BLEND_STEP pixels of the area.
+ * The last pixels of a row are blended in a padded copy so that the kernels
+ * never read or write outside of the buffers and the result is the same as for the other pixels.
+ */
+static inline void blend_area(void * dest_buf, int32_t dest_stride, int32_t w, int32_t h,
+                              const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              const blend_param_t * p, blend_kernel_t kernel)
+{
+    uint8_t * dest_row = dest_buf;
+    const uint8_t * src_row = src_buf;
+    const lv_opa_t * mask_row = mask_buf;
+    uint32_t src_px_size = p->src_px_size;
+    int32_t x;
+    int32_t y;
+
+    for(y = 0; y < h; y++) {
+        uint16_t * dest = (uint16_t *)dest_row;
+        for(x = 0; x <= w - BLEND_STEP; x += BLEND_STEP) {
+            kernel(&dest[x], src_row ? &src_row[x * src_px_size] : NULL, mask_row ? &mask_row[x] : NULL, p);
+        }
+
+        if(x < w) {
+            uint16_t dest_tmp[BLEND_STEP] = {0};
+            uint8_t src_tmp[BLEND_STEP * 4] = {0};
+            lv_opa_t mask_tmp[BLEND_STEP] = {0};
+            int32_t rest = w - x;
+
+            lv_memcpy(dest_tmp, &dest[x], rest * sizeof(uint16_t));
+            if(src_row) lv_memcpy(src_tmp, &src_row[x * src_px_size], rest * src_px_size);
+            if(mask_row) lv_memcpy(mask_tmp, &mask_row[x], rest);
+            kernel(dest_tmp, src_tmp, mask_tmp, p);
+            lv_memcpy(&dest[x], dest_tmp, rest * sizeof(uint16_t));
+        }
+
+        dest_row += dest_stride;
+        if(src_row) src_row += src_stride;
+        if(mask_row) mask_row += mask_stride;
+    }
+}
+
+/**
+ * Same as `lv_color_16_16_mix()`: (fg * m + bg * (32 - m)) >> 5 on each channel with m = (mix + 4) >> 3.
+ * It returns `fg` for mix = 255 and `bg` for mix < 4 without special cases.
+ */
+static inline uint16x8_t mix_565_565(uint16x8_t fg, uint16x8_t bg, uint16x8_t mix)
+{
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    uint16x8_t m = vshrq_n_u16(vaddq_u16(mix, vdupq_n_u16(4)), 3);
+    uint16x8_t m_inv = vsubq_u16(vdupq_n_u16(32), m);
+
+    uint16x8_t r = vmlaq_u16(vmulq_u16(vshrq_n_u16(fg, 11), m), vshrq_n_u16(bg, 11), m_inv);
+    uint16x8_t g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(fg, 5), mask6), m),
+                             vandq_u16(vshrq_n_u16(bg, 5), mask6), m_inv);
+    uint16x8_t b = vmlaq_u16(vmulq_u16(vandq_u16(fg, mask5), m), vandq_u16(bg, mask5), m_inv);
+
+    /*The sums are at most 32 times the channel maximum so `>> 5` gives back the channels*/
+    uint16x8_t res = vshlq_n_u16(vshrq_n_u16(r, 5), 11);
+    res = vorrq_u16(res, vshlq_n_u16(vshrq_n_u16(g, 5), 5));
+    return vorrq_u16(res, vshrq_n_u16(b, 5));
+}
+
+/**
+ * Convert RGB888 to RGB565 by dropping the lower bits
+ */
+static inline uint16x8_t pack_888_565(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+    uint16x8_t res = vshll_n_u8(r, 8);
+    res = vsriq_n_u16(res, vshll_n_u8(g, 8), 5);
+    return vsriq_n_u16(res, vshll_n_u8(b, 8), 11);
+}
+
+/**
+ * Same as `lv_color_24_16_mix()` of lv_draw_sw_blend_to_rgb565.c:
+ * keep `bg` for mix = 0, convert fg for mix = 255, else (fg * mix + bg * (255 - mix)) >> 8 on the RGB565 channels
+ */
+static inline uint16x8_t mix_888_565(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint16x8_t bg, uint8x8_t mix)
+{
+    uint8x8_t mix_inv = vmvn_u8(mix);
+    uint8x8_t bg_r = vmovn_u16(vshrq_n_u16(bg, 11));
+    uint8x8_t bg_g = vand_u8(vmovn_u16(vshrq_n_u16(bg, 5)), vdup_n_u8(0x3F));
+    uint8x8_t bg_b = vand_u8(vmovn_u16(bg), vdup_n_u8(0x1F));
+
+    uint16x8_t res_r = vmlal_u8(vmull_u8(vshr_n_u8(r, 3), mix), bg_r, mix_inv);
+    uint16x8_t res_g = vmlal_u8(vmull_u8(vshr_n_u8(g, 2), mix), bg_g, mix_inv);
+    uint16x8_t res_b = vmlal_u8(vmull_u8(vshr_n_u8(b, 3), mix), bg_b, mix_inv);
+
+    uint16x8_t res = vshlq_n_u16(vshrq_n_u16(res_r, 8), 11);
+    res = vorrq_u16(res, vshlq_n_u16(vshrq_n_u16(res_g, 8), 5));
+    res = vorrq_u16(res, vshrq_n_u16(res_b, 8));
+
+    uint16x8_t mix16 = vmovl_u8(mix);
+    res = vbslq_u16(vceqq_u16(mix16, vdupq_n_u16(255)), pack_888_565(r, g, b), res);
+    return vbslq_u16(vceqq_u16(mix16, vdupq_n_u16(0)), bg, res);
+}
+
+/**
+ * LV_OPA_MIX2(a, b) = (a * b) >> 8
+ */
+static inline uint8x8_t opa_mix2(uint8x8_t a, uint8x8_t b)
+{
+    return vshrn_n_u16(vmull_u8(a, b), 8);
+}
+
+/**
+ * LV_OPA_MIX3(a, b, opa) = (a * b * opa) >> 16
+ */
+static inline uint8x8_t opa_mix3(uint8x8_t a, uint8x8_t b, uint16x4_t opa16)
+{
+    uint16x8_t ab = vmull_u8(a, b);
+    uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(ab), opa16), 16);
+    uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(ab), opa16), 16);
+    return vmovn_u16(vcombine_u16(lo, hi));
+}
+
+static inline uint8x8x3_t load_888(const uint8_t * src, uint32_t src_px_size)
+{
+    uint8x8x3_t px;
+    if(src_px_size == 3) {
+        px = vld3_u8(src);
+    }
+    else {
+        uint8x8x4_t px4 = vld4_u8(src);
+        px.val[0] = px4.val[0];
+        px.val[1] = px4.val[1];
+        px.val[2] = px4.val[2];
+    }
+    return px;
+}
+
+static void color_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(mask);
+    vst1q_u16(dest, mix_565_565(p->color, vld1q_u16(dest), vmovl_u8(p->opa)));
+}
+
+static void color_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(src);
+    vst1q_u16(dest, mix_565_565(p->color, vld1q_u16(dest), vmovl_u8(vld1_u8(mask))));
+}
+
+static void color_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(src);
+    vst1q_u16(dest, mix_565_565(p->color, vld1q_u16(dest), vmovl_u8(opa_mix2(vld1_u8(mask), p->opa))));
+}
+
+static void rgb565_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    vst1q_u16(dest, mix_565_565(vld1q_u16((const uint16_t *)src), vld1q_u16(dest), vmovl_u8(p->opa)));
+}
+
+static void rgb565_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(p);
+    vst1q_u16(dest, mix_565_565(vld1q_u16((const uint16_t *)src), vld1q_u16(dest), vmovl_u8(vld1_u8(mask))));
+}
+
+static void rgb565_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    uint16x8_t mix = vmovl_u8(opa_mix2(vld1_u8(mask), p->opa));
+    vst1q_u16(dest, mix_565_565(vld1q_u16((const uint16_t *)src), vld1q_u16(dest), mix));
+}
+
+static void rgb888_copy(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    uint8x8x3_t px = load_888(src, p->src_px_size);
+    vst1q_u16(dest, pack_888_565(px.val[2], px.val[1], px.val[0]));
+}
+
+static void rgb888_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    uint8x8x3_t px = load_888(src, p->src_px_size);
+    vst1q_u16(dest, mix_888_565(px.val[2], px.val[1], px.val[0], vld1q_u16(dest), p->opa));
+}
+
+static void rgb888_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    uint8x8x3_t px = load_888(src, p->src_px_size);
+    vst1q_u16(dest, mix_888_565(px.val[2], px.val[1], px.val[0], vld1q_u16(dest), vld1_u8(mask)));
+}
+
+static void rgb888_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    uint8x8x3_t px = load_888(src, p->src_px_size);
+    uint8x8_t mix = opa_mix2(vld1_u8(mask), p->opa);
+    vst1q_u16(dest, mix_888_565(px.val[2], px.val[1], px.val[0], vld1q_u16(dest), mix));
+}
+
+static void argb8888_normal(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    LV_UNUSED(p);
+    uint8x8x4_t px = vld4_u8(src);
+    vst1q_u16(dest, mix_888_565(px.val[2], px.val[1], px.val[0], vld1q_u16(dest), px.val[3]));
+}
+
+static void argb8888_with_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    uint8x8x4_t px = vld4_u8(src);
+    uint8x8_t mix = opa_mix2(px.val[3], p->opa);
+    vst1q_u16(dest, mix_888_565(px.val[2], px.val[1], px.val[0], vld1q_u16(dest), mix));
+}
+
+static void argb8888_with_mask(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(p);
+    uint8x8x4_t px = vld4_u8(src);
+    uint8x8_t mix = opa_mix2(px.val[3], vld1_u8(mask));
+    vst1q_u16(dest, mix_888_565(px.val[2], px.val[1], px.val[0], vld1q_u16(dest), mix));
+}
+
+static void argb8888_mix_mask_opa(uint16_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                  const blend_param_t * p)
+{
+    uint8x8x4_t px = vld4_u8(src);
+    uint8x8_t mix = opa_mix3(px.val[3], vld1_u8(mask), p->opa16);
+    vst1q_u16(dest, mix_888_565(px.val[2], px.val[1], px.val[0], vld1q_u16(dest), mix));
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && LV_DRAW_SW_NEON_INTRINSICS*/
@@ -0,0 +1,160 @@
+/**
+ * @file lv_draw_sw_blend_neon_to_rgb565.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_BLEND_NEON_TO_RGB565_H
+#define LV_DRAW_SW_BLEND_NEON_TO_RGB565_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_draw_sw_blend_private.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && LV_DRAW_SW_NEON_INTRINSICS
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    lv_draw_sw_blend_neon_color_to_rgb565(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    lv_draw_sw_blend_neon_color_to_rgb565_with_opa(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    lv_draw_sw_blend_neon_color_to_rgb565_with_mask(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_neon_color_to_rgb565_mix_mask_opa(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc) \
+    lv_draw_sw_blend_neon_rgb565_to_rgb565(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) \
+    lv_draw_sw_blend_neon_rgb565_to_rgb565_with_opa(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc) \
+    lv_draw_sw_blend_neon_rgb565_to_rgb565_with_mask(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_neon_rgb565_to_rgb565_mix_mask_opa(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565(dsc, src_px_size) \
+    lv_draw_sw_blend_neon_rgb888_to_rgb565(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc, src_px_size) \
+    lv_draw_sw_blend_neon_rgb888_to_rgb565_with_opa(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc, src_px_size) \
+    lv_draw_sw_blend_neon_rgb888_to_rgb565_with_mask(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc, src_px_size) \
+    lv_draw_sw_blend_neon_rgb888_to_rgb565_mix_mask_opa(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc) \
+    lv_draw_sw_blend_neon_argb8888_to_rgb565(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) \
+    lv_draw_sw_blend_neon_argb8888_to_rgb565_with_opa(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc) \
+    lv_draw_sw_blend_neon_argb8888_to_rgb565_with_mask(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_neon_argb8888_to_rgb565_mix_mask_opa(dsc)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/* The functions below give the same result as the C implementation in
+ * lv_draw_sw_blend_to_rgb565.c bit by bit. They return LV_RESULT_INVALID for
+ * the cases they don't handle so that the C implementation is used instead. */
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565_with_opa(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565_with_mask(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb565_mix_mask_opa(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565_with_opa(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565_with_mask(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb565_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size);
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565_with_opa(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size);
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565_with_mask(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size);
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb565_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                 uint32_t src_px_size);
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565_with_opa(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565_with_mask(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb565_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && LV_DRAW_SW_NEON_INTRINSICS*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_NEON_TO_RGB565_H*/
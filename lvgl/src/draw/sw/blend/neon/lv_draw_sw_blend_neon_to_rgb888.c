@@ -0,0 +1,562 @@
+/**
+ * @file lv_draw_sw_blend_neon_to_rgb888.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_draw_sw_blend_private.h"
+#include "lv_blend_neon.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && LV_DRAW_SW_NEON_INTRINSICS
+
+#include "../../../../stdlib/lv_string.h"
+#include <arm_neon.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels processed in one step*/
+#define BLEND_STEP  8
+
+/*Only XRGB8888 destinations are handled*/
+#define DEST_PX_SIZE 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint8x8_t blue;     /*The fill color*/
+    uint8x8_t green;
+    uint8x8_t red;
+    uint8x8_t opa;
+    uint16x4_t opa16;
+    uint32_t src_px_size;
+} blend_param_t;
+
+/*Blend BLEND_STEP pixels. `src` and `mask` can be NULL if not used*/
+typedef void (*blend_kernel_t)(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline void blend_area(void * dest_buf, int32_t dest_stride, int32_t w, int32_t h,
+                              const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              const blend_param_t * p, blend_kernel_t kernel);
+static inline void init_param(blend_param_t * p, lv_color_t color, lv_opa_t opa, uint32_t src_px_size);
+
+static void color_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void color_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void color_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb565_copy(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb565_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb565_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb565_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_copy(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void rgb888_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_normal(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p);
+static void argb8888_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                  const blend_param_t * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb888(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    uint32_t color32 = lv_color_to_u32(dsc->color);
+    uint32x4_t color = vdupq_n_u32(color32);
+    uint8_t * dest_row = dsc->dest_buf;
+    int32_t w = dsc->dest_w;
+    int32_t x;
+    int32_t y;
+
+    for(y = 0; y < dsc->dest_h; y++) {
+        uint32_t * dest = (uint32_t *)dest_row;
+        for(x = 0; x <= w - 16; x += 16) {
+            vst1q_u32(&dest[x], color);
+            vst1q_u32(&dest[x + 4], color);
+            vst1q_u32(&dest[x + 8], color);
+            vst1q_u32(&dest[x + 12], color);
+        }
+        for(; x < w; x++) {
+            dest[x] = color32;
+        }
+        dest_row += dsc->dest_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb888_with_opa(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, dsc->color, dsc->opa, 0);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, NULL, 0, NULL, 0, &p, color_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb888_with_mask(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, dsc->color, dsc->opa, 0);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, NULL, 0,
+               dsc->mask_buf, dsc->mask_stride, &p, color_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_color_to_rgb888_mix_mask_opa(lv_draw_sw_blend_fill_dsc_t * dsc,
+                                                               uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, dsc->color, dsc->opa, 0);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, NULL, 0,
+               dsc->mask_buf, dsc->mask_stride, &p, color_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb888(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 2);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, rgb565_copy);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb888_with_opa(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 2);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, rgb565_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb888_with_mask(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 2);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb565_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb565_to_rgb888_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 2);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb565_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb888(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size,
+                                                   uint32_t src_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    /*XRGB8888 to XRGB8888 is a plain copy, including the X byte*/
+    if(src_px_size == DEST_PX_SIZE) {
+        uint8_t * dest_row = dsc->dest_buf;
+        const uint8_t * src_row = dsc->src_buf;
+        int32_t y;
+        for(y = 0; y < dsc->dest_h; y++) {
+            lv_memcpy(dest_row, src_row, dsc->dest_w * DEST_PX_SIZE);
+            dest_row += dsc->dest_stride;
+            src_row += dsc->src_stride;
+        }
+        return LV_RESULT_OK;
+    }
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, rgb888_copy);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb888_with_opa(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size,
+                                                            uint32_t src_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, rgb888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb888_with_mask(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size,
+                                                             uint32_t src_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_rgb888_to_rgb888_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                uint32_t dest_px_size, uint32_t src_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, src_px_size);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, rgb888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb888(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, argb8888_normal);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb888_with_opa(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                              uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               NULL, 0, &p, argb8888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb888_with_mask(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                               uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, argb8888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_neon_argb8888_to_rgb888_mix_mask_opa(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                  uint32_t dest_px_size)
+{
+    if(dest_px_size != DEST_PX_SIZE) return LV_RESULT_INVALID;
+
+    blend_param_t p;
+    init_param(&p, lv_color_black(), dsc->opa, 4);
+    blend_area(dsc->dest_buf, dsc->dest_stride, dsc->dest_w, dsc->dest_h, dsc->src_buf, dsc->src_stride,
+               dsc->mask_buf, dsc->mask_stride, &p, argb8888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline void init_param(blend_param_t * p, lv_color_t color, lv_opa_t opa, uint32_t src_px_size)
+{
+    p->blue = vdup_n_u8(color.blue);
+    p->green = vdup_n_u8(color.green);
+    p->red = vdup_n_u8(color.red);
+    p->opa = vdup_n_u8(opa);
+    p->opa16 = vdup_n_u16(opa);
+    p->src_px_size = src_px_size;
+}
+
+/**
+ * Call `kernel` for every BLEND_STEP pixels of the area.
+ * The last pixels of a row are blended in a padded copy so that the kernels
+ * never read or write outside of the buffers and the result is the same as for the other pixels.
+ */
+static inline void blend_area(void * dest_buf, int32_t dest_stride, int32_t w, int32_t h,
+                              const void * src_buf, int32_t src_stride,
+                              const lv_opa_t * mask_buf, int32_t mask_stride,
+                              const blend_param_t * p, blend_kernel_t kernel)
+{
+    uint8_t * dest_row = dest_buf;
+    const uint8_t * src_row = src_buf;
+    const lv_opa_t * mask_row = mask_buf;
+    uint32_t src_px_size = p->src_px_size;
+    int32_t x;
+    int32_t y;
+
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - BLEND_STEP; x += BLEND_STEP) {
+            kernel(&dest_row[x * DEST_PX_SIZE], src_row ? &src_row[x * src_px_size] : NULL,
+                   mask_row ? &mask_row[x] : NULL, p);
+        }
+
+        if(x < w) {
+            uint8_t dest_tmp[BLEND_STEP * DEST_PX_SIZE] = {0};
+            uint8_t src_tmp[BLEND_STEP * 4] = {0};
+            lv_opa_t mask_tmp[BLEND_STEP] = {0};
+            int32_t rest = w - x;
+
+            lv_memcpy(dest_tmp, &dest_row[x * DEST_PX_SIZE], rest * DEST_PX_SIZE);
+            if(src_row) lv_memcpy(src_tmp, &src_row[x * src_px_size], rest * src_px_size);
+            if(mask_row) lv_memcpy(mask_tmp, &mask_row[x], rest);
+            kernel(dest_tmp, src_tmp, mask_tmp, p);
+            lv_memcpy(&dest_row[x * DEST_PX_SIZE], dest_tmp, rest * DEST_PX_SIZE);
+        }
+
+        dest_row += dest_stride;
+        if(src_row) src_row += src_stride;
+        if(mask_row) mask_row += mask_stride;
+    }
+}
+
+/**
+ * Same as `lv_color_24_24_mix()` of lv_draw_sw_blend_to_rgb888.c on one channel:
+ * keep `bg` for mix = 0, take `fg` for mix >= LV_OPA_MAX, else (fg * mix + bg * (255 - mix)) >> 8
+ */
+static inline uint8x8_t mix_channel(uint8x8_t fg, uint8x8_t bg, uint8x8_t mix, uint8x8_t mix_inv,
+                                    uint8x8_t keep_bg, uint8x8_t take_fg)
+{
+    uint8x8_t res = vshrn_n_u16(vmlal_u8(vmull_u8(fg, mix), bg, mix_inv), 8);
+    res = vbsl_u8(take_fg, fg, res);
+    return vbsl_u8(keep_bg, bg, res);
+}
+
+/**
+ * Mix a color into the B, G, R channels of `dest`. The X channel is not changed.
+ */
+static inline void mix_888_888(uint8x8x4_t * dest, uint8x8_t blue, uint8x8_t green, uint8x8_t red, uint8x8_t mix)
+{
+    uint8x8_t mix_inv = vmvn_u8(mix);
+    uint8x8_t keep_bg = vceq_u8(mix, vdup_n_u8(0));
+    uint8x8_t take_fg = vcge_u8(mix, vdup_n_u8(LV_OPA_MAX));
+
+    dest->val[0] = mix_channel(blue, dest->val[0], mix, mix_inv, keep_bg, take_fg);
+    dest->val[1] = mix_channel(green, dest->val[1], mix, mix_inv, keep_bg, take_fg);
+    dest->val[2] = mix_channel(red, dest->val[2], mix, mix_inv, keep_bg, take_fg);
+}
+
+/**
+ * Convert RGB565 to B, G, R with the rounding of lv_draw_sw_blend_to_rgb888.c
+ */
+static inline uint8x8x3_t unpack_565_888(const uint8_t * src)
+{
+    uint16x8_t c = vld1q_u16((const uint16_t *)src);
+    uint8x8x3_t px;
+    px.val[0] = vshrn_n_u16(vmulq_n_u16(vandq_u16(c, vdupq_n_u16(0x1F)), 2106), 8);
+    px.val[1] = vshrn_n_u16(vmulq_n_u16(vandq_u16(vshrq_n_u16(c, 5), vdupq_n_u16(0x3F)), 1037), 8);
+    px.val[2] = vshrn_n_u16(vmulq_n_u16(vshrq_n_u16(c, 11), 2106), 8);
+    return px;
+}
+
+static inline uint8x8x3_t load_888(const uint8_t * src, uint32_t src_px_size)
+{
+    uint8x8x3_t px;
+    if(src_px_size == 3) {
+        px = vld3_u8(src);
+    }
+    else {
+        uint8x8x4_t px4 = vld4_u8(src);
+        px.val[0] = px4.val[0];
+        px.val[1] = px4.val[1];
+        px.val[2] = px4.val[2];
+    }
+    return px;
+}
+
+/**
+ * LV_OPA_MIX2(a, b) = (a * b) >> 8
+ */
+static inline uint8x8_t opa_mix2(uint8x8_t a, uint8x8_t b)
+{
+    return vshrn_n_u16(vmull_u8(a, b), 8);
+}
+
+/**
+ * LV_OPA_MIX3(a, b, opa) = (a * b * opa) >> 16
+ */
+static inline uint8x8_t opa_mix3(uint8x8_t a, uint8x8_t b, uint16x4_t opa16)
+{
+    uint16x8_t ab = vmull_u8(a, b);
+    uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(ab), opa16), 16);
+    uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(ab), opa16), 16);
+    return vmovn_u16(vcombine_u16(lo, hi));
+}
+
+static void color_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(mask);
+    uint8x8x4_t d = vld4_u8(dest);
+    mix_888_888(&d, p->blue, p->green, p->red, p->opa);
+    vst4_u8(dest, d);
+}
+
+static void color_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(src);
+    uint8x8x4_t d = vld4_u8(dest);
+    mix_888_888(&d, p->blue, p->green, p->red, vld1_u8(mask));
+    vst4_u8(dest, d);
+}
+
+static void color_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(src);
+    uint8x8x4_t d = vld4_u8(dest);
+    mix_888_888(&d, p->blue, p->green, p->red, opa_mix2(p->opa, vld1_u8(mask)));
+    vst4_u8(dest, d);
+}
+
+static void rgb565_copy(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    LV_UNUSED(p);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = unpack_565_888(src);
+    d.val[0] = s.val[0];
+    d.val[1] = s.val[1];
+    d.val[2] = s.val[2];
+    vst4_u8(dest, d);
+}
+
+static void rgb565_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = unpack_565_888(src);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], p->opa);
+    vst4_u8(dest, d);
+}
+
+static void rgb565_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(p);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = unpack_565_888(src);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], vld1_u8(mask));
+    vst4_u8(dest, d);
+}
+
+static void rgb565_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = unpack_565_888(src);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], opa_mix2(p->opa, vld1_u8(mask)));
+    vst4_u8(dest, d);
+}
+
+static void rgb888_copy(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = load_888(src, p->src_px_size);
+    d.val[0] = s.val[0];
+    d.val[1] = s.val[1];
+    d.val[2] = s.val[2];
+    vst4_u8(dest, d);
+}
+
+static void rgb888_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = load_888(src, p->src_px_size);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], p->opa);
+    vst4_u8(dest, d);
+}
+
+static void rgb888_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = load_888(src, p->src_px_size);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], vld1_u8(mask));
+    vst4_u8(dest, d);
+}
+
+static void rgb888_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x3_t s = load_888(src, p->src_px_size);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], opa_mix2(p->opa, vld1_u8(mask)));
+    vst4_u8(dest, d);
+}
+
+static void argb8888_normal(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    LV_UNUSED(p);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x4_t s = vld4_u8(src);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], s.val[3]);
+    vst4_u8(dest, d);
+}
+
+static void argb8888_with_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(mask);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x4_t s = vld4_u8(src);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], opa_mix2(s.val[3], p->opa));
+    vst4_u8(dest, d);
+}
+
+static void argb8888_with_mask(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const blend_param_t * p)
+{
+    LV_UNUSED(p);
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x4_t s = vld4_u8(src);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], opa_mix2(s.val[3], vld1_u8(mask)));
+    vst4_u8(dest, d);
+}
+
+static void argb8888_mix_mask_opa(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                  const blend_param_t * p)
+{
+    uint8x8x4_t d = vld4_u8(dest);
+    uint8x8x4_t s = vld4_u8(src);
+    mix_888_888(&d, s.val[0], s.val[1], s.val[2], opa_mix3(s.val[3], vld1_u8(mask), p->opa16));
+    vst4_u8(dest, d);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && LV_DRAW_SW_NEON_INTRINSICS*/
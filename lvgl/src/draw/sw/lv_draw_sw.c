@@ -34,11 +34,21 @@
     #error "OS support is required when more than one SW rendering units are enabled"
 #endif
 
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1 && LV_USE_OS == LV_OS_NONE
+    #error "OS support is required when LV_DRAW_SW_BAND_THREAD_CNT > 1"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+/*More bands than threads so that the threads finishing earlier can take over the rest*/
+#define BANDS_PER_THREAD    4
+
+/*Don't make the bands thinner than this to limit the per band overhead (masks, line setup)*/
+#define BAND_MIN_H          8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -52,6 +62,14 @@
 
 static void execute_drawing(lv_draw_task_t * t);
 
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+    static void band_pool_init(lv_draw_sw_band_pool_t * pool);
+    static void band_pool_deinit(lv_draw_sw_band_pool_t * pool);
+    static bool band_render(lv_draw_sw_band_pool_t * pool, lv_draw_task_t * t);
+    static void band_render_available(lv_draw_sw_band_pool_t * pool);
+    static void band_thread_cb(void * ptr);
+#endif
+
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit);
@@ -79,6 +97,14 @@ void lv_draw_sw_init(void)
     lv_draw_sw_mask_init();
 #endif
 
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE
+    lv_draw_sw_shadow_cache_init();
+#endif
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    lv_draw_sw_grad_cache_init();
+#endif
+
     lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
     draw_sw_unit->base_unit.dispatch_cb = dispatch;
     draw_sw_unit->base_unit.evaluate_cb = evaluate;
@@ -100,6 +126,10 @@ void lv_draw_sw_init(void)
     }
 #endif
 
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+    band_pool_init(&draw_sw_unit->band_pool);
+#endif
+
 #if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
     if(LV_DRAW_SW_DRAW_UNIT_CNT > 1) {
         tvg_engine_init(TVG_ENGINE_SW, LV_DRAW_SW_DRAW_UNIT_CNT);
@@ -118,6 +148,14 @@ void lv_draw_sw_deinit(void)
     tvg_engine_term(TVG_ENGINE_SW);
 #endif
 
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE
+    lv_draw_sw_shadow_cache_deinit();
+#endif
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    lv_draw_sw_grad_cache_deinit();
+#endif
+
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
@@ -141,6 +179,10 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
         lv_thread_delete(&thread_dsc->thread);
     }
 
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+    band_pool_deinit(&draw_sw_unit->band_pool);
+#endif
+
     return 0;
 #else
     LV_UNUSED(draw_unit);
@@ -201,6 +243,45 @@ lv_draw_sw_blend_handler_t lv_draw_sw_get_blend_handler(lv_color_format_t dest_c
     return NULL;
 }
 
+void lv_draw_sw_set_band_thread_count(uint32_t cnt)
+{
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+    if(cnt < 1) cnt = 1;
+    if(cnt > LV_DRAW_SW_BAND_THREAD_CNT) cnt = LV_DRAW_SW_BAND_THREAD_CNT;
+
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->dispatch_cb == dispatch) {
+            lv_draw_sw_band_pool_t * pool = &((lv_draw_sw_unit_t *)u)->band_pool;
+            lv_mutex_lock(&pool->lock);
+            pool->thread_cnt = cnt;
+            lv_mutex_unlock(&pool->lock);
+        }
+        u = u->next;
+    }
+#else
+    LV_UNUSED(cnt);
+#endif
+}
+
+uint32_t lv_draw_sw_get_band_thread_count(void)
+{
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->dispatch_cb == dispatch) {
+            lv_draw_sw_band_pool_t * pool = &((lv_draw_sw_unit_t *)u)->band_pool;
+            lv_mutex_lock(&pool->lock);
+            uint32_t cnt = pool->thread_cnt;
+            lv_mutex_unlock(&pool->lock);
+            return cnt;
+        }
+        u = u->next;
+    }
+#endif
+    return 1;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -362,7 +443,14 @@ static void render_thread_cb(void * ptr)
             break;
         }
 
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+        lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) thread_dsc->draw_unit;
+        if(!band_render(&draw_sw_unit->band_pool, thread_dsc->task_act)) {
+            execute_drawing(thread_dsc->task_act);
+        }
+#else
         execute_drawing(thread_dsc->task_act);
+#endif
 #if LV_USE_PARALLEL_DRAW_DEBUG
         parallel_debug_draw(thread_dsc->task_act, thread_dsc->idx);
 #endif
@@ -431,6 +519,184 @@ static void execute_drawing(lv_draw_task_t * t)
     LV_PROFILER_DRAW_END;
 }
 
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+
+static void band_pool_init(lv_draw_sw_band_pool_t * pool)
+{
+    lv_mutex_init(&pool->lock);
+    lv_thread_sync_init(&pool->done_sync);
+    pool->thread_cnt = LV_DRAW_SW_BAND_THREAD_CNT;
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_BAND_THREAD_CNT - 1; i++) {
+        lv_draw_sw_band_thread_dsc_t * thread_dsc = &pool->thread_dscs[i];
+        thread_dsc->band_pool = pool;
+        lv_thread_sync_init(&thread_dsc->sync);
+        lv_thread_init(&thread_dsc->thread, "swband", LV_DRAW_THREAD_PRIO, band_thread_cb,
+                       LV_DRAW_THREAD_STACK_SIZE, thread_dsc);
+    }
+}
+
+static void band_pool_deinit(lv_draw_sw_band_pool_t * pool)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_BAND_THREAD_CNT - 1; i++) {
+        lv_draw_sw_band_thread_dsc_t * thread_dsc = &pool->thread_dscs[i];
+        LV_LOG_INFO("cancel band rendering thread");
+        thread_dsc->exit_status = true;
+        lv_thread_sync_signal(&thread_dsc->sync);
+        lv_thread_delete(&thread_dsc->thread);
+        lv_thread_sync_delete(&thread_dsc->sync);
+    }
+
+    lv_thread_sync_delete(&pool->done_sync);
+    lv_mutex_delete(&pool->lock);
+}
+
+/**
+ * Tell whether rendering the parts of a task independently gives the same result
+ * without redoing a lot of work or touching shared data in each band.
+ */
+static bool band_task_supported(const lv_draw_task_t * t)
+{
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                /*The setup of linear, radial and conical gradients is stored in the draw descriptor
+                 *which is shared by the bands*/
+                const lv_draw_fill_dsc_t * draw_dsc = t->draw_dsc;
+                return draw_dsc->grad.dir < LV_GRAD_DIR_LINEAR;
+            }
+        case LV_DRAW_TASK_TYPE_BORDER:
+            return true;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+        case LV_DRAW_TASK_TYPE_LAYER: {
+                const lv_draw_image_dsc_t * draw_dsc = t->draw_dsc;
+                /*The bitmap mask is decoded and applied on the whole image*/
+                if(draw_dsc->bitmap_mask_src) return false;
+                if(t->type == LV_DRAW_TASK_TYPE_LAYER) return true;
+
+                /*Files, compressed and RAW images would be decoded again for each band*/
+                if(lv_image_src_get_type(draw_dsc->src) != LV_IMAGE_SRC_VARIABLE) return false;
+                if(draw_dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) return false;
+                if(draw_dsc->header.cf == LV_COLOR_FORMAT_RAW || draw_dsc->header.cf == LV_COLOR_FORMAT_RAW_ALPHA) return false;
+                return true;
+            }
+        default:
+            /*Labels share the glyph cache, shadows and arcs compute their masks for the whole task*/
+            return false;
+    }
+}
+
+/**
+ * Render a large draw task in bands on the render thread and the helper threads.
+ * @param pool      the band pool of the draw unit
+ * @param t         the task to render
+ * @return          true: the task was rendered; false: the task is not split, render it normally
+ */
+static bool band_render(lv_draw_sw_band_pool_t * pool, lv_draw_task_t * t)
+{
+    if(!band_task_supported(t)) return false;
+
+    lv_area_t area;
+    if(!lv_area_intersect(&area, &t->_real_area, &t->clip_area)) return false;
+    if(lv_area_get_size(&area) < LV_DRAW_SW_BAND_MIN_PX) return false;
+
+    lv_mutex_lock(&pool->lock);
+
+    /*Another draw unit might use the pool*/
+    if(pool->task || pool->thread_cnt < 2) {
+        lv_mutex_unlock(&pool->lock);
+        return false;
+    }
+
+    int32_t h = lv_area_get_height(&area);
+    int32_t band_cnt = pool->thread_cnt * BANDS_PER_THREAD;
+    int32_t band_h = LV_MAX((h + band_cnt - 1) / band_cnt, BAND_MIN_H);
+    band_cnt = (h + band_h - 1) / band_h;
+    if(band_cnt < 2) {
+        lv_mutex_unlock(&pool->lock);
+        return false;
+    }
+
+    uint32_t helper_cnt = LV_MIN(pool->thread_cnt, (uint32_t)band_cnt) - 1;
+    pool->task = t;
+    pool->area = area;
+    pool->band_h = band_h;
+    pool->band_cnt = band_cnt;
+    pool->band_next = 0;
+    pool->busy_cnt = helper_cnt;
+    lv_mutex_unlock(&pool->lock);
+
+    LV_PROFILER_DRAW_BEGIN_TAG("band_render");
+
+    uint32_t i;
+    for(i = 0; i < helper_cnt; i++) {
+        lv_thread_sync_signal(&pool->thread_dscs[i].sync);
+    }
+
+    band_render_available(pool);
+
+    /*Wait for the bands still being rendered by the helpers*/
+    if(helper_cnt) lv_thread_sync_wait(&pool->done_sync);
+
+    lv_mutex_lock(&pool->lock);
+    pool->task = NULL;
+    lv_mutex_unlock(&pool->lock);
+
+    LV_PROFILER_DRAW_END_TAG("band_render");
+    return true;
+}
+
+/**
+ * Render bands of the pool's task until there are no more bands left
+ * @param pool      the band pool of the draw unit
+ */
+static void band_render_available(lv_draw_sw_band_pool_t * pool)
+{
+    while(1) {
+        lv_mutex_lock(&pool->lock);
+        if(pool->band_next >= pool->band_cnt) {
+            lv_mutex_unlock(&pool->lock);
+            break;
+        }
+        uint32_t band_idx = pool->band_next;
+        pool->band_next++;
+        lv_mutex_unlock(&pool->lock);
+
+        /*Render the same task, only clipped to the band. The bands don't overlap
+         *so they can write the same buffer in parallel.*/
+        lv_draw_task_t band_task = *pool->task;
+        band_task.clip_area = pool->area;
+        band_task.clip_area.y1 = pool->area.y1 + (int32_t)band_idx * pool->band_h;
+        band_task.clip_area.y2 = LV_MIN(band_task.clip_area.y1 + pool->band_h - 1, pool->area.y2);
+        execute_drawing(&band_task);
+    }
+}
+
+static void band_thread_cb(void * ptr)
+{
+    lv_draw_sw_band_thread_dsc_t * thread_dsc = ptr;
+    lv_draw_sw_band_pool_t * pool = thread_dsc->band_pool;
+
+    while(1) {
+        lv_thread_sync_wait(&thread_dsc->sync);
+        if(thread_dsc->exit_status) break;
+
+        band_render_available(pool);
+
+        lv_mutex_lock(&pool->lock);
+        pool->busy_cnt--;
+        bool last = pool->busy_cnt == 0;
+        lv_mutex_unlock(&pool->lock);
+
+        if(last) lv_thread_sync_signal(&pool->done_sync);
+    }
+
+    LV_LOG_INFO("exit band rendering thread");
+}
+
+#endif /*LV_DRAW_SW_BAND_THREAD_CNT > 1*/
+
 #if LV_USE_PARALLEL_DRAW_DEBUG
 static void parallel_debug_draw(lv_draw_task_t * t, uint32_t idx)
 {
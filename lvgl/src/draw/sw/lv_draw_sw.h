@@ -181,6 +181,34 @@ bool lv_draw_sw_unregister_blend_handler(lv_color_format_t dest_cf);
  */
 lv_draw_sw_blend_handler_t lv_draw_sw_get_blend_handler(lv_color_format_t dest_cf);
 
+/**
+ * Set how many threads render the bands of large draw tasks.
+ * Has effect only if LV_DRAW_SW_BAND_THREAD_CNT > 1.
+ * @param cnt   1: don't split draw tasks into bands, 2..LV_DRAW_SW_BAND_THREAD_CNT: number of threads
+ *              (larger values are clamped). The default is LV_DRAW_SW_BAND_THREAD_CNT.
+ */
+void lv_draw_sw_set_band_thread_count(uint32_t cnt);
+
+/**
+ * Get how many threads render the bands of large draw tasks.
+ * @return      the value set by `lv_draw_sw_set_band_thread_count()`, 1 if banding is disabled
+ */
+uint32_t lv_draw_sw_get_band_thread_count(void);
+
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Get how often the blurred shadow corners were found in the shadow cache.
+ * @param hit_cnt   store the number of shadows drawn from the cache here (can be NULL)
+ * @param miss_cnt  store the number of shadow corners blurred again here (can be NULL)
+ */
+void lv_draw_sw_shadow_cache_get_stats(uint32_t * hit_cnt, uint32_t * miss_cnt);
+
+/**
+ * Free all cached shadow corners
+ */
+void lv_draw_sw_shadow_cache_drop_all(void);
+#endif
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
@@ -21,6 +21,7 @@
 #include "../../misc/lv_assert.h"
 #include "../../stdlib/lv_string.h"
 #include "../lv_draw_mask.h"
+#include "../../misc/cache/lv_cache.h"
 
 /*********************
  *      DEFINES
@@ -28,20 +29,35 @@
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
     #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
+    #define CACHE_NAME  "SW_SHADOW"
 #endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+typedef struct {
+    const lv_area_t * core_area;    /**< The rectangle to blur if the corner is not cached yet*/
+    bool created;                   /**< Set if the corner was blurred and added to the cache*/
+} shadow_cache_create_info_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    static bool shadow_cache_get(const lv_area_t * core_area, int32_t sw, int32_t r, lv_opa_t * sh_buf);
+    static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data);
+    static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data);
+    static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                          const lv_draw_sw_shadow_cache_data_t * rhs);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -55,6 +71,38 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+void lv_draw_sw_shadow_cache_init(void)
+{
+    shadow_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(lv_draw_sw_shadow_cache_data_t),
+    LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) shadow_cache_free_cb,
+    });
+    lv_cache_set_name(shadow_cache.cache, CACHE_NAME);
+    shadow_cache.hit_cnt = 0;
+    shadow_cache.miss_cnt = 0;
+}
+
+void lv_draw_sw_shadow_cache_deinit(void)
+{
+    lv_cache_destroy(shadow_cache.cache, NULL);
+    shadow_cache.cache = NULL;
+}
+
+void lv_draw_sw_shadow_cache_get_stats(uint32_t * hit_cnt, uint32_t * miss_cnt)
+{
+    if(hit_cnt) *hit_cnt = shadow_cache.hit_cnt;
+    if(miss_cnt) *miss_cnt = shadow_cache.miss_cnt;
+}
+
+void lv_draw_sw_shadow_cache_drop_all(void)
+{
+    lv_cache_drop_all(shadow_cache.cache, NULL);
+}
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
 {
     /*Calculate the rectangle which is blurred to get the shadow in `shadow_area`*/
@@ -100,25 +148,11 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     lv_opa_t * sh_buf;
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        LV_ASSERT_MALLOC(sh_buf);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        LV_ASSERT_MALLOC(sh_buf);
+    /*The buffer is mirrored in place below so copy the cached corner*/
+    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_buf);
+    if(!shadow_cache_get(&core_area, dsc->width, r_sh, sh_buf)) {
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
     }
 #else
     sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
@@ -730,6 +764,92 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     lv_free(sh_ups_blur_buf);
 }
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Copy a blurred corner from the cache. If it's not cached yet it's blurred and added first.
+ * @param core_area the rectangle to blur
+ * @param sw        shadow width
+ * @param r         radius
+ * @param sh_buf    copy the corner here
+ * @return          false: the corner is too large or doesn't fit into the cache, draw it to `sh_buf`
+ */
+static bool shadow_cache_get(const lv_area_t * core_area, int32_t sw, int32_t r, lv_opa_t * sh_buf)
+{
+    int32_t size = sw + r;
+    if(size > LV_DRAW_SW_SHADOW_CACHE_SIZE) {
+        shadow_cache.miss_cnt++;
+        return false;
+    }
+
+    /*The far edges of a rectangle larger than twice the corner don't reach into the corner,
+     *so larger widgets with the same style share the cached corner*/
+    lv_draw_sw_shadow_cache_data_t search_key;
+    search_key.slot.size = size * size;
+    search_key.w = LV_MIN(lv_area_get_width(core_area), 2 * size);
+    search_key.h = LV_MIN(lv_area_get_height(core_area), 2 * size);
+    search_key.r = r;
+    search_key.sw = sw;
+    search_key.buf = NULL;
+
+    shadow_cache_create_info_t info;
+    info.core_area = core_area;
+    info.created = false;
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(shadow_cache.cache, &search_key, &info);
+    if(entry == NULL) {
+        shadow_cache.miss_cnt++;
+        return false;
+    }
+
+    lv_draw_sw_shadow_cache_data_t * data = lv_cache_entry_get_data(entry);
+    lv_memcpy(sh_buf, data->buf, size * size);
+    lv_cache_release(shadow_cache.cache, entry, NULL);
+
+    if(info.created) shadow_cache.miss_cnt++;
+    else shadow_cache.hit_cnt++;
+
+    return true;
+}
+
+static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data)
+{
+    shadow_cache_create_info_t * info = user_data;
+    int32_t size = data->sw + data->r;
+
+    /*A larger buffer is required for calculation*/
+    uint16_t * buf = lv_malloc(size * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return false;
+
+    shadow_draw_corner_buf(info->core_area, buf, data->sw, data->r);
+
+    /*Keep only the opacity values*/
+    data->buf = lv_realloc(buf, size * size);
+    if(data->buf == NULL) data->buf = (lv_opa_t *)buf;
+
+    info->created = true;
+    return true;
+}
+
+static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->buf);
+    data->buf = NULL;
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                      const lv_draw_sw_shadow_cache_data_t * rhs)
+{
+    if(lhs->sw != rhs->sw) return lhs->sw > rhs->sw ? 1 : -1;
+    if(lhs->r != rhs->r) return lhs->r > rhs->r ? 1 : -1;
+    if(lhs->w != rhs->w) return lhs->w > rhs->w ? 1 : -1;
+    if(lhs->h != rhs->h) return lhs->h > rhs->h ? 1 : -1;
+    return 0;
+}
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
@@ -12,6 +12,12 @@
 #include "../../misc/lv_types.h"
 #include "../../osal/lv_os.h"
 #include "../../misc/lv_math.h"
+#include "../../stdlib/lv_string.h"
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    #include "../../misc/cache/lv_cache.h"
+    #include "../../misc/cache/lv_cache_private.h"
+    #include "../../core/lv_global.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -26,10 +32,26 @@
     #define ALIGN(X)    (((X) + 3) & ~3)
 #endif
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    #define grad_cache  (LV_GLOBAL_DEFAULT()->sw_grad_cache)
+    #define CACHE_NAME  "SW_GRAD"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+/*A color ramp in the gradient cache. It depends only on the stops and the number of colors*/
+typedef struct {
+    lv_cache_slot_size_t slot;
+    lv_grad_stop_t stops[LV_GRADIENT_MAX_STOPS];
+    uint8_t stops_count;
+    int32_t size;
+    lv_draw_sw_grad_calc_t * grad;
+} grad_cache_data_t;
+#endif
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 typedef struct {
@@ -73,7 +95,16 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 typedef lv_result_t (*op_cache_t)(lv_draw_sw_grad_calc_t * c, void * ctx);
-static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static size_t get_item_size(int32_t size);
+static lv_draw_sw_grad_calc_t * allocate_item(int32_t size);
+static lv_draw_sw_grad_calc_t * get_ramp(const lv_grad_dsc_t * g, int32_t size);
+static void fill_ramp(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item);
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    static bool grad_cache_create_cb(grad_cache_data_t * data, void * user_data);
+    static void grad_cache_free_cb(grad_cache_data_t * data, void * user_data);
+    static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs);
+#endif
 
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
@@ -89,26 +120,14 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+static size_t get_item_size(int32_t size)
 {
-    int32_t size;
-    switch(g->dir) {
-        case LV_GRAD_DIR_HOR:
-        case LV_GRAD_DIR_LINEAR:
-        case LV_GRAD_DIR_RADIAL:
-        case LV_GRAD_DIR_CONICAL:
-            size = w;
-            break;
-        case LV_GRAD_DIR_VER:
-            size = h;
-            break;
-        default:
-            size = 64;
-    }
+    return ALIGN(sizeof(lv_draw_sw_grad_calc_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
+}
 
-    size_t req_size = ALIGN(sizeof(lv_draw_sw_grad_calc_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(
-                                                                                                           lv_opa_t));
-    lv_draw_sw_grad_calc_t * item  = lv_malloc(req_size);
+static lv_draw_sw_grad_calc_t * allocate_item(int32_t size)
+{
+    lv_draw_sw_grad_calc_t * item  = lv_malloc(get_item_size(size));
     LV_ASSERT_MALLOC(item);
     if(item == NULL) return NULL;
 
@@ -116,9 +135,86 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
     item->color_map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
     item->opa_map = (lv_opa_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_color_t)));
     item->size = size;
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    item->cache_entry = NULL;
+#endif
     return item;
 }
 
+/**
+ * Get a color ramp of `size` colors from the cache, or compute it only for the current drawing
+ * if it doesn't fit into the cache
+ */
+static lv_draw_sw_grad_calc_t * get_ramp(const lv_grad_dsc_t * g, int32_t size)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    grad_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    lv_memcpy(search_key.stops, g->stops, g->stops_count * sizeof(lv_grad_stop_t));
+    search_key.stops_count = g->stops_count;
+    search_key.size = size;
+    search_key.slot.size = get_item_size(size);
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(grad_cache, &search_key, (void *)g);
+    if(entry) {
+        grad_cache_data_t * data = lv_cache_entry_get_data(entry);
+        return data->grad;
+    }
+#endif
+
+    lv_draw_sw_grad_calc_t * item = allocate_item(size);
+    if(item == NULL) {
+        LV_LOG_WARN("Failed to allocate item for the gradient");
+        return NULL;
+    }
+
+    fill_ramp(g, item);
+    return item;
+}
+
+static void fill_ramp(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item)
+{
+    uint32_t i;
+    for(i = 0; i < item->size; i++) {
+        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
+    }
+}
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+
+static bool grad_cache_create_cb(grad_cache_data_t * data, void * user_data)
+{
+    const lv_grad_dsc_t * g = user_data;
+
+    data->grad = allocate_item(data->size);
+    if(data->grad == NULL) return false;
+
+    fill_ramp(g, data->grad);
+    data->grad->cache_entry = lv_cache_entry_get_entry(data, grad_cache->node_size);
+    return true;
+}
+
+static void grad_cache_free_cb(grad_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->grad);
+    data->grad = NULL;
+}
+
+static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs)
+{
+    if(lhs->size != rhs->size) return lhs->size > rhs->size ? 1 : -1;
+    if(lhs->stops_count != rhs->stops_count) return lhs->stops_count > rhs->stops_count ? 1 : -1;
+
+    int cmp_res = lv_memcmp(lhs->stops, rhs->stops, lhs->stops_count * sizeof(lv_grad_stop_t));
+    if(cmp_res != 0) return cmp_res > 0 ? 1 : -1;
+
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_GRADIENT_CACHE_SIZE*/
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
@@ -142,24 +238,48 @@ static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
  *     FUNCTIONS
  **********************/
 
-lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+void lv_draw_sw_grad_cache_init(void)
 {
-    /* No gradient, no cache */
-    if(g->dir == LV_GRAD_DIR_NONE) return NULL;
+    grad_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(grad_cache_data_t),
+    LV_DRAW_SW_GRADIENT_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) grad_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) grad_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) grad_cache_free_cb,
+    });
+    lv_cache_set_name(grad_cache, CACHE_NAME);
+}
 
-    /* Step 1: Search cache for the given key */
-    lv_draw_sw_grad_calc_t * item = allocate_item(g, w, h);
-    if(item == NULL) {
-        LV_LOG_WARN("Failed to allocate item for the gradient");
-        return item;
-    }
+void lv_draw_sw_grad_cache_deinit(void)
+{
+    lv_cache_destroy(grad_cache, NULL);
+    grad_cache = NULL;
+}
+#endif /*LV_DRAW_SW_GRADIENT_CACHE_SIZE*/
 
-    /* Step 3: Fill it with the gradient, as expected */
-    uint32_t i;
-    for(i = 0; i < item->size; i++) {
-        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
+lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+{
+    switch(g->dir) {
+        case LV_GRAD_DIR_NONE:
+            /* No gradient, no cache */
+            return NULL;
+        case LV_GRAD_DIR_HOR:
+            return get_ramp(g, w);
+        case LV_GRAD_DIR_VER:
+            return get_ramp(g, h);
+        case LV_GRAD_DIR_LINEAR:
+        case LV_GRAD_DIR_RADIAL:
+        case LV_GRAD_DIR_CONICAL:
+#if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
+            /* The lines are calculated from the 256 element color ramp of the setup functions */
+            return allocate_item(w);
+#else
+            /* Drawn as horizontal gradient */
+            return get_ramp(g, w);
+#endif
+        default:
+            return get_ramp(g, 64);
     }
-    return item;
 }
 
 void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
@@ -217,6 +337,12 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t *
 
 void lv_draw_sw_grad_cleanup(lv_draw_sw_grad_calc_t * grad)
 {
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    if(grad->cache_entry) {
+        lv_cache_release(grad_cache, grad->cache_entry, NULL);
+        return;
+    }
+#endif
     lv_free(grad);
 }
 
@@ -295,7 +421,7 @@ void lv_draw_sw_grad_radial_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     LV_ASSERT(r_end != 0);
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_ramp(dsc, 256);
 
     state->x0 = start.x;
     state->y0 = start.y;
@@ -464,7 +590,7 @@ void lv_draw_sw_grad_linear_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_ramp(dsc, 256);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -492,7 +618,7 @@ void lv_draw_sw_grad_linear_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
@@ -539,7 +665,7 @@ void lv_draw_sw_grad_conical_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_ramp(dsc, 256);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -564,7 +690,7 @@ void lv_draw_sw_grad_conical_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
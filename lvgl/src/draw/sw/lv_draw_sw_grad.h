@@ -30,6 +30,9 @@ typedef struct {
     lv_color_t   *  color_map;
     lv_opa_t   *  opa_map;
     uint32_t size;
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    lv_cache_entry_t * cache_entry; /**< The cache entry of a shared color ramp, NULL if it's used only by one drawing*/
+#endif
 } lv_draw_sw_grad_calc_t;
 
 
@@ -49,11 +52,20 @@ typedef struct {
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
                                                                  int32_t frac, lv_color_t * color_out, lv_opa_t * opa_out);
 
-/** Get a gradient cache from the given parameters */
+/**
+ * Get the color ramp of a horizontal or vertical gradient. The ramps are shared between the
+ * gradients with the same stops and size, so they must not be modified.
+ * For linear, radial and conical gradients it's an uninitialized line buffer for the
+ * `lv_draw_sw_grad_..._get_line` functions.
+ * @param gradient  the gradient descriptor
+ * @param w         width of the gradient's area
+ * @param h         height of the gradient's area
+ * @return          the color ramp or line buffer, NULL if there is no gradient
+ */
 lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * gradient, int32_t w, int32_t h);
 
 /**
- * Clean up the gradient item after it was get with `lv_grad_get_from_cache`.
+ * Clean up the gradient item after it was get with `lv_draw_sw_grad_get`.
  * @param grad      pointer to a gradient
  */
 void lv_draw_sw_grad_cleanup(lv_draw_sw_grad_calc_t * grad);
@@ -19,6 +19,10 @@ extern "C" {
 
 #if LV_USE_DRAW_SW
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+#include "../../misc/cache/lv_cache_private.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -41,6 +45,34 @@ typedef struct {
     volatile bool exit_status;
 } lv_draw_sw_thread_dsc_t;
 
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;          /**< Signaled when a task is split into bands */
+    void * band_pool;
+    volatile bool exit_status;
+} lv_draw_sw_band_thread_dsc_t;
+
+/**
+ * Render the horizontal bands of a large draw task in parallel.
+ * The bands are taken one by one from a shared counter by the render thread and the helper threads
+ * so the threads which finish earlier take over the remaining bands.
+ */
+typedef struct {
+    /**The render thread of the draw unit renders bands too*/
+    lv_draw_sw_band_thread_dsc_t thread_dscs[LV_DRAW_SW_BAND_THREAD_CNT - 1];
+    lv_mutex_t lock;                /**< Protects the fields below*/
+    lv_thread_sync_t done_sync;     /**< Signaled by the last helper thread which finished the task*/
+    lv_draw_task_t * task;          /**< The task being rendered in bands or NULL if the pool is free*/
+    lv_area_t area;                 /**< The area of `task` to render (clipped)*/
+    int32_t band_h;
+    uint32_t band_cnt;
+    uint32_t band_next;             /**< Index of the next band to render*/
+    uint32_t busy_cnt;              /**< Number of helper threads still working on `task`*/
+    uint32_t thread_cnt;            /**< See `lv_draw_sw_set_band_thread_count()`*/
+} lv_draw_sw_band_pool_t;
+#endif
+
 struct _lv_draw_sw_unit_t {
     lv_draw_unit_t base_unit;
 #if LV_USE_OS
@@ -48,13 +80,30 @@ struct _lv_draw_sw_unit_t {
 #else
     lv_draw_task_t * task_act;
 #endif
+#if LV_DRAW_SW_BAND_THREAD_CNT > 1
+    lv_draw_sw_band_pool_t band_pool;
+#endif
 };
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * A blurred shadow corner in the shadow cache.
+ * The corner depends only on the size of the blurred rectangle, the radius and the shadow width.
+ */
+typedef struct {
+    lv_cache_slot_size_t slot;  /**< Size of `buf` for the size based LRU*/
+    int32_t w;                  /**< Width of the blurred rectangle (spread included), clamped as
+                                 *   larger widths don't change the corner*/
+    int32_t h;                  /**< Height of the blurred rectangle, clamped the same way*/
+    int32_t r;                  /**< Radius of the blurred rectangle*/
+    int32_t sw;                 /**< Shadow width*/
+    lv_opa_t * buf;             /**< `(sw + r)^2` opacity values*/
+} lv_draw_sw_shadow_cache_data_t;
+
 typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
+    lv_cache_t * cache;
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
 } lv_draw_sw_shadow_cache_t;
 #endif
 
@@ -62,6 +111,30 @@ typedef struct {
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Create the cache of the blurred shadow corners
+ */
+void lv_draw_sw_shadow_cache_init(void);
+
+/**
+ * Free the cache of the blurred shadow corners
+ */
+void lv_draw_sw_shadow_cache_deinit(void);
+#endif
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+/**
+ * Create the cache of the gradient color ramps
+ */
+void lv_draw_sw_grad_cache_init(void);
+
+/**
+ * Free the cache of the gradient color ramps
+ */
+void lv_draw_sw_grad_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
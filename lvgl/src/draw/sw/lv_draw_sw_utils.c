@@ -16,6 +16,10 @@
     #define LV_DRAW_SW_RGB565_SWAP(...) LV_RESULT_INVALID
 #endif
 
+#ifndef LV_DRAW_SW_RGB565_TO_XRGB8888
+    #define LV_DRAW_SW_RGB565_TO_XRGB8888(...) LV_RESULT_INVALID
+#endif
+
 #ifndef LV_DRAW_SW_ROTATE90_ARGB8888
     #define LV_DRAW_SW_ROTATE90_ARGB8888(...) LV_RESULT_INVALID
 #endif
@@ -64,6 +68,22 @@
     #define LV_DRAW_SW_ROTATE270_L8(...) LV_RESULT_INVALID
 #endif
 
+/*The 90 and 270 degree rotations are done in square tiles of this size
+ *so that the source columns and destination rows of a tile stay in the cache*/
+#define ROTATE_TILE_SIZE 32
+
+#ifndef LV_DRAW_SW_UTILS_NEON
+    #if defined(__ARM_NEON) && defined(__aarch64__)
+        #define LV_DRAW_SW_UTILS_NEON 1
+    #else
+        #define LV_DRAW_SW_UTILS_NEON 0
+    #endif
+#endif
+
+#if LV_DRAW_SW_UTILS_NEON
+    #include <arm_neon.h>
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -73,6 +93,8 @@
  **********************/
 
 #if LV_DRAW_SW_SUPPORT_ARGB8888 || LV_DRAW_SW_SUPPORT_XRGB8888
+static void rotate_tiled_u32(const uint32_t * src, uint32_t * dst, int32_t src_width, int32_t src_height,
+                             int32_t src_stride, int32_t dst_stride, bool rot270);
 static void rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t src_width, int32_t src_height,
                               int32_t src_stride,
                               int32_t dst_stride);
@@ -92,6 +114,8 @@ static void rotate270_rgb888(const uint8_t * src, uint8_t * dst, int32_t width,
                              int32_t dst_stride);
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB565
+static void rotate_tiled_u16(const uint16_t * src, uint16_t * dst, int32_t src_width, int32_t src_height,
+                             int32_t src_stride, int32_t dst_stride, bool rot270);
 static void rotate90_rgb565(const uint16_t * src, uint16_t * dst, int32_t src_width, int32_t src_height,
                             int32_t src_stride,
                             int32_t dst_stride);
@@ -189,6 +213,44 @@ void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px)
 
 }
 
+void lv_draw_sw_rgb565_to_xrgb8888(const void * src, void * dest, uint32_t px_cnt)
+{
+    if(LV_DRAW_SW_RGB565_TO_XRGB8888(src, dest, px_cnt) == LV_RESULT_OK) return;
+
+    const uint16_t * src16 = src;
+    uint32_t * dest32 = dest;
+
+#if LV_DRAW_SW_UTILS_NEON
+    /*8 pixels at once: widen each channel by replicating its top bits and store them interleaved as B, G, R, X*/
+    uint8x8x4_t px;
+    px.val[3] = vdup_n_u8(0xff);
+    while(px_cnt >= 8) {
+        uint16x8_t c = vld1q_u16(src16);
+        uint8x8_t r = vshrn_n_u16(c, 8);
+        uint8x8_t g = vshrn_n_u16(vshlq_n_u16(c, 5), 8);
+        uint8x8_t b = vshrn_n_u16(vshlq_n_u16(c, 11), 8);
+        px.val[0] = vsri_n_u8(b, b, 5);
+        px.val[1] = vsri_n_u8(g, g, 6);
+        px.val[2] = vsri_n_u8(r, r, 5);
+        vst4_u8((uint8_t *)dest32, px);
+        src16 += 8;
+        dest32 += 8;
+        px_cnt -= 8;
+    }
+#endif
+
+    while(px_cnt) {
+        uint32_t c = *src16;
+        uint32_t r = (c >> 11) & 0x1f;
+        uint32_t g = (c >> 5) & 0x3f;
+        uint32_t b = c & 0x1f;
+        *dest32 = 0xff000000 | ((r << 3 | r >> 2) << 16) | ((g << 2 | g >> 4) << 8) | (b << 3 | b >> 2);
+        src16++;
+        dest32++;
+        px_cnt--;
+    }
+}
+
 void lv_draw_sw_i1_invert(void * buf, uint32_t buf_size)
 {
     if(buf == NULL) return;
@@ -360,14 +422,7 @@ static void rotate270_argb8888(const uint32_t * src, uint32_t * dst, int32_t src
     src_stride /= sizeof(uint32_t);
     dst_stride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < src_width; ++x) {
-        int32_t dstIndex = x * dst_stride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < src_height; ++y) {
-            dst[dstIndex + (src_height - y - 1)] = src[srcIndex];
-            srcIndex += src_stride;
-        }
-    }
+    rotate_tiled_u32(src, dst, src_width, src_height, src_stride, dst_stride, true);
 }
 
 static void rotate180_argb8888(const uint32_t * src, uint32_t * dst, int32_t width, int32_t height, int32_t src_stride,
@@ -400,12 +455,88 @@ static void rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t src_
     src_stride /= sizeof(uint32_t);
     dst_stride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < src_width; ++x) {
-        int32_t dstIndex = (src_width - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < src_height; ++y) {
-            dst[dstIndex * dst_stride + y] = src[srcIndex];
-            srcIndex += src_stride;
+    rotate_tiled_u32(src, dst, src_width, src_height, src_stride, dst_stride, false);
+}
+
+#if LV_DRAW_SW_UTILS_NEON
+/**
+ * Transpose a 4x4 block of 32 bit pixels.
+ * Source column `i` is written to `dst + i * dst_step`, in reverse order if `reverse` is set.
+ */
+static inline void transpose4x4_u32_neon(const uint32_t * src, int32_t src_stride, uint32_t * dst, int32_t dst_step,
+                                         bool reverse)
+{
+    uint32x4_t r0 = vld1q_u32(src);
+    uint32x4_t r1 = vld1q_u32(src + src_stride);
+    uint32x4_t r2 = vld1q_u32(src + 2 * src_stride);
+    uint32x4_t r3 = vld1q_u32(src + 3 * src_stride);
+
+    uint64x2_t t0 = vreinterpretq_u64_u32(vtrn1q_u32(r0, r1));
+    uint64x2_t t1 = vreinterpretq_u64_u32(vtrn2q_u32(r0, r1));
+    uint64x2_t t2 = vreinterpretq_u64_u32(vtrn1q_u32(r2, r3));
+    uint64x2_t t3 = vreinterpretq_u64_u32(vtrn2q_u32(r2, r3));
+
+    uint32x4_t c[4];
+    c[0] = vreinterpretq_u32_u64(vtrn1q_u64(t0, t2));
+    c[1] = vreinterpretq_u32_u64(vtrn1q_u64(t1, t3));
+    c[2] = vreinterpretq_u32_u64(vtrn2q_u64(t0, t2));
+    c[3] = vreinterpretq_u32_u64(vtrn2q_u64(t1, t3));
+
+    for(int32_t i = 0; i < 4; i++) {
+        uint32x4_t v = c[i];
+        if(reverse) {
+            v = vrev64q_u32(v);
+            v = vextq_u32(v, v, 2);
+        }
+        vst1q_u32(dst + i * dst_step, v);
+    }
+}
+#endif /*LV_DRAW_SW_UTILS_NEON*/
+
+/**
+ * Rotate the rows `y1..y2-1` and columns `x1..x2-1` of the source pixel by pixel
+ */
+static void rotate_part_u32(const uint32_t * src, uint32_t * dst, int32_t src_width, int32_t src_height,
+                            int32_t src_stride, int32_t dst_stride, int32_t x1, int32_t y1, int32_t x2, int32_t y2,
+                            bool rot270)
+{
+    for(int32_t y = y1; y < y2; y++) {
+        const uint32_t * s = src + y * src_stride;
+        if(rot270) {
+            uint32_t * d = dst + (src_height - y - 1);
+            for(int32_t x = x1; x < x2; x++) d[x * dst_stride] = s[x];
+        }
+        else {
+            uint32_t * d = dst + y;
+            for(int32_t x = x1; x < x2; x++) d[(src_width - x - 1) * dst_stride] = s[x];
+        }
+    }
+}
+
+/**
+ * Rotate by 90 (`rot270 == false`) or 270 degrees tile by tile.
+ * The strides are in pixels.
+ */
+static void rotate_tiled_u32(const uint32_t * src, uint32_t * dst, int32_t src_width, int32_t src_height,
+                             int32_t src_stride, int32_t dst_stride, bool rot270)
+{
+    for(int32_t ty = 0; ty < src_height; ty += ROTATE_TILE_SIZE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE_SIZE, src_height);
+        for(int32_t tx = 0; tx < src_width; tx += ROTATE_TILE_SIZE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE_SIZE, src_width);
+            int32_t y = ty;
+#if LV_DRAW_SW_UTILS_NEON
+            for(; y + 4 <= ty_end; y += 4) {
+                int32_t x = tx;
+                for(; x + 4 <= tx_end; x += 4) {
+                    const uint32_t * s = src + y * src_stride + x;
+                    if(rot270) transpose4x4_u32_neon(s, src_stride, dst + x * dst_stride + (src_height - y - 4), dst_stride, true);
+                    else transpose4x4_u32_neon(s, src_stride, dst + (src_width - x - 1) * dst_stride + y, -dst_stride, false);
+                }
+                rotate_part_u32(src, dst, src_width, src_height, src_stride, dst_stride, x, y, tx_end, y + 4, rot270);
+            }
+#endif
+            rotate_part_u32(src, dst, src_width, src_height, src_stride, dst_stride, tx, y, tx_end, ty_end, rot270);
         }
     }
 }
@@ -484,14 +615,7 @@ static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t src_w
     src_stride /= sizeof(uint16_t);
     dst_stride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < src_width; ++x) {
-        int32_t dstIndex = x * dst_stride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < src_height; ++y) {
-            dst[dstIndex + (src_height - y - 1)] = src[srcIndex];
-            srcIndex += src_stride;
-        }
-    }
+    rotate_tiled_u16(src, dst, src_width, src_height, src_stride, dst_stride, true);
 }
 
 static void rotate180_rgb565(const uint16_t * src, uint16_t * dst, int32_t width, int32_t height, int32_t src_stride,
@@ -524,12 +648,104 @@ static void rotate90_rgb565(const uint16_t * src, uint16_t * dst, int32_t src_wi
     src_stride /= sizeof(uint16_t);
     dst_stride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < src_width; ++x) {
-        int32_t dstIndex = (src_width - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < src_height; ++y) {
-            dst[dstIndex * dst_stride + y] = src[srcIndex];
-            srcIndex += src_stride;
+    rotate_tiled_u16(src, dst, src_width, src_height, src_stride, dst_stride, false);
+}
+
+#if LV_DRAW_SW_UTILS_NEON
+/**
+ * Transpose an 8x8 block of 16 bit pixels.
+ * Source column `i` is written to `dst + i * dst_step`, in reverse order if `reverse` is set.
+ */
+static inline void transpose8x8_u16_neon(const uint16_t * src, int32_t src_stride, uint16_t * dst, int32_t dst_step,
+                                         bool reverse)
+{
+    uint16x8_t r[8];
+    for(int32_t i = 0; i < 8; i++) r[i] = vld1q_u16(src + i * src_stride);
+
+    /*Swap 16 bit elements of row pairs, then 32 bit pairs, then 64 bit halves*/
+    uint32x4_t t0 = vreinterpretq_u32_u16(vtrn1q_u16(r[0], r[1]));
+    uint32x4_t t1 = vreinterpretq_u32_u16(vtrn2q_u16(r[0], r[1]));
+    uint32x4_t t2 = vreinterpretq_u32_u16(vtrn1q_u16(r[2], r[3]));
+    uint32x4_t t3 = vreinterpretq_u32_u16(vtrn2q_u16(r[2], r[3]));
+    uint32x4_t t4 = vreinterpretq_u32_u16(vtrn1q_u16(r[4], r[5]));
+    uint32x4_t t5 = vreinterpretq_u32_u16(vtrn2q_u16(r[4], r[5]));
+    uint32x4_t t6 = vreinterpretq_u32_u16(vtrn1q_u16(r[6], r[7]));
+    uint32x4_t t7 = vreinterpretq_u32_u16(vtrn2q_u16(r[6], r[7]));
+
+    uint64x2_t u0 = vreinterpretq_u64_u32(vtrn1q_u32(t0, t2));
+    uint64x2_t u1 = vreinterpretq_u64_u32(vtrn1q_u32(t1, t3));
+    uint64x2_t u2 = vreinterpretq_u64_u32(vtrn2q_u32(t0, t2));
+    uint64x2_t u3 = vreinterpretq_u64_u32(vtrn2q_u32(t1, t3));
+    uint64x2_t u4 = vreinterpretq_u64_u32(vtrn1q_u32(t4, t6));
+    uint64x2_t u5 = vreinterpretq_u64_u32(vtrn1q_u32(t5, t7));
+    uint64x2_t u6 = vreinterpretq_u64_u32(vtrn2q_u32(t4, t6));
+    uint64x2_t u7 = vreinterpretq_u64_u32(vtrn2q_u32(t5, t7));
+
+    uint16x8_t c[8];
+    c[0] = vreinterpretq_u16_u64(vtrn1q_u64(u0, u4));
+    c[1] = vreinterpretq_u16_u64(vtrn1q_u64(u1, u5));
+    c[2] = vreinterpretq_u16_u64(vtrn1q_u64(u2, u6));
+    c[3] = vreinterpretq_u16_u64(vtrn1q_u64(u3, u7));
+    c[4] = vreinterpretq_u16_u64(vtrn2q_u64(u0, u4));
+    c[5] = vreinterpretq_u16_u64(vtrn2q_u64(u1, u5));
+    c[6] = vreinterpretq_u16_u64(vtrn2q_u64(u2, u6));
+    c[7] = vreinterpretq_u16_u64(vtrn2q_u64(u3, u7));
+
+    for(int32_t i = 0; i < 8; i++) {
+        uint16x8_t v = c[i];
+        if(reverse) {
+            v = vrev64q_u16(v);
+            v = vextq_u16(v, v, 4);
+        }
+        vst1q_u16(dst + i * dst_step, v);
+    }
+}
+#endif /*LV_DRAW_SW_UTILS_NEON*/
+
+/**
+ * Rotate the rows `y1..y2-1` and columns `x1..x2-1` of the source pixel by pixel
+ */
+static void rotate_part_u16(const uint16_t * src, uint16_t * dst, int32_t src_width, int32_t src_height,
+                            int32_t src_stride, int32_t dst_stride, int32_t x1, int32_t y1, int32_t x2, int32_t y2,
+                            bool rot270)
+{
+    for(int32_t y = y1; y < y2; y++) {
+        const uint16_t * s = src + y * src_stride;
+        if(rot270) {
+            uint16_t * d = dst + (src_height - y - 1);
+            for(int32_t x = x1; x < x2; x++) d[x * dst_stride] = s[x];
+        }
+        else {
+            uint16_t * d = dst + y;
+            for(int32_t x = x1; x < x2; x++) d[(src_width - x - 1) * dst_stride] = s[x];
+        }
+    }
+}
+
+/**
+ * Rotate by 90 (`rot270 == false`) or 270 degrees tile by tile.
+ * The strides are in pixels.
+ */
+static void rotate_tiled_u16(const uint16_t * src, uint16_t * dst, int32_t src_width, int32_t src_height,
+                             int32_t src_stride, int32_t dst_stride, bool rot270)
+{
+    for(int32_t ty = 0; ty < src_height; ty += ROTATE_TILE_SIZE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE_SIZE, src_height);
+        for(int32_t tx = 0; tx < src_width; tx += ROTATE_TILE_SIZE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE_SIZE, src_width);
+            int32_t y = ty;
+#if LV_DRAW_SW_UTILS_NEON
+            for(; y + 8 <= ty_end; y += 8) {
+                int32_t x = tx;
+                for(; x + 8 <= tx_end; x += 8) {
+                    const uint16_t * s = src + y * src_stride + x;
+                    if(rot270) transpose8x8_u16_neon(s, src_stride, dst + x * dst_stride + (src_height - y - 8), dst_stride, true);
+                    else transpose8x8_u16_neon(s, src_stride, dst + (src_width - x - 1) * dst_stride + y, -dst_stride, false);
+                }
+                rotate_part_u16(src, dst, src_width, src_height, src_stride, dst_stride, x, y, tx_end, y + 8, rot270);
+            }
+#endif
+            rotate_part_u16(src, dst, src_width, src_height, src_stride, dst_stride, tx, y, tx_end, ty_end, rot270);
         }
     }
 }
@@ -53,6 +53,15 @@ void lv_draw_sw_i1_to_argb8888(const void * buf_i1, void * buf_argb8888, uint32_
  */
 void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px);
 
+/**
+ * Convert RGB565 pixels to XRGB8888, e.g. to show a 16 bit rendered buffer on a 32 bit display.
+ * The channels are widened by replicating their upper bits so white stays white.
+ * @param src           pointer to the RGB565 pixels
+ * @param dest          pointer to the XRGB8888 destination, can't overlap `src`
+ * @param px_cnt        number of pixels to convert
+ */
+void lv_draw_sw_rgb565_to_xrgb8888(const void * src, void * dest, uint32_t px_cnt);
+
 /**
  * Invert a draw buffer in the I1 color format.
  * Conventionally, a bit is set to 1 during blending if the luminance is greater than 127.
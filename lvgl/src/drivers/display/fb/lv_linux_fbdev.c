@@ -9,6 +9,10 @@
 #include "lv_linux_fbdev.h"
 #if LV_USE_LINUX_FBDEV
 
+#if LV_LINUX_FBDEV_PAGE_FLIP && (LV_LINUX_FBDEV_BSD || !LV_LINUX_FBDEV_MMAP)
+    #error "LV_LINUX_FBDEV_PAGE_FLIP requires LV_LINUX_FBDEV_MMAP and Linux framebuffer"
+#endif
+
 #include <stdlib.h>
 #include <unistd.h>
 #include <stddef.h>
@@ -17,6 +21,9 @@
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 #include <time.h>
+#if LV_LINUX_FBDEV_ASYNC_FLUSH
+    #include <pthread.h>
+#endif
 
 #if LV_LINUX_FBDEV_BSD
     #include <sys/fcntl.h>
@@ -28,11 +35,21 @@
 
 #include "../../../display/lv_display_private.h"
 #include "../../../draw/sw/lv_draw_sw.h"
+#if LV_LINUX_FBDEV_MMAP
+    #include "lv_linux_fbdev_copy.h"
+#endif
 
 /*********************
  *      DEFINES
  *********************/
 
+/*Tile sizes tried with auto tuning: the requested size /4, /2, x1, x2, x4 and the whole buffer*/
+#define TILE_TUNE_MAX           6
+/*Render at least this many screens with each tile size before comparing them*/
+#define TILE_TUNE_SCREENS       4
+/*Give up waiting for large redraws after this many frames and compare what was measured*/
+#define TILE_TUNE_FRAMES_MAX    1000
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -49,9 +66,25 @@ struct bsd_fb_fix_info {
     long int smem_len;
 };
 
+/*An area to write to the framebuffer*/
+typedef struct {
+    uint32_t fb_pos;                    /*Byte offset of the first pixel in the framebuffer*/
+    const uint8_t * data;
+    size_t src_stride;
+    size_t row_size;                    /*Bytes per row in the framebuffer*/
+    int32_t rows;
+    lv_display_rotation_t rotation;     /*Rotate `data` while writing*/
+    int32_t src_w;                      /*Size of the unrotated area*/
+    int32_t src_h;
+    lv_color_format_t cf;
+    bool convert;                       /*Convert RGB565 `data` to XRGB8888 while writing*/
+} lv_linux_fb_job_t;
+
 typedef struct {
     const char * devname;
-    lv_color_format_t color_format;
+    lv_color_format_t color_format;     /*Requested render format (LV_COLOR_FORMAT_UNKNOWN: the framebuffer's)*/
+    bool convert;                       /*Rendering in RGB565 for a 32 bpp framebuffer*/
+    uint8_t * convert_buf;              /*One converted row for `write()`*/
 #if LV_LINUX_FBDEV_BSD
     struct bsd_fb_var_info vinfo;
     struct bsd_fb_fix_info finfo;
@@ -67,6 +100,35 @@ typedef struct {
     long int screensize;
     int fbfd;
     bool force_refresh;
+#if LV_LINUX_FBDEV_PAGE_FLIP
+    bool page_flip;             /*Rendering directly into the two halves of the framebuffer*/
+    bool pan_pending;           /*A page was flipped and the old front page may still be scanned out*/
+    bool vsync_supported;       /*FBIO_WAITFORVSYNC works*/
+    uint32_t frame_period_us;
+    uint64_t pan_time_us;
+    uint64_t vblank_time_us;    /*Last vertical blank reported by the application (0: unknown)*/
+#endif
+#if LV_LINUX_FBDEV_ASYNC_FLUSH
+    bool async_running;         /*The flush thread copies the areas*/
+    bool async_pending;         /*An area is handed to the flush thread and not copied yet*/
+    bool async_exit;            /*The display is deleted, the flush thread has to return*/
+    pthread_t async_thread;
+    pthread_mutex_t async_lock;
+    pthread_cond_t async_cond;
+    lv_linux_fb_job_t async_job;
+#endif
+    uint32_t buf_size;          /*Allocated size of a draw buffer*/
+    uint32_t tile_size;         /*Requested tile size in bytes (0: whole buffer)*/
+    bool tile_auto;
+    int32_t tile_rows;          /*Full width rows per tile (0: not tiled or being tuned)*/
+    uint32_t tune_cnt;          /*Number of tile sizes being compared (0: not tuning)*/
+    uint32_t tune_act;
+    uint32_t tune_frames;
+    int32_t tune_rows[TILE_TUNE_MAX];
+    uint64_t tune_us[TILE_TUNE_MAX];
+    uint64_t tune_px[TILE_TUNE_MAX];
+    uint64_t render_start_us;
+    uint32_t frame_px;          /*Pixels flushed since LV_EVENT_RENDER_START*/
 } lv_linux_fb_t;
 
 /**********************
@@ -75,6 +137,29 @@ typedef struct {
 
 static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * color_p);
 static uint32_t tick_get_cb(void);
+static void write_to_fb(lv_linux_fb_t * dsc, uint32_t fb_pos, const uint8_t * data, size_t row_size,
+                        size_t src_stride, int32_t rows);
+static void write_job(lv_linux_fb_t * dsc, const lv_linux_fb_job_t * job);
+static void convert_to_fb(lv_linux_fb_t * dsc, const lv_linux_fb_job_t * job);
+static void refresh_screen(lv_linux_fb_t * dsc);
+static void tile_init(lv_display_t * disp, lv_linux_fb_t * dsc);
+static void tile_set_rows(lv_display_t * disp, lv_linux_fb_t * dsc, int32_t rows);
+static void tile_tune_event_cb(lv_event_t * e);
+static uint64_t time_us(void);
+static void init_draw_buffers(lv_display_t * disp, lv_linux_fb_t * dsc);
+#if LV_LINUX_FBDEV_ASYNC_FLUSH
+    static void async_flush_start(lv_display_t * disp, lv_linux_fb_t * dsc);
+    static void * async_flush_thread(void * arg);
+    static void async_flush_wait_cb(lv_display_t * disp);
+    static void async_flush_delete_cb(lv_event_t * e);
+#endif
+#if LV_LINUX_FBDEV_PAGE_FLIP
+    static bool page_flip_setup(lv_linux_fb_t * dsc);
+    static bool page_flip_init_buffers(lv_display_t * disp, lv_linux_fb_t * dsc);
+    static void page_flip_refr_start_cb(lv_event_t * e);
+    static void page_flip_resolution_changed_cb(lv_event_t * e);
+    static uint32_t get_frame_period_us(const struct fb_var_screeninfo * vinfo);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -110,6 +195,8 @@ lv_display_t * lv_linux_fbdev_create(void)
         return NULL;
     }
     dsc->fbfd = -1;
+    dsc->tile_size = LV_LINUX_FBDEV_TILE_SIZE;
+    dsc->tile_auto = LV_LINUX_FBDEV_TILE_AUTO;
     lv_display_set_driver_data(disp, dsc);
     lv_display_set_flush_cb(disp, flush_cb);
 
@@ -181,6 +268,20 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
 
     LV_LOG_INFO("%dx%d, %dbpp", dsc->vinfo.xres, dsc->vinfo.yres, dsc->vinfo.bits_per_pixel);
 
+    /* Render in RGB565 and convert while flushing to halve the rendering bandwidth on 32 bpp framebuffers*/
+    dsc->convert = dsc->color_format == LV_COLOR_FORMAT_RGB565 && dsc->vinfo.bits_per_pixel == 32;
+    if(dsc->color_format != LV_COLOR_FORMAT_UNKNOWN && !dsc->convert &&
+       lv_color_format_get_bpp(dsc->color_format) != (uint32_t)dsc->vinfo.bits_per_pixel) {
+        LV_LOG_WARN("Can't render in the requested color format for a %d bpp framebuffer", dsc->vinfo.bits_per_pixel);
+    }
+
+#if LV_LINUX_FBDEV_PAGE_FLIP
+    /* Needs to be done before mmap as it can change the size of the framebuffer.
+     * Page flipping renders straight into the framebuffer so it can't convert or rotate*/
+    dsc->page_flip = !dsc->convert && lv_display_get_rotation(disp) == LV_DISPLAY_ROTATION_0 &&
+                     page_flip_setup(dsc);
+#endif
+
     /* Figure out the size of the screen in bytes*/
     dsc->screensize =  dsc->finfo.smem_len;/*finfo.line_length * vinfo.yres;*/
 
@@ -206,7 +307,7 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
             lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB888);
             break;
         case 32:
-            lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+            lv_display_set_color_format(disp, dsc->convert ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_XRGB8888);
             break;
         default:
             LV_LOG_WARN("Not supported color format (%d bits)", dsc->vinfo.bits_per_pixel);
@@ -216,24 +317,23 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
     int32_t hor_res = dsc->vinfo.xres;
     int32_t ver_res = dsc->vinfo.yres;
     int32_t width = dsc->vinfo.width;
-    uint32_t draw_buf_size = hor_res * (dsc->vinfo.bits_per_pixel >> 3);
-    if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        draw_buf_size *= LV_LINUX_FBDEV_BUFFER_SIZE;
-    }
-    else {
-        draw_buf_size *= ver_res;
-    }
-
-    uint8_t * draw_buf = NULL;
-    uint8_t * draw_buf_2 = NULL;
-    draw_buf = malloc(draw_buf_size);
 
-    if(LV_LINUX_FBDEV_BUFFER_COUNT == 2) {
-        draw_buf_2 = malloc(draw_buf_size);
+#if LV_LINUX_FBDEV_PAGE_FLIP
+    if(dsc->page_flip) {
+        lv_display_set_resolution(disp, hor_res, ver_res);
+        dsc->page_flip = page_flip_init_buffers(disp, dsc);
+        if(dsc->page_flip) {
+            LV_LOG_USER("Rendering directly into the framebuffer with page flipping");
+            if(width > 0) {
+                lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 254, width * 10));
+            }
+            return;
+        }
     }
+#endif
 
     lv_display_set_resolution(disp, hor_res, ver_res);
-    lv_display_set_buffers(disp, draw_buf, draw_buf_2, draw_buf_size, LV_LINUX_FBDEV_RENDER_MODE);
+    init_draw_buffers(disp, dsc);
 
     if(width > 0) {
         lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 254, width * 10));
@@ -243,24 +343,69 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
                 hor_res, ver_res, lv_display_get_dpi(disp));
 }
 
+void lv_linux_fbdev_set_render_format(lv_display_t * disp, lv_color_format_t cf)
+{
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    dsc->color_format = cf;
+}
+
 void lv_linux_fbdev_set_force_refresh(lv_display_t * disp, bool enabled)
 {
     lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
     dsc->force_refresh = enabled;
 }
 
+void lv_linux_fbdev_set_vblank_time(lv_display_t * disp, uint64_t time_us)
+{
+#if LV_LINUX_FBDEV_PAGE_FLIP
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    dsc->vblank_time_us = time_us;
+#else
+    LV_UNUSED(disp);
+    LV_UNUSED(time_us);
+#endif
+}
+
+void lv_linux_fbdev_set_tile_size(lv_display_t * disp, uint32_t size, bool auto_tune)
+{
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    dsc->tile_size = size;
+    dsc->tile_auto = auto_tune;
+}
+
+int32_t lv_linux_fbdev_get_tile_rows(lv_display_t * disp)
+{
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    return dsc->tune_cnt ? 0 : dsc->tile_rows;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static void write_to_fb(lv_linux_fb_t * dsc, uint32_t fb_pos, const void * data, size_t sz)
+/**
+ * Copy `rows` rows of `row_size` bytes to the framebuffer starting at `fb_pos`.
+ * If both the source and the framebuffer rows are contiguous (full width without padding)
+ * the rows are merged into a single copy.
+ */
+static void write_to_fb(lv_linux_fb_t * dsc, uint32_t fb_pos, const uint8_t * data, size_t row_size,
+                        size_t src_stride, int32_t rows)
 {
+    size_t fb_stride = dsc->finfo.line_length;
 #if LV_LINUX_FBDEV_MMAP
-    uint8_t * fbp = (uint8_t *)dsc->fbp;
-    lv_memcpy(&fbp[fb_pos], data, sz);
+    lv_linux_fbdev_copy_rows((uint8_t *)dsc->fbp + fb_pos, fb_stride, data, src_stride, row_size, rows);
 #else
-    if(pwrite(dsc->fbfd, data, sz, fb_pos) < 0)
-        LV_LOG_ERROR("write failed: %d", errno);
+    if(src_stride == row_size && fb_stride == row_size) {
+        row_size *= rows;
+        rows = 1;
+    }
+
+    for(; rows > 0; rows--) {
+        if(pwrite(dsc->fbfd, data, row_size, fb_pos) < 0)
+            LV_LOG_ERROR("write failed: %d", errno);
+        fb_pos += fb_stride;
+        data += src_stride;
+    }
 #endif
 }
 
@@ -275,51 +420,51 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
     }
 #endif
 
+    dsc->frame_px += lv_area_get_size(area);
+
+#if LV_LINUX_FBDEV_PAGE_FLIP
+    if(dsc->page_flip) {
+        /* The areas were rendered in place, only show the new page when the whole frame is ready*/
+        if(lv_display_flush_is_last(disp)) {
+            dsc->vinfo.xoffset = 0;
+            dsc->vinfo.yoffset = color_p == (uint8_t *)dsc->fbp ? 0 : dsc->vinfo.yres;
+            if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+                perror("ioctl(FBIOPAN_DISPLAY)");
+            }
+            dsc->pan_time_us = time_us();
+            dsc->pan_pending = true;
+        }
+        lv_display_flush_ready(disp);
+        return;
+    }
+#endif
+
     int32_t w = lv_area_get_width(area);
     int32_t h = lv_area_get_height(area);
     lv_color_format_t cf = lv_display_get_color_format(disp);
     uint32_t px_size = lv_color_format_get_size(cf);
+    uint32_t fb_px_size = dsc->vinfo.bits_per_pixel >> 3;
 
-    lv_area_t rotated_area;
-    lv_display_rotation_t rotation = lv_display_get_rotation(disp);
+    lv_linux_fb_job_t job;
+    job.rotation = LV_DISPLAY_ROTATION_0;
+    job.convert = dsc->convert;
 
     /* Not all framebuffer kernel drivers support hardware rotation, so we need to handle it in software here */
+    lv_area_t rotated_area;
+    lv_display_rotation_t rotation = lv_display_get_rotation(disp);
     if(rotation != LV_DISPLAY_ROTATION_0 && LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /* (Re)allocate temporary buffer if needed */
-        size_t buf_size = w * h * px_size;
-        if(!dsc->rotated_buf || dsc->rotated_buf_size != buf_size) {
-            dsc->rotated_buf = realloc(dsc->rotated_buf, buf_size);
-            dsc->rotated_buf_size = buf_size;
-        }
-
-        /* Rotate the pixel buffer */
-        uint32_t w_stride = lv_draw_buf_width_to_stride(w, cf);
-        uint32_t h_stride = lv_draw_buf_width_to_stride(h, cf);
-
-        switch(rotation) {
-            case LV_DISPLAY_ROTATION_0:
-                break;
-            case LV_DISPLAY_ROTATION_90:
-                lv_draw_sw_rotate(color_p, dsc->rotated_buf, w, h, w_stride, h_stride, rotation, cf);
-                break;
-            case LV_DISPLAY_ROTATION_180:
-                lv_draw_sw_rotate(color_p, dsc->rotated_buf, w, h, w_stride, w_stride, rotation, cf);
-                break;
-            case LV_DISPLAY_ROTATION_270:
-                lv_draw_sw_rotate(color_p, dsc->rotated_buf, w, h, w_stride, h_stride, rotation, cf);
-                break;
-        }
-        color_p = dsc->rotated_buf;
+        job.rotation = rotation;
+        job.src_w = w;
+        job.src_h = h;
+        job.cf = cf;
 
         /* Rotate the area */
         rotated_area = *area;
         lv_display_rotate_area(disp, &rotated_area);
         area = &rotated_area;
 
-        if(rotation != LV_DISPLAY_ROTATION_180) {
-            w = lv_area_get_width(area);
-            h = lv_area_get_height(area);
-        }
+        w = lv_area_get_width(area);
+        h = lv_area_get_height(area);
     }
 
     /* Ensure that we're within the framebuffer's bounds */
@@ -328,39 +473,248 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
         return;
     }
 
-    uint32_t fb_pos =
-        (area->x1 + dsc->vinfo.xoffset) * px_size +
+    job.fb_pos =
+        (area->x1 + dsc->vinfo.xoffset) * fb_px_size +
         (area->y1 + dsc->vinfo.yoffset) * dsc->finfo.line_length;
+    job.row_size = w * fb_px_size;
+    job.rows = h;
 
-    int32_t y;
     if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_DIRECT) {
         uint32_t color_pos =
             area->x1 * px_size +
             area->y1 * disp->hor_res * px_size;
 
-        for(y = area->y1; y <= area->y2; y++) {
-            write_to_fb(dsc, fb_pos, &color_p[color_pos], w * px_size);
-            fb_pos += dsc->finfo.line_length;
-            color_pos += disp->hor_res * px_size;
+        job.data = &color_p[color_pos];
+        job.src_stride = disp->hor_res * px_size;
+    }
+    else if(job.rotation != LV_DISPLAY_ROTATION_0) {
+        job.data = color_p;
+        job.src_stride = lv_draw_buf_width_to_stride(job.src_w, cf);
+        if(!LV_LINUX_FBDEV_MMAP || job.convert) {
+            /* pwrite and the conversion need the rotated pixels in memory.
+             * The buffer is as large as the draw buffer so it's allocated once*/
+            if(dsc->rotated_buf == NULL) {
+                dsc->rotated_buf_size = dsc->buf_size;
+                dsc->rotated_buf = malloc(dsc->rotated_buf_size);
+                if(dsc->rotated_buf == NULL) {
+                    lv_display_flush_ready(disp);
+                    return;
+                }
+            }
+            lv_draw_sw_rotate(color_p, dsc->rotated_buf, job.src_w, job.src_h, job.src_stride, w * px_size, job.rotation, cf);
+            job.data = dsc->rotated_buf;
+            job.src_stride = w * px_size;
+            job.rotation = LV_DISPLAY_ROTATION_0;
         }
     }
     else {
-        w = lv_area_get_width(area);
-        for(y = area->y1; y <= area->y2; y++) {
-            write_to_fb(dsc, fb_pos, color_p, w * px_size);
-            fb_pos += dsc->finfo.line_length;
-            color_p += w * px_size;
-        }
+        job.data = color_p;
+        job.src_stride = w * px_size;
     }
 
+#if LV_LINUX_FBDEV_ASYNC_FLUSH
+    if(dsc->async_running) {
+        /*Hand the area to the flush thread, it calls `lv_display_flush_ready` when the copy is done*/
+        pthread_mutex_lock(&dsc->async_lock);
+        dsc->async_job = job;
+        dsc->async_pending = true;
+        pthread_cond_broadcast(&dsc->async_cond);
+        pthread_mutex_unlock(&dsc->async_lock);
+        return;
+    }
+#endif
+
+    write_job(dsc, &job);
+
+    lv_display_flush_ready(disp);
+}
+
+/**
+ * Write a flushed area to the framebuffer.
+ * Rotated areas are rotated straight into the mapped framebuffer, without an intermediate buffer.
+ */
+static void write_job(lv_linux_fb_t * dsc, const lv_linux_fb_job_t * job)
+{
+    if(job->convert) {
+        convert_to_fb(dsc, job);
+    }
+#if LV_LINUX_FBDEV_MMAP
+    else if(job->rotation != LV_DISPLAY_ROTATION_0) {
+        uint8_t * fbp = (uint8_t *)dsc->fbp;
+        lv_draw_sw_rotate(job->data, &fbp[job->fb_pos], job->src_w, job->src_h, job->src_stride,
+                          dsc->finfo.line_length, job->rotation, job->cf);
+    }
+#endif
+    else {
+        write_to_fb(dsc, job->fb_pos, job->data, job->row_size, job->src_stride, job->rows);
+    }
+
+    refresh_screen(dsc);
+}
+
+/**
+ * Convert the RGB565 rows of a job to XRGB8888 directly into the framebuffer
+ */
+static void convert_to_fb(lv_linux_fb_t * dsc, const lv_linux_fb_job_t * job)
+{
+    uint32_t px_cnt = job->row_size / sizeof(uint32_t);
+    const uint8_t * data = job->data;
+    int32_t y;
+
+#if LV_LINUX_FBDEV_MMAP
+    uint8_t * fbp = (uint8_t *)dsc->fbp + job->fb_pos;
+    for(y = 0; y < job->rows; y++) {
+        lv_draw_sw_rgb565_to_xrgb8888(data, fbp, px_cnt);
+        fbp += dsc->finfo.line_length;
+        data += job->src_stride;
+    }
+#else
+    uint32_t fb_pos = job->fb_pos;
+    if(dsc->convert_buf == NULL) return;
+    for(y = 0; y < job->rows; y++) {
+        lv_draw_sw_rgb565_to_xrgb8888(data, dsc->convert_buf, px_cnt);
+        write_to_fb(dsc, fb_pos, dsc->convert_buf, job->row_size, job->row_size, 1);
+        fb_pos += dsc->finfo.line_length;
+        data += job->src_stride;
+    }
+#endif
+}
+
+static void refresh_screen(lv_linux_fb_t * dsc)
+{
     if(dsc->force_refresh) {
         dsc->vinfo.activate |= FB_ACTIVATE_NOW | FB_ACTIVATE_FORCE;
         if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &(dsc->vinfo)) == -1) {
             perror("Error setting var screen info");
         }
     }
+}
 
-    lv_display_flush_ready(disp);
+#if LV_LINUX_FBDEV_ASYNC_FLUSH
+
+static void async_flush_start(lv_display_t * disp, lv_linux_fb_t * dsc)
+{
+    pthread_mutex_init(&dsc->async_lock, NULL);
+    pthread_cond_init(&dsc->async_cond, NULL);
+    if(pthread_create(&dsc->async_thread, NULL, async_flush_thread, disp) != 0) {
+        LV_LOG_WARN("Can't create the flush thread, flushing synchronously");
+        pthread_cond_destroy(&dsc->async_cond);
+        pthread_mutex_destroy(&dsc->async_lock);
+        return;
+    }
+    lv_display_set_flush_wait_cb(disp, async_flush_wait_cb);
+    lv_display_add_event_cb(disp, async_flush_delete_cb, LV_EVENT_DELETE, NULL);
+    dsc->async_running = true;
+}
+
+/**
+ * Copy the areas handed over by `flush_cb` to the framebuffer.
+ * Meanwhile LVGL renders the next area into the other draw buffer.
+ */
+static void * async_flush_thread(void * arg)
+{
+    lv_display_t * disp = arg;
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+
+    pthread_mutex_lock(&dsc->async_lock);
+    while(1) {
+        while(!dsc->async_pending && !dsc->async_exit) pthread_cond_wait(&dsc->async_cond, &dsc->async_lock);
+        if(dsc->async_exit) break;
+        pthread_mutex_unlock(&dsc->async_lock);
+
+        write_job(dsc, &dsc->async_job);
+
+        pthread_mutex_lock(&dsc->async_lock);
+        dsc->async_pending = false;
+        lv_display_flush_ready(disp);
+        pthread_cond_broadcast(&dsc->async_cond);
+    }
+    pthread_mutex_unlock(&dsc->async_lock);
+
+    return NULL;
+}
+
+/**
+ * Called by LVGL before it flushes or renders into a buffer that may still be copied
+ */
+static void async_flush_wait_cb(lv_display_t * disp)
+{
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+
+    pthread_mutex_lock(&dsc->async_lock);
+    while(dsc->async_pending) pthread_cond_wait(&dsc->async_cond, &dsc->async_lock);
+    pthread_mutex_unlock(&dsc->async_lock);
+}
+
+/**
+ * Finish the last copy and stop the flush thread when the display is deleted
+ */
+static void async_flush_delete_cb(lv_event_t * e)
+{
+    lv_display_t * disp = lv_event_get_current_target(e);
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    if(!dsc->async_running) return;
+
+    pthread_mutex_lock(&dsc->async_lock);
+    while(dsc->async_pending) pthread_cond_wait(&dsc->async_cond, &dsc->async_lock);
+    dsc->async_exit = true;
+    pthread_cond_broadcast(&dsc->async_cond);
+    pthread_mutex_unlock(&dsc->async_lock);
+
+    pthread_join(dsc->async_thread, NULL);
+    pthread_cond_destroy(&dsc->async_cond);
+    pthread_mutex_destroy(&dsc->async_lock);
+    dsc->async_running = false;
+    lv_display_set_flush_wait_cb(disp, NULL);
+}
+
+#endif /*LV_LINUX_FBDEV_ASYNC_FLUSH*/
+
+/**
+ * Allocate the draw buffers which are copied (and converted or rotated) to the framebuffer in `flush_cb`
+ * @param disp  the display
+ * @param dsc   the framebuffer descriptor with `vinfo` already read
+ */
+static void init_draw_buffers(lv_display_t * disp, lv_linux_fb_t * dsc)
+{
+    int32_t hor_res = dsc->vinfo.xres;
+    int32_t ver_res = dsc->vinfo.yres;
+
+    uint32_t draw_buf_size = hor_res * lv_color_format_get_size(lv_display_get_color_format(disp));
+    if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        draw_buf_size *= LV_LINUX_FBDEV_BUFFER_SIZE;
+    }
+    else {
+        draw_buf_size *= ver_res;
+    }
+
+    uint8_t * draw_buf = NULL;
+    uint8_t * draw_buf_2 = NULL;
+    draw_buf = malloc(draw_buf_size);
+
+    if(LV_LINUX_FBDEV_BUFFER_COUNT == 2) {
+        draw_buf_2 = malloc(draw_buf_size);
+    }
+
+    if(dsc->convert && !LV_LINUX_FBDEV_MMAP) {
+        dsc->convert_buf = malloc(hor_res * sizeof(uint32_t));
+    }
+
+    lv_display_set_buffers(disp, draw_buf, draw_buf_2, draw_buf_size, LV_LINUX_FBDEV_RENDER_MODE);
+    dsc->buf_size = draw_buf_size;
+    tile_init(disp, dsc);
+
+    bool async = false;
+#if LV_LINUX_FBDEV_ASYNC_FLUSH
+    /*Copying in the background is useful only if LVGL can render into the other buffer meanwhile*/
+    if(draw_buf_2) async_flush_start(disp, dsc);
+    async = dsc->async_running;
+#endif
+
+    LV_LOG_USER("Copying %" LV_PRIu32 " byte draw buffers to the framebuffer, %s flush, tiles: %s",
+                draw_buf_size, async ? "async" : "sync",
+                dsc->tile_size == 0 || LV_LINUX_FBDEV_RENDER_MODE != LV_DISPLAY_RENDER_MODE_PARTIAL ? "off" :
+                dsc->tune_cnt ? "auto" : "fixed");
 }
 
 static uint32_t tick_get_cb(void)
@@ -371,4 +725,288 @@ static uint32_t tick_get_cb(void)
     return time_ms;
 }
 
+#if LV_LINUX_FBDEV_PAGE_FLIP
+
+/**
+ * Make the virtual framebuffer twice as high as the screen and check that the driver can pan.
+ * On failure the original screen info is restored.
+ * @param dsc   the framebuffer descriptor with `vinfo` and `finfo` already read
+ * @return      true if page flipping can be used
+ */
+static bool page_flip_setup(lv_linux_fb_t * dsc)
+{
+    struct fb_var_screeninfo vinfo_ori = dsc->vinfo;
+    bool changed = false;
+
+    if(dsc->vinfo.yres_virtual < dsc->vinfo.yres * 2) {
+        dsc->vinfo.yres_virtual = dsc->vinfo.yres * 2;
+        dsc->vinfo.activate = FB_ACTIVATE_NOW;
+        if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &dsc->vinfo) == -1) {
+            LV_LOG_WARN("Can't set yres_virtual to %d, page flipping is disabled", (int)dsc->vinfo.yres_virtual);
+            goto fail;
+        }
+        changed = true;
+
+        if(ioctl(dsc->fbfd, FBIOGET_VSCREENINFO, &dsc->vinfo) == -1 ||
+           ioctl(dsc->fbfd, FBIOGET_FSCREENINFO, &dsc->finfo) == -1) {
+            goto fail;
+        }
+    }
+
+    if(dsc->vinfo.yres_virtual < dsc->vinfo.yres * 2 ||
+       dsc->finfo.smem_len < dsc->finfo.line_length * dsc->vinfo.yres * 2) {
+        LV_LOG_WARN("The framebuffer is too small for two pages, page flipping is disabled");
+        goto fail;
+    }
+
+    /* Panning back to the current page proves nothing on some drivers, so only check for a hard error here.
+     * The real flip is checked in `page_flip_init_buffers` once the memory is mapped*/
+    if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+        LV_LOG_WARN("FBIOPAN_DISPLAY is not supported, page flipping is disabled");
+        goto fail;
+    }
+
+    dsc->frame_period_us = get_frame_period_us(&dsc->vinfo);
+    dsc->vsync_supported = true;
+    LV_LOG_INFO("Page flipping enabled, frame period %" LV_PRIu32 " us", dsc->frame_period_us);
+    return true;
+
+fail:
+    if(changed) {
+        vinfo_ori.activate = FB_ACTIVATE_NOW;
+        if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &vinfo_ori) == -1) {
+            perror("Error restoring var screen info");
+        }
+    }
+    if(ioctl(dsc->fbfd, FBIOGET_VSCREENINFO, &dsc->vinfo) == -1 ||
+       ioctl(dsc->fbfd, FBIOGET_FSCREENINFO, &dsc->finfo) == -1) {
+        perror("Error reading screen info");
+    }
+    return false;
+}
+
+/**
+ * Use the two pages of the mapped framebuffer as draw buffers in direct mode.
+ * The current screen content is copied to the second page which is then shown,
+ * so the first frame is rendered into the hidden page.
+ * @return      false if the flip failed and normal draw buffers are needed
+ */
+static bool page_flip_init_buffers(lv_display_t * disp, lv_linux_fb_t * dsc)
+{
+    uint32_t stride = dsc->finfo.line_length;
+    uint32_t page_size = stride * dsc->vinfo.yres;
+    uint8_t * page_1 = (uint8_t *)dsc->fbp;
+    uint8_t * page_2 = page_1 + page_size;
+    uint8_t * visible = page_1 + (size_t)stride * dsc->vinfo.yoffset;
+
+    if(visible != page_2) lv_memmove(page_2, visible, page_size);
+
+    dsc->vinfo.xoffset = 0;
+    dsc->vinfo.yoffset = dsc->vinfo.yres;
+    if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+        LV_LOG_WARN("Page flip failed, falling back to copying draw buffers");
+        dsc->vinfo.yoffset = 0;
+        return false;
+    }
+
+    lv_display_set_buffers_with_stride(disp, page_1, page_2, page_size, stride, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_add_event_cb(disp, page_flip_refr_start_cb, LV_EVENT_REFR_START, dsc);
+    lv_display_add_event_cb(disp, page_flip_resolution_changed_cb, LV_EVENT_RESOLUTION_CHANGED, dsc);
+    return true;
+}
+
+/**
+ * The pages are rendered in place so they can't be rotated.
+ * If the display gets rotated, show the first page and use draw buffers from now on.
+ */
+static void page_flip_resolution_changed_cb(lv_event_t * e)
+{
+    lv_display_t * disp = lv_event_get_current_target(e);
+    lv_linux_fb_t * dsc = lv_event_get_user_data(e);
+    if(!dsc->page_flip || lv_display_get_rotation(disp) == LV_DISPLAY_ROTATION_0) return;
+
+    LV_LOG_WARN("Page flipping can't rotate, falling back to copying draw buffers");
+    lv_display_remove_event_cb_with_user_data(disp, page_flip_refr_start_cb, dsc);
+    dsc->page_flip = false;
+    dsc->pan_pending = false;
+
+    if(dsc->vinfo.yoffset != 0) {
+        uint32_t page_size = dsc->finfo.line_length * dsc->vinfo.yres;
+        lv_memcpy(dsc->fbp, (uint8_t *)dsc->fbp + page_size, page_size);
+        dsc->vinfo.xoffset = 0;
+        dsc->vinfo.yoffset = 0;
+        if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+            perror("ioctl(FBIOPAN_DISPLAY)");
+        }
+    }
+
+    init_draw_buffers(disp, dsc);
+}
+
+/**
+ * Before rendering into the old front page make sure it's not scanned out anymore.
+ * Waiting is needed only if the last flip happened less than a frame period ago
+ * and no vblank was reported since then.
+ */
+static void page_flip_refr_start_cb(lv_event_t * e)
+{
+    lv_linux_fb_t * dsc = lv_event_get_user_data(e);
+    if(!dsc->pan_pending) return;
+    dsc->pan_pending = false;
+
+    if(!dsc->vsync_supported) return;
+    /*A vblank after the flip means the new page is already scanned out*/
+    if(dsc->vblank_time_us > dsc->pan_time_us) return;
+    if(time_us() - dsc->pan_time_us >= dsc->frame_period_us) return;
+
+    uint32_t crtc = 0;
+    if(ioctl(dsc->fbfd, FBIO_WAITFORVSYNC, &crtc) == -1) {
+        LV_LOG_INFO("FBIO_WAITFORVSYNC is not supported");
+        dsc->vsync_supported = false;
+    }
+}
+
+/**
+ * Calculate the refresh period from the video timings
+ * @param vinfo     the variable screen info
+ * @return          the frame period in microseconds (60 Hz if the timings are unknown)
+ */
+static uint32_t get_frame_period_us(const struct fb_var_screeninfo * vinfo)
+{
+    uint64_t htotal = (uint64_t)vinfo->xres + vinfo->left_margin + vinfo->right_margin + vinfo->hsync_len;
+    uint64_t vtotal = (uint64_t)vinfo->yres + vinfo->upper_margin + vinfo->lower_margin + vinfo->vsync_len;
+    if(vinfo->pixclock == 0) return 16667;
+
+    /*pixclock is in picoseconds*/
+    uint64_t period_us = (uint64_t)vinfo->pixclock * htotal * vtotal / 1000000;
+    if(period_us < 1000 || period_us > 100000) return 16667;
+    return (uint32_t)period_us;
+}
+
+#endif /*LV_LINUX_FBDEV_PAGE_FLIP*/
+
+/**
+ * Start rendering in tiles of `dsc->tile_size` bytes. The draw buffers keep their allocated size,
+ * only the size LVGL sees is reduced, so LVGL splits the areas to fewer rows.
+ * With auto tuning the candidate sizes are used in turn, one per frame, until each rendered enough pixels.
+ */
+static void tile_init(lv_display_t * disp, lv_linux_fb_t * dsc)
+{
+    if(dsc->tile_size == 0 || LV_LINUX_FBDEV_RENDER_MODE != LV_DISPLAY_RENDER_MODE_PARTIAL) return;
+
+    uint32_t stride = lv_draw_buf_width_to_stride(lv_display_get_horizontal_resolution(disp),
+                                                  lv_display_get_color_format(disp));
+    int32_t buf_rows = dsc->buf_size / stride;
+    int32_t rows = LV_CLAMP(1, (int32_t)(dsc->tile_size / stride), buf_rows);
+    if(!dsc->tile_auto) {
+        tile_set_rows(disp, dsc, rows);
+        return;
+    }
+
+    static const uint8_t mul[TILE_TUNE_MAX - 1] = {1, 2, 4, 8, 16};   /*In quarters of the tile size*/
+    uint32_t i;
+    dsc->tune_cnt = 0;
+    for(i = 0; i < TILE_TUNE_MAX; i++) {
+        int32_t r = buf_rows;
+        if(i < TILE_TUNE_MAX - 1) r = LV_CLAMP(1, (int32_t)((uint64_t)dsc->tile_size * mul[i] / 4 / stride), buf_rows);
+        if(dsc->tune_cnt > 0 && dsc->tune_rows[dsc->tune_cnt - 1] == r) continue;
+        dsc->tune_rows[dsc->tune_cnt] = r;
+        dsc->tune_us[dsc->tune_cnt] = 0;
+        dsc->tune_px[dsc->tune_cnt] = 0;
+        dsc->tune_cnt++;
+    }
+
+    if(dsc->tune_cnt < 2) {
+        dsc->tune_cnt = 0;
+        tile_set_rows(disp, dsc, rows);
+        return;
+    }
+
+    dsc->tune_act = 0;
+    dsc->tune_frames = 0;
+    tile_set_rows(disp, dsc, dsc->tune_rows[0]);
+    lv_display_add_event_cb(disp, tile_tune_event_cb, LV_EVENT_RENDER_START, dsc);
+    lv_display_add_event_cb(disp, tile_tune_event_cb, LV_EVENT_RENDER_READY, dsc);
+}
+
+/**
+ * Let LVGL render at most `rows` full width rows at once. Called only between frames.
+ */
+static void tile_set_rows(lv_display_t * disp, lv_linux_fb_t * dsc, int32_t rows)
+{
+    uint32_t stride = lv_draw_buf_width_to_stride(lv_display_get_horizontal_resolution(disp),
+                                                  lv_display_get_color_format(disp));
+    uint32_t size = LV_MIN((uint32_t)rows * stride, dsc->buf_size);
+    disp->buf_1->data_size = size;
+    if(disp->buf_2) disp->buf_2->data_size = size;
+    dsc->tile_rows = rows;
+}
+
+/**
+ * Measure the render time of the frames with the current candidate tile size and switch to the next one.
+ * The time includes flushing, so tiles too small to amortize the per-flush overhead lose too.
+ */
+static void tile_tune_event_cb(lv_event_t * e)
+{
+    lv_display_t * disp = lv_event_get_current_target(e);
+    lv_linux_fb_t * dsc = lv_event_get_user_data(e);
+
+    if(lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        dsc->render_start_us = time_us();
+        dsc->frame_px = 0;
+        return;
+    }
+
+    /*Frames fitting into the smallest tile are rendered the same way with any tile size*/
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    if(dsc->frame_px > (uint32_t)(dsc->tune_rows[0] * hor_res)) {
+        dsc->tune_us[dsc->tune_act] += time_us() - dsc->render_start_us;
+        dsc->tune_px[dsc->tune_act] += dsc->frame_px;
+    }
+    dsc->tune_frames++;
+
+    uint64_t px_min = (uint64_t)hor_res * lv_display_get_vertical_resolution(disp) * TILE_TUNE_SCREENS;
+    uint32_t i;
+    uint32_t best = 0;
+    bool done = true;
+    for(i = 0; i < dsc->tune_cnt; i++) {
+        if(dsc->tune_px[i] < px_min) done = false;
+        /*Compare the time per pixel*/
+        if(dsc->tune_px[i] == 0) continue;
+        if(dsc->tune_px[best] == 0 || dsc->tune_us[i] * dsc->tune_px[best] < dsc->tune_us[best] * dsc->tune_px[i]) {
+            best = i;
+        }
+    }
+
+    if(!done && dsc->tune_frames < TILE_TUNE_FRAMES_MAX) {
+        dsc->tune_act = (dsc->tune_act + 1) % dsc->tune_cnt;
+        tile_set_rows(disp, dsc, dsc->tune_rows[dsc->tune_act]);
+        return;
+    }
+
+    /*Without large redraws keep the requested size*/
+    int32_t rows = dsc->tune_rows[best];
+    if(dsc->tune_px[best] == 0) {
+        uint32_t stride = lv_draw_buf_width_to_stride(hor_res, lv_display_get_color_format(disp));
+        rows = LV_CLAMP(1, (int32_t)(dsc->tile_size / stride), dsc->tune_rows[dsc->tune_cnt - 1]);
+    }
+
+    for(i = 0; i < dsc->tune_cnt; i++) {
+        LV_LOG_INFO("%" LV_PRId32 " rows: %" LV_PRIu32 " ns/px", dsc->tune_rows[i],
+                    dsc->tune_px[i] ? (uint32_t)(dsc->tune_us[i] * 1000 / dsc->tune_px[i]) : 0);
+    }
+    LV_LOG_INFO("Rendering %" LV_PRId32 " rows at once", rows);
+
+    dsc->tune_cnt = 0;
+    tile_set_rows(disp, dsc, rows);
+    lv_display_remove_event_cb_with_user_data(disp, tile_tune_event_cb, dsc);
+}
+
+static uint64_t time_us(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+}
+
 #endif /*LV_USE_LINUX_FBDEV*/
@@ -33,12 +33,48 @@ lv_display_t * lv_linux_fbdev_create(void);
 
 void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file);
 
+/**
+ * Select the color format to render in. Has to be called before `lv_linux_fbdev_set_file()`.
+ * `LV_COLOR_FORMAT_RGB565` on a 32 bpp framebuffer renders in RGB565 and converts the areas
+ * to XRGB8888 while writing them to the framebuffer (page flipping is not used then).
+ * @param disp      pointer to a display created by `lv_linux_fbdev_create()`
+ * @param cf        LV_COLOR_FORMAT_RGB565, or LV_COLOR_FORMAT_UNKNOWN to render in the framebuffer's format (default)
+ */
+void lv_linux_fbdev_set_render_format(lv_display_t * disp, lv_color_format_t cf);
+
 /**
  * Force the display to be refreshed on every change.
  * Expected to be used with LV_DISPLAY_RENDER_MODE_DIRECT or LV_DISPLAY_RENDER_MODE_FULL.
  */
 void lv_linux_fbdev_set_force_refresh(lv_display_t * disp, bool enabled);
 
+/**
+ * Report when the last vertical blank happened, e.g. from a thread waiting with FBIO_WAITFORVSYNC.
+ * With `LV_LINUX_FBDEV_PAGE_FLIP` it lets the driver skip waiting for vsync before rendering
+ * into the previous front page if a vblank already happened since the last flip.
+ * @param disp      pointer to a display created by `lv_linux_fbdev_create()`
+ * @param time_us   time of the vblank in microseconds on CLOCK_MONOTONIC
+ */
+void lv_linux_fbdev_set_vblank_time(lv_display_t * disp, uint64_t time_us);
+
+/**
+ * Render the invalidated areas in tiles of about `size` bytes instead of filling the whole partial buffer.
+ * Full width areas are rendered in strips of rows, narrower areas in taller tiles of the same size.
+ * Has to be called before `lv_linux_fbdev_set_file()`. Used only in PARTIAL mode without page flipping.
+ * @param disp          pointer to a display created by `lv_linux_fbdev_create()`
+ * @param size          tile size in bytes, 0 to render as much as the buffer holds
+ * @param auto_tune     true: measure the render time of a few sizes around `size` and the whole buffer,
+ *                      then keep the fastest one
+ */
+void lv_linux_fbdev_set_tile_size(lv_display_t * disp, uint32_t size, bool auto_tune);
+
+/**
+ * Get the number of full width rows rendered at once.
+ * @param disp      pointer to a display created by `lv_linux_fbdev_create()`
+ * @return          rows per tile, 0 while the tile size is being tuned
+ */
+int32_t lv_linux_fbdev_get_tile_rows(lv_display_t * disp);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,120 @@
+/**
+ * @file lv_linux_fbdev_copy.h
+ *
+ * Copy of rendered rows into the mapped framebuffer.
+ * It depends only on the C library so tools/fb_copy_bench.c measures the same code as the driver.
+ */
+
+#ifndef LV_LINUX_FBDEV_COPY_H
+#define LV_LINUX_FBDEV_COPY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Streaming (non-temporal) stores for rows at least this long*/
+#if defined(__aarch64__)
+    #define LV_LINUX_FBDEV_STREAM_COPY      1
+    #define LV_LINUX_FBDEV_STREAM_COPY_MIN  256
+#else
+    #define LV_LINUX_FBDEV_STREAM_COPY      0
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_LINUX_FBDEV_STREAM_COPY
+/**
+ * Copy with non-temporal stores (STNP). The framebuffer is usually mapped uncached or write-combined,
+ * so streaming stores fill whole write buffers and don't evict useful lines from the cache.
+ * @param dst       destination in the framebuffer
+ * @param src       source
+ * @param sz        number of bytes to copy
+ */
+static inline void lv_linux_fbdev_copy_stream(uint8_t * dst, const uint8_t * src, size_t sz)
+{
+    /*Align the destination to 16 bytes*/
+    size_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+    if(head > sz) head = sz;
+    if(head) {
+        memcpy(dst, src, head);
+        dst += head;
+        src += head;
+        sz -= head;
+    }
+
+    size_t blocks = sz / 64;
+    if(blocks) {
+        __asm__ volatile(
+            "1:                             \n"
+            "ldp    q0, q1, [%[s]], #32     \n"
+            "ldp    q2, q3, [%[s]], #32     \n"
+            "stnp   q0, q1, [%[d]]          \n"
+            "stnp   q2, q3, [%[d], #32]     \n"
+            "add    %[d], %[d], #64         \n"
+            "subs   %[n], %[n], #1          \n"
+            "b.ne   1b                      \n"
+            : [d] "+r"(dst), [s] "+r"(src), [n] "+r"(blocks)
+            :
+            : "v0", "v1", "v2", "v3", "cc", "memory");
+    }
+
+    sz &= 63;
+    if(sz) memcpy(dst, src, sz);
+}
+#endif /*LV_LINUX_FBDEV_STREAM_COPY*/
+
+/**
+ * Copy `rows` rows of `row_size` bytes into the mapped framebuffer.
+ * If both the source and the framebuffer rows are contiguous (full width without padding)
+ * the rows are merged into a single copy.
+ * @param dst           first byte of the area in the framebuffer
+ * @param dst_stride    framebuffer line length in bytes
+ * @param src           first byte of the rendered area
+ * @param src_stride    stride of the rendered area in bytes
+ * @param row_size      bytes to copy from each row
+ * @param rows          number of rows
+ */
+static inline void lv_linux_fbdev_copy_rows(uint8_t * dst, size_t dst_stride, const uint8_t * src, size_t src_stride,
+                                            size_t row_size, int32_t rows)
+{
+    if(src_stride == row_size && dst_stride == row_size) {
+        row_size *= rows;
+        rows = 1;
+    }
+
+    for(; rows > 0; rows--) {
+#if LV_LINUX_FBDEV_STREAM_COPY
+        if(row_size >= LV_LINUX_FBDEV_STREAM_COPY_MIN) lv_linux_fbdev_copy_stream(dst, src, row_size);
+        else memcpy(dst, src, row_size);
+#else
+        memcpy(dst, src, row_size);
+#endif
+        dst += dst_stride;
+        src += src_stride;
+    }
+
+#if LV_LINUX_FBDEV_STREAM_COPY
+    /*Non-temporal stores are weakly ordered, complete them before the flush is reported ready*/
+    __asm__ volatile("dmb ishst" ::: "memory");
+#endif
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_LINUX_FBDEV_COPY_H*/
@@ -212,8 +212,10 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
 
     if(entry == NULL) {
+        /*E.g. the rest of the cache is pinned. Use the image uncached and free it on close.*/
+        dsc->args.no_cache = true;
         LV_PROFILER_DECODER_END_TAG("lv_lodepng_decoder_open");
-        return LV_RESULT_INVALID;
+        return LV_RESULT_OK;
     }
     dsc->cache_entry = entry;
 
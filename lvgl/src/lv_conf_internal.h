@@ -253,6 +253,29 @@
     #endif
 #endif
 
+/** Invalidated areas are joined if it adds at most this many percent of redrawn pixels
+ * over the pixels actually invalidated by the two areas.
+ * When more areas are invalidated than the area buffer can hold, the two areas adding
+ * the least overdraw are joined instead of redrawing the whole screen. */
+#ifndef LV_REFR_JOIN_OVERDRAW
+    #ifdef CONFIG_LV_REFR_JOIN_OVERDRAW
+        #define LV_REFR_JOIN_OVERDRAW CONFIG_LV_REFR_JOIN_OVERDRAW
+    #else
+        #define LV_REFR_JOIN_OVERDRAW 25    /**< [%] */
+    #endif
+#endif
+
+/** Before drawing an area, collect at most this many opaque widgets covering parts of it, front to back.
+ * Widgets fully hidden behind them are not drawn, and the drawing of partially hidden ones
+ * is clipped to the uncovered part where it remains a rectangle. Set it to 0 to disable. */
+#ifndef LV_REFR_OCCLUDER_MAX
+    #ifdef CONFIG_LV_REFR_OCCLUDER_MAX
+        #define LV_REFR_OCCLUDER_MAX CONFIG_LV_REFR_OCCLUDER_MAX
+    #else
+        #define LV_REFR_OCCLUDER_MAX 16
+    #endif
+#endif
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -366,6 +389,28 @@
     #endif
 #endif
 
+/** Index the draw tasks of a layer on a grid once checking the dependencies of a draw task
+ * had to look at more than this many older tasks. It keeps dispatching fast on complex screens
+ * with hundreds of draw tasks. Set it to 0 to always check all the older tasks. */
+#ifndef LV_DRAW_TASK_GRID_THRESHOLD
+    #ifdef CONFIG_LV_DRAW_TASK_GRID_THRESHOLD
+        #define LV_DRAW_TASK_GRID_THRESHOLD CONFIG_LV_DRAW_TASK_GRID_THRESHOLD
+    #else
+        #define LV_DRAW_TASK_GRID_THRESHOLD 32
+    #endif
+#endif
+
+/** Keep up to this many finished draw tasks to reuse them for the next draw tasks
+ * instead of allocating and freeing every draw task and its descriptor on the heap.
+ * Set it to 0 to allocate each draw task separately. */
+#ifndef LV_DRAW_TASK_POOL_CNT
+    #ifdef CONFIG_LV_DRAW_TASK_POOL_CNT
+        #define LV_DRAW_TASK_POOL_CNT CONFIG_LV_DRAW_TASK_POOL_CNT
+    #else
+        #define LV_DRAW_TASK_POOL_CNT 0
+    #endif
+#endif
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -557,6 +602,28 @@
         #endif
     #endif
 
+    /** Split large draw tasks into horizontal bands rendered in parallel by this many threads:
+     *  the render thread of the draw unit and LV_DRAW_SW_BAND_THREAD_CNT - 1 helper threads.
+     *  Unlike more draw units it helps also when a single task (e.g. a full screen fill or image) dominates.
+     *  - 1: disabled
+     *  - > 1 requires operating system to be enabled in `LV_USE_OS`. */
+    #ifndef LV_DRAW_SW_BAND_THREAD_CNT
+        #ifdef CONFIG_LV_DRAW_SW_BAND_THREAD_CNT
+            #define LV_DRAW_SW_BAND_THREAD_CNT CONFIG_LV_DRAW_SW_BAND_THREAD_CNT
+        #else
+            #define LV_DRAW_SW_BAND_THREAD_CNT  1
+        #endif
+    #endif
+
+    /** Only draw tasks covering at least this many pixels (after clipping) are split into bands. */
+    #ifndef LV_DRAW_SW_BAND_MIN_PX
+        #ifdef CONFIG_LV_DRAW_SW_BAND_MIN_PX
+            #define LV_DRAW_SW_BAND_MIN_PX CONFIG_LV_DRAW_SW_BAND_MIN_PX
+        #else
+            #define LV_DRAW_SW_BAND_MIN_PX      (64 * 1024)
+        #endif
+    #endif
+
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #ifndef LV_USE_DRAW_ARM2D_SYNC
         #ifdef CONFIG_LV_USE_DRAW_ARM2D_SYNC
@@ -593,7 +660,10 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /** Allow buffering some shadow calculation.
          *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
+         *  `shadow_width + radius`.  A buffered corner has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost
+         *  at most.  The most recently used corners are kept for each rectangle size, radius and
+         *  shadow width until they fit into LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE bytes.
+         *  - 0: disables caching */
         #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -601,6 +671,13 @@
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
             #endif
         #endif
+        #ifndef LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+                #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+            #else
+                #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE (64 * 1024)
+            #endif
+        #endif
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
@@ -642,6 +719,17 @@
         #endif
     #endif
 
+    /** Size of the cache of gradient color ramps in bytes. The widgets with the same gradient stops
+     *  share the ramps instead of interpolating the colors again on every redraw.
+     *  - 0: disables caching */
+    #ifndef LV_DRAW_SW_GRADIENT_CACHE_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_GRADIENT_CACHE_SIZE
+            #define LV_DRAW_SW_GRADIENT_CACHE_SIZE CONFIG_LV_DRAW_SW_GRADIENT_CACHE_SIZE
+        #else
+            #define LV_DRAW_SW_GRADIENT_CACHE_SIZE      (32 * 1024)
+        #endif
+    #endif
+
 #endif
 
 /*Use TSi's aka (Think Silicon) NemaGFX */
@@ -1322,6 +1410,28 @@
     #endif
 #endif
 
+/** Decode large images on this many worker threads instead of the LVGL thread.
+ *  Until an image is decoded into the image cache its widget draws a placeholder
+ *  and it's invalidated when the image is ready.
+ *  - 0: disabled
+ *  - > 0 requires operating system to be enabled in `LV_USE_OS` and `LV_CACHE_DEF_SIZE` > 0. */
+#ifndef LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+        #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    #else
+        #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 0
+    #endif
+#endif
+
+/** Only images having at least this many pixels are decoded asynchronously. */
+#ifndef LV_IMAGE_DECODER_ASYNC_MIN_PX
+    #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_MIN_PX
+        #define LV_IMAGE_DECODER_ASYNC_MIN_PX CONFIG_LV_IMAGE_DECODER_ASYNC_MIN_PX
+    #else
+        #define LV_IMAGE_DECODER_ASYNC_MIN_PX (128 * 128)
+    #endif
+#endif
+
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1355,6 +1465,26 @@
     #endif
 #endif
 
+/** 1: Enable `LV_OBJ_FLAG_RENDER_CACHE` to keep static widget subtrees rendered in a draw buffer
+ *  and blit it on later redraws instead of drawing the widgets again. */
+#ifndef LV_USE_OBJ_RENDER_CACHE
+    #ifdef CONFIG_LV_USE_OBJ_RENDER_CACHE
+        #define LV_USE_OBJ_RENDER_CACHE CONFIG_LV_USE_OBJ_RENDER_CACHE
+    #else
+        #define LV_USE_OBJ_RENDER_CACHE 0
+    #endif
+#endif
+#if LV_USE_OBJ_RENDER_CACHE
+    /** Memory limit of all render caches in bytes. The least recently used caches are freed to stay below it. */
+    #ifndef LV_OBJ_RENDER_CACHE_SIZE
+        #ifdef CONFIG_LV_OBJ_RENDER_CACHE_SIZE
+            #define LV_OBJ_RENDER_CACHE_SIZE CONFIG_LV_OBJ_RENDER_CACHE_SIZE
+        #else
+            #define LV_OBJ_RENDER_CACHE_SIZE    (8 * 1024 * 1024)
+        #endif
+    #endif
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -3915,6 +4045,42 @@
             #define LV_LINUX_FBDEV_MMAP          1
         #endif
     #endif
+    /** Render directly into a double-height framebuffer (`yres_virtual = 2*yres`) and flip with `FBIOPAN_DISPLAY`.
+     *  Falls back to the buffers above if the driver can't pan. Requires `LV_LINUX_FBDEV_MMAP`*/
+    #ifndef LV_LINUX_FBDEV_PAGE_FLIP
+        #ifdef CONFIG_LV_LINUX_FBDEV_PAGE_FLIP
+            #define LV_LINUX_FBDEV_PAGE_FLIP CONFIG_LV_LINUX_FBDEV_PAGE_FLIP
+        #else
+            #define LV_LINUX_FBDEV_PAGE_FLIP     0
+        #endif
+    #endif
+    /** Copy the draw buffer to the framebuffer in a separate thread so LVGL can render into the other buffer meanwhile.
+     *  Used only with `LV_LINUX_FBDEV_BUFFER_COUNT 2` (and not with page flipping). */
+    #ifndef LV_LINUX_FBDEV_ASYNC_FLUSH
+        #ifdef CONFIG_LV_LINUX_FBDEV_ASYNC_FLUSH
+            #define LV_LINUX_FBDEV_ASYNC_FLUSH CONFIG_LV_LINUX_FBDEV_ASYNC_FLUSH
+        #else
+            #define LV_LINUX_FBDEV_ASYNC_FLUSH   0
+        #endif
+    #endif
+    /** Split the partial buffer into tiles of about this many bytes (e.g. 1920x34 rows or 256x256 px at 16 bpp)
+     *  so a tile stays in the L2 cache while it's blended. 0: render as much as the buffer holds. PARTIAL mode only. */
+    #ifndef LV_LINUX_FBDEV_TILE_SIZE
+        #ifdef CONFIG_LV_LINUX_FBDEV_TILE_SIZE
+            #define LV_LINUX_FBDEV_TILE_SIZE CONFIG_LV_LINUX_FBDEV_TILE_SIZE
+        #else
+            #define LV_LINUX_FBDEV_TILE_SIZE     0
+        #endif
+    #endif
+    /** Measure the render time of a few tile sizes around `LV_LINUX_FBDEV_TILE_SIZE` and the whole buffer
+     *  on the first frames, then keep the fastest one. */
+    #ifndef LV_LINUX_FBDEV_TILE_AUTO
+        #ifdef CONFIG_LV_LINUX_FBDEV_TILE_AUTO
+            #define LV_LINUX_FBDEV_TILE_AUTO CONFIG_LV_LINUX_FBDEV_TILE_AUTO
+        #else
+            #define LV_LINUX_FBDEV_TILE_AUTO     0
+        #endif
+    #endif
 #endif
 
 /** Use Nuttx to open window and handle touchscreen */
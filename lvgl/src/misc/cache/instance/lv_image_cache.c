@@ -21,6 +21,7 @@
 #define CACHE_NAME  "IMAGE"
 
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+#define img_cache_pinned_ll_p &(LV_GLOBAL_DEFAULT()->img_cache_pinned_ll)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
 /**********************
@@ -35,6 +36,7 @@ static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
 static void iter_inspect_cb(void * elem);
+static void unpin(const void * src, bool all);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -58,6 +60,8 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
+    lv_ll_init(img_cache_pinned_ll_p, sizeof(lv_cache_entry_t *));
+
     img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
     sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
@@ -82,6 +86,9 @@ void lv_image_cache_drop(const void * src)
     /*If user invalidate image, the header cache should be invalidated too.*/
     lv_image_header_cache_drop(src);
 
+    /*A pinned image couldn't be freed, so drop its pins too*/
+    unpin(src, true);
+
     if(src == NULL) {
         lv_cache_drop_all(img_cache_p, NULL);
         return;
@@ -95,6 +102,51 @@ void lv_image_cache_drop(const void * src)
     lv_cache_drop(img_cache_p, &search_key, NULL);
 }
 
+lv_result_t lv_image_cache_prefetch(const void * src)
+{
+    lv_image_decoder_dsc_t decoder_dsc;
+    lv_result_t res = lv_image_decoder_open(&decoder_dsc, src, NULL);
+    if(res != LV_RESULT_OK) return res;
+
+    lv_image_decoder_close(&decoder_dsc);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_image_cache_pin(const void * src)
+{
+    lv_image_decoder_dsc_t decoder_dsc;
+    lv_result_t res = lv_image_decoder_open(&decoder_dsc, src, NULL);
+    if(res != LV_RESULT_OK) return res;
+
+    /*Keep the reference taken by the decoder. Referenced entries are never evicted.*/
+    lv_cache_entry_t * entry = decoder_dsc.cache_entry;
+    decoder_dsc.cache_entry = NULL;
+    lv_image_decoder_close(&decoder_dsc);
+
+    /*The decoded image is not in the cache, e.g. it's too large or the decoder uses `src` directly*/
+    if(entry == NULL) return LV_RESULT_INVALID;
+
+    lv_cache_entry_t ** pinned = lv_ll_ins_tail(img_cache_pinned_ll_p);
+    LV_ASSERT_MALLOC(pinned);
+    if(pinned == NULL) {
+        lv_cache_release(img_cache_p, entry, NULL);
+        return LV_RESULT_INVALID;
+    }
+
+    *pinned = entry;
+    return LV_RESULT_OK;
+}
+
+void lv_image_cache_unpin(const void * src)
+{
+    unpin(src, src == NULL);
+}
+
+void lv_image_cache_get_stats(uint32_t * hit_cnt, uint32_t * miss_cnt, uint32_t * evict_cnt)
+{
+    lv_cache_get_stats(img_cache_p, hit_cnt, miss_cnt, evict_cnt);
+}
+
 bool lv_image_cache_is_enabled(void)
 {
     return lv_cache_is_enabled(img_cache_p);
@@ -160,6 +212,25 @@ static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
     if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
 }
 
+static void unpin(const void * src, bool all)
+{
+    lv_image_src_t src_type = src ? lv_image_src_get_type(src) : LV_IMAGE_SRC_UNKNOWN;
+
+    lv_cache_entry_t ** pinned = lv_ll_get_head(img_cache_pinned_ll_p);
+    while(pinned) {
+        lv_cache_entry_t ** next = lv_ll_get_next(img_cache_pinned_ll_p, pinned);
+        lv_image_cache_data_t * data = lv_cache_entry_get_data(*pinned);
+        if(src == NULL || image_cache_common_compare(data->src, data->src_type, src, src_type) == 0) {
+            lv_cache_release(img_cache_p, *pinned, NULL);
+            lv_ll_remove(img_cache_pinned_ll_p, pinned);
+            lv_free(pinned);
+
+            if(!all) return;
+        }
+        pinned = next;
+    }
+}
+
 static void iter_inspect_cb(void * elem)
 {
     lv_image_cache_data_t * data = (lv_image_cache_data_t *)elem;
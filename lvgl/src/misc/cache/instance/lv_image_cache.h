@@ -45,10 +45,42 @@ void lv_image_cache_resize(uint32_t new_size, bool evict_now);
 
 /**
  * Invalidate image cache. Use NULL to invalidate all images.
+ * The pins of the invalidated images are dropped too.
  * @param src pointer to an image source.
  */
 void lv_image_cache_drop(const void * src);
 
+/**
+ * Decode an image into the cache if it's not there yet,
+ * so drawing it later doesn't need to wait for the decoder.
+ * @param src       pointer to an image source.
+ * @return          LV_RESULT_OK: the image could be opened, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_image_cache_prefetch(const void * src);
+
+/**
+ * Decode an image into the cache and keep it there until it's unpinned.
+ * Pinned images are not evicted but still count in the size of the cache.
+ * An image can be pinned more times, each pin needs its own unpin.
+ * @param src       pointer to an image source.
+ * @return          LV_RESULT_OK: the image is pinned, LV_RESULT_INVALID: failed or the decoded image is not cached.
+ */
+lv_result_t lv_image_cache_pin(const void * src);
+
+/**
+ * Unpin images pinned by `lv_image_cache_pin()`. They can be evicted again.
+ * @param src       pointer to an image source. NULL to unpin all images.
+ */
+void lv_image_cache_unpin(const void * src);
+
+/**
+ * Get the counters of the image cache.
+ * @param hit_cnt   store the number of images found in the cache here (can be NULL)
+ * @param miss_cnt  store the number of images which had to be decoded into the cache here (can be NULL)
+ * @param evict_cnt store the number of images evicted to make room for new ones here (can be NULL)
+ */
+void lv_image_cache_get_stats(uint32_t * hit_cnt, uint32_t * miss_cnt, uint32_t * evict_cnt);
+
 /**
  * Return true if the image cache is enabled.
  * @return true: enabled, false: disabled.
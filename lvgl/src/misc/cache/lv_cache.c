@@ -55,6 +55,9 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+    cache->evict_cnt = 0;
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -97,6 +100,7 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->hit_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -128,6 +132,8 @@ lv_cache_entry_t * lv_cache_add(lv_cache_t * cache, const void * key, void * use
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
+    cache->miss_cnt++;
+
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -158,6 +164,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            cache->hit_cnt++;
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_CACHE_END;
@@ -165,6 +172,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         }
     }
 
+    cache->miss_cnt++;
+
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -203,7 +212,8 @@ void lv_cache_reserve(lv_cache_t * cache, uint32_t reserved_size, void * user_da
     for(lv_cache_reserve_cond_res_t reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data);
         reserve_cond_res == LV_CACHE_RESERVE_COND_NEED_VICTIM;
         reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data))
-        cache_evict_one_internal_no_lock(cache, user_data);
+        /*The rest of the entries are referenced*/
+        if(cache_evict_one_internal_no_lock(cache, user_data) == false) break;
 
     LV_PROFILER_CACHE_END;
 }
@@ -295,6 +305,17 @@ const char * lv_cache_get_name(lv_cache_t * cache)
     return cache->name;
 }
 
+void lv_cache_get_stats(lv_cache_t * cache, uint32_t * hit_cnt, uint32_t * miss_cnt, uint32_t * evict_cnt)
+{
+    LV_ASSERT_NULL(cache);
+
+    lv_mutex_lock(&cache->lock);
+    if(hit_cnt) *hit_cnt = cache->hit_cnt;
+    if(miss_cnt) *miss_cnt = cache->miss_cnt;
+    if(evict_cnt) *evict_cnt = cache->evict_cnt;
+    lv_mutex_unlock(&cache->lock);
+}
+
 lv_iter_t * lv_cache_iter_create(lv_cache_t * cache)
 {
     LV_ASSERT_NULL(cache);
@@ -336,6 +357,7 @@ static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_dat
     cache->clz->remove_cb(cache, victim, user_data);
     cache->ops.free_cb(lv_cache_entry_get_data(victim), user_data);
     lv_cache_entry_delete(victim);
+    cache->evict_cnt++;
     return true;
 }
 
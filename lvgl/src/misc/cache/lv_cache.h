@@ -215,6 +215,15 @@ void lv_cache_set_name(lv_cache_t * cache, const char * name);
  */
 const char * lv_cache_get_name(lv_cache_t * cache);
 
+/**
+ * Get the counters of the cache since it was created.
+ * @param cache         The cache object pointer to get the counters from.
+ * @param hit_cnt       Store the number of lookups which found the data here. Can be `NULL`.
+ * @param miss_cnt      Store the number of times the data was not cached and had to be added here. Can be `NULL`.
+ * @param evict_cnt     Store the number of entries evicted to make room for new ones here. Can be `NULL`.
+ */
+void lv_cache_get_stats(lv_cache_t * cache, uint32_t * hit_cnt, uint32_t * miss_cnt, uint32_t * evict_cnt);
+
 /**
  * Create an iterator for the cache object. The iterator is used to iterate over all cache entries.
  * @param cache         The cache object pointer to create the iterator.
@@ -138,6 +138,10 @@ struct _lv_cache_t {
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< Name of the cache */
+
+    uint32_t hit_cnt;                 /**< Number of lookups which found the data */
+    uint32_t miss_cnt;                /**< Number of times the data was not cached and had to be added */
+    uint32_t evict_cnt;               /**< Number of entries evicted to make room for new ones */
 };
 
 /**
@@ -120,6 +120,7 @@ typedef struct _lv_display_t lv_display_t;
 typedef struct _lv_layer_t lv_layer_t;
 typedef struct _lv_draw_unit_t lv_draw_unit_t;
 typedef struct _lv_draw_task_t lv_draw_task_t;
+typedef struct _lv_draw_task_grid_t lv_draw_task_grid_t;
 
 typedef struct _lv_indev_t lv_indev_t;
 
@@ -191,6 +192,8 @@ typedef struct _lv_cover_check_info_t lv_cover_check_info_t;
 
 typedef struct _lv_obj_spec_attr_t lv_obj_spec_attr_t;
 
+typedef struct _lv_obj_render_cache_t lv_obj_render_cache_t;
+
 typedef struct _lv_image_t lv_image_t;
 
 typedef struct _lv_animimg_t lv_animimg_t;
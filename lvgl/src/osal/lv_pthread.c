@@ -6,11 +6,16 @@
 /*********************
  *      INCLUDES
  *********************/
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE /*For pthread_setname_np()*/
+#endif
+
 #include "lv_os.h"
 
 #if LV_USE_OS == LV_OS_PTHREAD
 
 #include "../misc/lv_log.h"
+#include "../stdlib/lv_string.h"
 
 #ifndef __linux__
     #include "../misc/lv_timer.h"
@@ -55,6 +60,16 @@ lv_result_t lv_thread_init(lv_thread_t * thread, const char * const name,
     thread->user_data = user_data;
     pthread_create(&thread->thread, &attr, generic_callback, thread);
     pthread_attr_destroy(&attr);
+
+#if defined(__linux__) && defined(__GLIBC__)
+    /*Name the thread so that it can be found in top, perf or /proc/<pid>/task/<tid>/comm*/
+    if(name) {
+        char short_name[16];    /*The kernel keeps at most 15 characters*/
+        lv_strlcpy(short_name, name, sizeof(short_name));
+        pthread_setname_np(thread->thread, short_name);
+    }
+#endif
+
     return LV_RESULT_OK;
 }
 
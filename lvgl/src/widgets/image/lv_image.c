@@ -35,6 +35,10 @@ static void lv_image_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 static void lv_image_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_image_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_image(lv_event_t * e);
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    static void draw_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * coords);
+    static void image_ready_cb(const void * src, void * user_data);
+#endif
 static void scale_update(lv_obj_t * obj, int32_t scale_x, int32_t scale_y);
 static void update_align(lv_obj_t * obj);
 #if LV_USE_OBJ_PROPERTY
@@ -157,6 +161,9 @@ void lv_image_set_src(lv_obj_t * obj, const void * src)
     lv_image_src_t src_type = lv_image_src_get_type(src);
     lv_image_t * img = (lv_image_t *)obj;
 
+    /*Drop the requests of the old source, failed ones would stay until the widget is deleted*/
+    if(src != img->src) lv_image_decoder_cancel_async(obj);
+
 #if LV_USE_LOG && LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
     switch(src_type) {
         case LV_IMAGE_SRC_FILE:
@@ -666,6 +673,7 @@ static void lv_image_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_image_t * img = (lv_image_t *)obj;
+    lv_image_decoder_cancel_async(obj);
     if(img->src_type == LV_IMAGE_SRC_FILE || img->src_type == LV_IMAGE_SRC_SYMBOL) {
         lv_free((void *)img->src);
         img->src      = NULL;
@@ -875,7 +883,15 @@ static void draw_image(lv_event_t * e)
                 coords = draw_dsc.image_area;
             }
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+            /*Don't stall the LVGL thread while a large image is decoded, it's invalidated when it's ready*/
+            bool ready = (uint32_t)img->w * img->h < LV_IMAGE_DECODER_ASYNC_MIN_PX ||
+                         lv_image_decoder_decode_async(img->src, image_ready_cb, obj) == LV_RESULT_OK;
+            if(ready) lv_draw_image(layer, &draw_dsc, &coords);
+            else draw_placeholder(layer, &draw_dsc, &coords);
+#else
             lv_draw_image(layer, &draw_dsc, &coords);
+#endif
             layer->_clip_area = clip_area_ori;
         }
         else if(img->src_type == LV_IMAGE_SRC_SYMBOL) {
@@ -916,6 +932,30 @@ static void draw_image(lv_event_t * e)
     }
 }
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+/**
+ * Fill the area of an image which is still being decoded
+ */
+static void draw_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * coords)
+{
+    lv_draw_fill_dsc_t fill_dsc;
+    lv_draw_fill_dsc_init(&fill_dsc);
+    fill_dsc.base.layer = layer;
+    fill_dsc.base.obj = draw_dsc->base.obj;
+    fill_dsc.base.part = draw_dsc->base.part;
+    fill_dsc.color = lv_color_hex(0x808080);
+    fill_dsc.opa = draw_dsc->opa;
+    fill_dsc.radius = draw_dsc->clip_radius;
+    lv_draw_fill(layer, &fill_dsc, coords);
+}
+
+static void image_ready_cb(const void * src, void * user_data)
+{
+    LV_UNUSED(src);
+    lv_obj_invalidate(user_data);
+}
+#endif
+
 static void scale_update(lv_obj_t * obj, int32_t scale_x, int32_t scale_y)
 {
     lv_image_t * img = (lv_image_t *)obj;
@@ -0,0 +1,389 @@
+/**
+ * @file arm_neon.h
+ *
+ * Scalar replacement of the NEON intrinsics used by the software blend kernels
+ * (src/draw/sw/blend/neon/). With it the intrinsics kernels can be built and tested
+ * on any host: the OPTIONS_TEST_NEON_EMU test build puts this directory on the include path
+ * and sets LV_USE_DRAW_SW_ASM to LV_DRAW_SW_ASM_NEON and LV_DRAW_SW_NEON_INTRINSICS to 1.
+ *
+ * Only the intrinsics used by the kernels are provided. They follow the lane semantics of
+ * the ARM documentation, the vectors are plain arrays of lanes.
+ */
+
+#ifndef LV_TEST_ARM_NEON_EMU_H
+#define LV_TEST_ARM_NEON_EMU_H
+
+#include <stdint.h>
+#include <string.h>
+
+/*********************
+ *      TYPEDEFS
+ *********************/
+
+typedef struct {
+    uint8_t v[8];
+} uint8x8_t;
+
+typedef struct {
+    uint8x8_t val[3];
+} uint8x8x3_t;
+
+typedef struct {
+    uint8x8_t val[4];
+} uint8x8x4_t;
+
+typedef struct {
+    uint16_t v[4];
+} uint16x4_t;
+
+typedef struct {
+    uint16_t v[8];
+} uint16x8_t;
+
+typedef struct {
+    uint32_t v[4];
+} uint32x4_t;
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LANE8   for(int i = 0; i < 8; i++)
+#define LANE4   for(int i = 0; i < 4; i++)
+
+/**********************
+ *  LOAD AND STORE
+ **********************/
+
+static inline uint8x8_t vld1_u8(const uint8_t * p)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = p[i];
+    return r;
+}
+
+static inline uint8x8x3_t vld3_u8(const uint8_t * p)
+{
+    uint8x8x3_t r;
+    LANE8 for(int k = 0; k < 3; k++) r.val[k].v[i] = p[i * 3 + k];
+    return r;
+}
+
+static inline uint8x8x4_t vld4_u8(const uint8_t * p)
+{
+    uint8x8x4_t r;
+    LANE8 for(int k = 0; k < 4; k++) r.val[k].v[i] = p[i * 4 + k];
+    return r;
+}
+
+static inline void vst4_u8(uint8_t * p, uint8x8x4_t a)
+{
+    LANE8 for(int k = 0; k < 4; k++) p[i * 4 + k] = a.val[k].v[i];
+}
+
+static inline uint16x8_t vld1q_u16(const uint16_t * p)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = p[i];
+    return r;
+}
+
+static inline void vst1q_u16(uint16_t * p, uint16x8_t a)
+{
+    LANE8 p[i] = a.v[i];
+}
+
+static inline uint32x4_t vld1q_u32(const uint32_t * p)
+{
+    uint32x4_t r;
+    LANE4 r.v[i] = p[i];
+    return r;
+}
+
+static inline void vst1q_u32(uint32_t * p, uint32x4_t a)
+{
+    LANE4 p[i] = a.v[i];
+}
+
+/**********************
+ *  SET, SPLIT, COMBINE
+ **********************/
+
+static inline uint8x8_t vdup_n_u8(uint8_t x)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = x;
+    return r;
+}
+
+static inline uint16x4_t vdup_n_u16(uint16_t x)
+{
+    uint16x4_t r;
+    LANE4 r.v[i] = x;
+    return r;
+}
+
+static inline uint16x8_t vdupq_n_u16(uint16_t x)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = x;
+    return r;
+}
+
+static inline uint32x4_t vdupq_n_u32(uint32_t x)
+{
+    uint32x4_t r;
+    LANE4 r.v[i] = x;
+    return r;
+}
+
+static inline uint16x4_t vget_low_u16(uint16x8_t a)
+{
+    uint16x4_t r;
+    LANE4 r.v[i] = a.v[i];
+    return r;
+}
+
+static inline uint16x4_t vget_high_u16(uint16x8_t a)
+{
+    uint16x4_t r;
+    LANE4 r.v[i] = a.v[4 + i];
+    return r;
+}
+
+static inline uint16x8_t vcombine_u16(uint16x4_t a, uint16x4_t b)
+{
+    uint16x8_t r;
+    LANE4 {
+        r.v[i] = a.v[i];
+        r.v[4 + i] = b.v[i];
+    }
+    return r;
+}
+
+static inline uint32x4_t vreinterpretq_u32_u16(uint16x8_t a)
+{
+    uint32x4_t r;
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+static inline uint16x8_t vreinterpretq_u16_u32(uint32x4_t a)
+{
+    uint16x8_t r;
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+/**********************
+ *  WIDEN AND NARROW
+ **********************/
+
+static inline uint16x8_t vmovl_u8(uint8x8_t a)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = a.v[i];
+    return r;
+}
+
+static inline uint8x8_t vmovn_u16(uint16x8_t a)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = (uint8_t)a.v[i];
+    return r;
+}
+
+static inline uint16x8_t vshll_n_u8(uint8x8_t a, int n)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] << n);
+    return r;
+}
+
+static inline uint8x8_t vshrn_n_u16(uint16x8_t a, int n)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = (uint8_t)(a.v[i] >> n);
+    return r;
+}
+
+static inline uint16x4_t vshrn_n_u32(uint32x4_t a, int n)
+{
+    uint16x4_t r;
+    LANE4 r.v[i] = (uint16_t)(a.v[i] >> n);
+    return r;
+}
+
+/**********************
+ *  ARITHMETIC
+ **********************/
+
+static inline uint16x8_t vaddq_u16(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] + b.v[i]);
+    return r;
+}
+
+static inline uint16x8_t vsubq_u16(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] - b.v[i]);
+    return r;
+}
+
+static inline uint16x8_t vmulq_u16(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] * b.v[i]);
+    return r;
+}
+
+static inline uint16x8_t vmulq_n_u16(uint16x8_t a, uint16_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] * b);
+    return r;
+}
+
+static inline uint16x8_t vmlaq_u16(uint16x8_t c, uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(c.v[i] + a.v[i] * b.v[i]);
+    return r;
+}
+
+static inline uint16x8_t vmull_u8(uint8x8_t a, uint8x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] * b.v[i]);
+    return r;
+}
+
+static inline uint16x8_t vmlal_u8(uint16x8_t c, uint8x8_t a, uint8x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(c.v[i] + a.v[i] * b.v[i]);
+    return r;
+}
+
+static inline uint32x4_t vmull_u16(uint16x4_t a, uint16x4_t b)
+{
+    uint32x4_t r;
+    LANE4 r.v[i] = (uint32_t)a.v[i] * b.v[i];
+    return r;
+}
+
+/**********************
+ *  BITWISE AND SHIFT
+ **********************/
+
+static inline uint8x8_t vand_u8(uint8x8_t a, uint8x8_t b)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = a.v[i] & b.v[i];
+    return r;
+}
+
+static inline uint16x8_t vandq_u16(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = a.v[i] & b.v[i];
+    return r;
+}
+
+static inline uint16x8_t vorrq_u16(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = a.v[i] | b.v[i];
+    return r;
+}
+
+static inline uint8x8_t vmvn_u8(uint8x8_t a)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = (uint8_t)~a.v[i];
+    return r;
+}
+
+static inline uint8x8_t vshr_n_u8(uint8x8_t a, int n)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = (uint8_t)(a.v[i] >> n);
+    return r;
+}
+
+static inline uint16x8_t vshrq_n_u16(uint16x8_t a, int n)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] >> n);
+    return r;
+}
+
+static inline uint16x8_t vshlq_n_u16(uint16x8_t a, int n)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)(a.v[i] << n);
+    return r;
+}
+
+/*Shift right and insert: keep the top `n` bits of `a`*/
+static inline uint8x8_t vsri_n_u8(uint8x8_t a, uint8x8_t b, int n)
+{
+    uint8x8_t r;
+    uint8_t m = (uint8_t)(0xff >> n);
+    LANE8 r.v[i] = (uint8_t)((a.v[i] & ~m) | (b.v[i] >> n));
+    return r;
+}
+
+static inline uint16x8_t vsriq_n_u16(uint16x8_t a, uint16x8_t b, int n)
+{
+    uint16x8_t r;
+    uint16_t m = (uint16_t)(0xffff >> n);
+    LANE8 r.v[i] = (uint16_t)((a.v[i] & ~m) | (b.v[i] >> n));
+    return r;
+}
+
+/**********************
+ *  COMPARE AND SELECT
+ **********************/
+
+static inline uint8x8_t vceq_u8(uint8x8_t a, uint8x8_t b)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = a.v[i] == b.v[i] ? 0xff : 0;
+    return r;
+}
+
+static inline uint8x8_t vcge_u8(uint8x8_t a, uint8x8_t b)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = a.v[i] >= b.v[i] ? 0xff : 0;
+    return r;
+}
+
+static inline uint16x8_t vceqq_u16(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = a.v[i] == b.v[i] ? 0xffff : 0;
+    return r;
+}
+
+static inline uint8x8_t vbsl_u8(uint8x8_t m, uint8x8_t a, uint8x8_t b)
+{
+    uint8x8_t r;
+    LANE8 r.v[i] = (uint8_t)((m.v[i] & a.v[i]) | (~m.v[i] & b.v[i]));
+    return r;
+}
+
+static inline uint16x8_t vbslq_u16(uint16x8_t m, uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t r;
+    LANE8 r.v[i] = (uint16_t)((m.v[i] & a.v[i]) | (~m.v[i] & b.v[i]));
+    return r;
+}
+
+#undef LANE8
+#undef LANE4
+
+#endif /*LV_TEST_ARM_NEON_EMU_H*/
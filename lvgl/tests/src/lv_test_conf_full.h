@@ -135,8 +135,14 @@
 
 #define LV_USE_OBJ_NAME         1
 
+#define LV_USE_OBJ_RENDER_CACHE 1
+
 #define LV_CACHE_DEF_SIZE       (10 * 1024 * 1024)
 
+#define LV_IMAGE_DECODER_ASYNC_THREAD_CNT   2
+/*Larger than the images of the screenshot tests*/
+#define LV_IMAGE_DECODER_ASYNC_MIN_PX       (1024 * 1024)
+
 #ifndef LV_USE_LINUX_DRM
     #define LV_USE_LINUX_DRM    1
 #endif
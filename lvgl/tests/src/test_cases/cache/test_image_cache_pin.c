@@ -0,0 +1,114 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#if LV_USE_LODEPNG
+
+#include "unity/unity.h"
+
+#define img_cache (LV_GLOBAL_DEFAULT()->img_cache)
+
+LV_IMAGE_DECLARE(test_img_lvgl_logo_png);
+
+#define PNG_FILE "A:src/test_assets/test_img_lvgl_logo.png"
+
+static uint32_t hit_start;
+static uint32_t miss_start;
+static uint32_t evict_start;
+static size_t max_size_start;
+
+void setUp(void)
+{
+    max_size_start = lv_cache_get_max_size(img_cache, NULL);
+    lv_image_cache_drop(NULL);
+    lv_image_cache_get_stats(&hit_start, &miss_start, &evict_start);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_image_cache_drop(NULL);
+    lv_image_cache_resize(max_size_start, false);
+}
+
+static void assert_stats(uint32_t hit_cnt, uint32_t miss_cnt, uint32_t evict_cnt)
+{
+    uint32_t hit;
+    uint32_t miss;
+    uint32_t evict;
+    lv_image_cache_get_stats(&hit, &miss, &evict);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt, hit - hit_start);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, miss - miss_start);
+    TEST_ASSERT_EQUAL_UINT32(evict_cnt, evict - evict_start);
+}
+
+void test_image_cache_prefetched_image_is_drawn_from_the_cache(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_prefetch(&test_img_lvgl_logo_png));
+    assert_stats(0, 1, 0);
+    TEST_ASSERT_GREATER_THAN(0, lv_cache_get_size(img_cache, NULL));
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, &test_img_lvgl_logo_png);
+    lv_refr_now(NULL);
+
+    uint32_t miss;
+    lv_image_cache_get_stats(NULL, &miss, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, miss - miss_start);
+}
+
+void test_image_cache_pinned_image_is_not_evicted(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_pin(&test_img_lvgl_logo_png));
+    size_t img_size = lv_cache_get_size(img_cache, NULL);
+    TEST_ASSERT_GREATER_THAN(0, img_size);
+
+    /*There is room only for one image*/
+    lv_image_cache_resize(img_size + img_size / 2, false);
+
+    /*The file can't evict the pinned image but is still drawn*/
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, PNG_FILE);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(img_size, lv_cache_get_size(img_cache, NULL));
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_prefetch(&test_img_lvgl_logo_png));
+    assert_stats(1, 2, 0);
+
+    /*After unpinning it can be evicted*/
+    lv_image_cache_unpin(&test_img_lvgl_logo_png);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_prefetch(PNG_FILE));
+    assert_stats(1, 3, 1);
+    TEST_ASSERT_EQUAL(img_size, lv_cache_get_size(img_cache, NULL));
+}
+
+void test_image_cache_pins_are_counted(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_pin(&test_img_lvgl_logo_png));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_pin(&test_img_lvgl_logo_png));
+
+    /*Still pinned once, so evicting everything keeps it*/
+    lv_image_cache_unpin(&test_img_lvgl_logo_png);
+    lv_cache_reserve(img_cache, max_size_start, NULL);
+    TEST_ASSERT_GREATER_THAN(0, lv_cache_get_size(img_cache, NULL));
+
+    lv_image_cache_unpin(&test_img_lvgl_logo_png);
+    lv_cache_reserve(img_cache, max_size_start, NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(img_cache, NULL));
+}
+
+void test_image_cache_drop_releases_the_pin(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_pin(PNG_FILE));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_pin(PNG_FILE));
+    TEST_ASSERT_GREATER_THAN(0, lv_cache_get_size(img_cache, NULL));
+
+    lv_image_cache_drop(PNG_FILE);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(img_cache, NULL));
+    TEST_ASSERT_NULL(lv_ll_get_head(&LV_GLOBAL_DEFAULT()->img_cache_pinned_ll));
+}
+
+#endif
+
+#endif
@@ -0,0 +1,290 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+
+#include "unity/unity.h"
+
+/* Compare the blend kernels (C or the accelerated ones selected by LV_USE_DRAW_SW_ASM)
+ * with a per pixel reference on odd widths, strides and every opa/mask combination.
+ * The padding around the blended area must not change. */
+
+#define MAX_W       37
+#define MAX_H       3
+#define PAD_PX      5
+#define MAX_STRIDE  ((MAX_W + PAD_PX) * 4)
+#define BUF_SIZE    (MAX_STRIDE * MAX_H + 16)
+
+typedef enum {
+    VARIANT_NORMAL,
+    VARIANT_WITH_OPA,
+    VARIANT_WITH_MASK,
+    VARIANT_MIX_MASK_OPA,
+} variant_t;
+
+static const lv_opa_t opa_values[] = {LV_OPA_COVER, 254, LV_OPA_MAX, 200, 128, 3};
+
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+static void rnd_fill(uint8_t * buf, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) buf[i] = (uint8_t)rnd();
+}
+
+/*Masks are often fully transparent or fully opaque so test these values too*/
+static void rnd_fill_mask(lv_opa_t * buf, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        uint32_t r = rnd() % 4;
+        buf[i] = r == 0 ? LV_OPA_TRANSP : r == 1 ? LV_OPA_COVER : (lv_opa_t)rnd();
+    }
+}
+
+void setUp(void)
+{
+    rnd_state = 0x12345678;
+}
+
+void tearDown(void)
+{
+}
+
+static uint16_t ref_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix)
+{
+    if(mix == 0) return c2;
+    if(mix == 255) return ((c1[2] & 0xF8) << 8) + ((c1[1] & 0xFC) << 3) + ((c1[0] & 0xF8) >> 3);
+
+    uint32_t mix_inv = 255 - mix;
+    uint32_t r = ((c1[2] >> 3) * mix + ((c2 >> 11) & 0x1F) * mix_inv) >> 8;
+    uint32_t g = ((c1[1] >> 2) * mix + ((c2 >> 5) & 0x3F) * mix_inv) >> 8;
+    uint32_t b = ((c1[0] >> 3) * mix + (c2 & 0x1F) * mix_inv) >> 8;
+    return (uint16_t)((r << 11) + (g << 5) + b);
+}
+
+static void ref_24_24_mix(const uint8_t * src, uint8_t * dest, uint8_t mix)
+{
+    uint32_t i;
+    if(mix == 0) return;
+    for(i = 0; i < 3; i++) {
+        if(mix >= LV_OPA_MAX) dest[i] = src[i];
+        else dest[i] = (uint8_t)((src[i] * mix + dest[i] * (255 - mix)) >> 8);
+    }
+}
+
+static void rgb565_to_888(uint16_t c, uint8_t * res)
+{
+    res[0] = (uint8_t)(((c & 0x1F) * 2106) >> 8);
+    res[1] = (uint8_t)((((c >> 5) & 0x3F) * 1037) >> 8);
+    res[2] = (uint8_t)(((c >> 11) * 2106) >> 8);
+}
+
+/**
+ * Blend the same area with the library and with the reference and compare the whole buffers
+ * @param src_cf        color format of the source image or LV_COLOR_FORMAT_UNKNOWN to fill with a color
+ * @param dest_px_size  2: RGB565, 4: XRGB8888
+ */
+static void check_blend(lv_color_format_t src_cf, uint32_t dest_px_size, variant_t variant)
+{
+    /*uint32_t to keep the 32 bit pixels aligned*/
+    static uint32_t dest_buf_u32[BUF_SIZE / 4];
+    static uint32_t ref_buf_u32[BUF_SIZE / 4];
+    static uint32_t src_buf_u32[BUF_SIZE / 4];
+    static lv_opa_t mask_buf[BUF_SIZE];
+    uint8_t * dest_buf = (uint8_t *)dest_buf_u32;
+    uint8_t * ref_buf = (uint8_t *)ref_buf_u32;
+    uint8_t * src_buf = (uint8_t *)src_buf_u32;
+
+    uint32_t src_px_size = src_cf == LV_COLOR_FORMAT_UNKNOWN ? 0 : lv_color_format_get_size(src_cf);
+    int32_t w;
+    int32_t h;
+
+    for(h = 1; h <= MAX_H; h++) {
+        for(w = 1; w <= MAX_W; w++) {
+            uint32_t opa_i;
+            for(opa_i = 0; opa_i < sizeof(opa_values); opa_i++) {
+                lv_opa_t opa = opa_values[opa_i];
+                bool with_mask = variant == VARIANT_WITH_MASK || variant == VARIANT_MIX_MASK_OPA;
+                bool with_opa = variant == VARIANT_WITH_OPA || variant == VARIANT_MIX_MASK_OPA;
+                if(with_opa == (opa >= LV_OPA_MAX)) continue;
+
+                /*Unaligned start and padding at the end of the rows*/
+                uint32_t dest_ofs = (rnd() % 4) * dest_px_size;
+                int32_t dest_stride = (w + rnd() % PAD_PX) * dest_px_size;
+                uint32_t src_ofs = (rnd() % 4) * (src_px_size ? src_px_size : 1);
+                int32_t src_stride = (w + rnd() % PAD_PX) * src_px_size;
+                uint32_t mask_ofs = rnd() % 4;
+                int32_t mask_stride = w + rnd() % PAD_PX;
+                if(dest_px_size == 4) dest_ofs = 0;
+
+                rnd_fill(dest_buf, BUF_SIZE);
+                rnd_fill(src_buf, BUF_SIZE);
+                rnd_fill_mask(mask_buf, BUF_SIZE);
+                lv_memcpy(ref_buf, dest_buf, BUF_SIZE);
+
+                lv_color_t color = lv_color_make((uint8_t)rnd(), (uint8_t)rnd(), (uint8_t)rnd());
+
+                int32_t x;
+                int32_t y;
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        uint8_t * d = &ref_buf[dest_ofs + y * dest_stride + x * dest_px_size];
+                        const uint8_t * s = &src_buf[src_ofs + y * src_stride + x * src_px_size];
+                        lv_opa_t mask = with_mask ? mask_buf[mask_ofs + y * mask_stride + x] : LV_OPA_COVER;
+                        uint8_t px[3];
+                        lv_opa_t mix;
+
+                        if(src_cf == LV_COLOR_FORMAT_UNKNOWN) {
+                            px[0] = color.blue;
+                            px[1] = color.green;
+                            px[2] = color.red;
+                        }
+                        else if(src_cf == LV_COLOR_FORMAT_RGB565) {
+                            if(dest_px_size == 4) rgb565_to_888(*(const uint16_t *)s, px);
+                        }
+                        else {
+                            lv_memcpy(px, s, 3);
+                        }
+
+                        if(src_cf == LV_COLOR_FORMAT_ARGB8888) {
+                            if(with_mask && with_opa) mix = LV_OPA_MIX3(s[3], mask, opa);
+                            else if(with_mask) mix = LV_OPA_MIX2(s[3], mask);
+                            else if(with_opa) mix = LV_OPA_MIX2(s[3], opa);
+                            else mix = s[3];
+                        }
+                        else {
+                            if(with_mask && with_opa) mix = LV_OPA_MIX2(mask, opa);
+                            else if(with_mask) mix = mask;
+                            else if(with_opa) mix = opa;
+                            else mix = LV_OPA_COVER;
+                        }
+
+                        if(dest_px_size == 4) {
+                            if(src_cf == LV_COLOR_FORMAT_UNKNOWN && variant == VARIANT_NORMAL) {
+                                *(uint32_t *)d = lv_color_to_u32(color);
+                            }
+                            else if(src_cf == LV_COLOR_FORMAT_XRGB8888 && variant == VARIANT_NORMAL) {
+                                lv_memcpy(d, s, 4);
+                            }
+                            else {
+                                ref_24_24_mix(px, d, mix);
+                            }
+                        }
+                        else {
+                            uint16_t * d16 = (uint16_t *)d;
+                            if(src_cf == LV_COLOR_FORMAT_UNKNOWN) {
+                                *d16 = lv_color_16_16_mix(lv_color_to_u16(color), *d16, mix);
+                            }
+                            else if(src_cf == LV_COLOR_FORMAT_RGB565) {
+                                *d16 = lv_color_16_16_mix(*(const uint16_t *)s, *d16, mix);
+                            }
+                            else {
+                                *d16 = ref_24_16_mix(px, *d16, mix);
+                            }
+                        }
+                    }
+                }
+
+                lv_area_t area = {0, 0, w - 1, h - 1};
+                if(src_cf == LV_COLOR_FORMAT_UNKNOWN) {
+                    lv_draw_sw_blend_fill_dsc_t dsc;
+                    lv_memzero(&dsc, sizeof(dsc));
+                    dsc.dest_buf = &dest_buf[dest_ofs];
+                    dsc.dest_w = w;
+                    dsc.dest_h = h;
+                    dsc.dest_stride = dest_stride;
+                    dsc.mask_buf = with_mask ? &mask_buf[mask_ofs] : NULL;
+                    dsc.mask_stride = mask_stride;
+                    dsc.color = color;
+                    dsc.opa = opa;
+                    dsc.relative_area = area;
+                    if(dest_px_size == 2) lv_draw_sw_blend_color_to_rgb565(&dsc);
+                    else lv_draw_sw_blend_color_to_rgb888(&dsc, dest_px_size);
+                }
+                else {
+                    lv_draw_sw_blend_image_dsc_t dsc;
+                    lv_memzero(&dsc, sizeof(dsc));
+                    dsc.dest_buf = &dest_buf[dest_ofs];
+                    dsc.dest_w = w;
+                    dsc.dest_h = h;
+                    dsc.dest_stride = dest_stride;
+                    dsc.mask_buf = with_mask ? &mask_buf[mask_ofs] : NULL;
+                    dsc.mask_stride = mask_stride;
+                    dsc.src_buf = &src_buf[src_ofs];
+                    dsc.src_stride = src_stride;
+                    dsc.src_color_format = src_cf;
+                    dsc.opa = opa;
+                    dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+                    dsc.relative_area = area;
+                    dsc.src_area = area;
+                    if(dest_px_size == 2) lv_draw_sw_blend_image_to_rgb565(&dsc);
+                    else lv_draw_sw_blend_image_to_rgb888(&dsc, dest_px_size);
+                }
+
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dest_buf, BUF_SIZE);
+            }
+        }
+    }
+}
+
+static void check_all_variants(lv_color_format_t src_cf, uint32_t dest_px_size)
+{
+    check_blend(src_cf, dest_px_size, VARIANT_NORMAL);
+    check_blend(src_cf, dest_px_size, VARIANT_WITH_OPA);
+    check_blend(src_cf, dest_px_size, VARIANT_WITH_MASK);
+    check_blend(src_cf, dest_px_size, VARIANT_MIX_MASK_OPA);
+}
+
+void test_blend_color_to_rgb565(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_UNKNOWN, 2);
+}
+
+void test_blend_rgb565_to_rgb565(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_RGB565, 2);
+}
+
+void test_blend_rgb888_to_rgb565(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_RGB888, 2);
+    check_all_variants(LV_COLOR_FORMAT_XRGB8888, 2);
+}
+
+void test_blend_argb8888_to_rgb565(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_ARGB8888, 2);
+}
+
+void test_blend_color_to_xrgb8888(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_UNKNOWN, 4);
+}
+
+void test_blend_rgb565_to_xrgb8888(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_RGB565, 4);
+}
+
+void test_blend_rgb888_to_xrgb8888(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_RGB888, 4);
+    check_all_variants(LV_COLOR_FORMAT_XRGB8888, 4);
+}
+
+void test_blend_argb8888_to_xrgb8888(void)
+{
+    check_all_variants(LV_COLOR_FORMAT_ARGB8888, 4);
+}
+
+#endif
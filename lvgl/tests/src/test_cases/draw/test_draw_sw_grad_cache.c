@@ -0,0 +1,134 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRADIENT_CACHE_SIZE && LV_USE_DRAW_SW_COMPLEX_GRADIENTS
+
+#include "unity/unity.h"
+
+#define grad_cache (LV_GLOBAL_DEFAULT()->sw_grad_cache)
+
+static lv_grad_dsc_t grad_ver;
+static lv_grad_dsc_t grad_hor;
+static lv_grad_dsc_t grad_linear;
+static lv_grad_dsc_t grad_radial;
+static lv_grad_dsc_t grad_conical;
+
+void setUp(void)
+{
+    static const lv_color_t colors[] = {LV_COLOR_MAKE(0xff, 0x00, 0x00), LV_COLOR_MAKE(0x00, 0x80, 0xff)};
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_60};
+    static const uint8_t fracs[] = {40, 210};
+
+    lv_grad_init_stops(&grad_ver, colors, NULL, NULL, 2);
+    lv_grad_vertical_init(&grad_ver);
+    lv_grad_init_stops(&grad_hor, colors, opas, fracs, 2);
+    lv_grad_horizontal_init(&grad_hor);
+    lv_grad_init_stops(&grad_linear, colors, NULL, fracs, 2);
+    lv_grad_linear_init(&grad_linear, LV_GRAD_LEFT, LV_GRAD_TOP, LV_GRAD_RIGHT, LV_GRAD_BOTTOM, LV_GRAD_EXTEND_PAD);
+    lv_grad_init_stops(&grad_radial, colors, opas, NULL, 2);
+    lv_grad_radial_init(&grad_radial, LV_GRAD_CENTER, LV_GRAD_CENTER, LV_GRAD_RIGHT, LV_GRAD_BOTTOM,
+                        LV_GRAD_EXTEND_REFLECT);
+    lv_grad_init_stops(&grad_conical, colors, NULL, NULL, 2);
+    lv_grad_conical_init(&grad_conical, LV_GRAD_CENTER, LV_GRAD_CENTER, 0, 180, LV_GRAD_EXTEND_REPEAT);
+
+    lv_cache_drop_all(grad_cache, NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_cache_set_max_size(grad_cache, LV_DRAW_SW_GRADIENT_CACHE_SIZE, NULL);
+}
+
+static lv_obj_t * grad_obj_create(const lv_grad_dsc_t * grad, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_grad(obj, grad, 0);
+    lv_obj_set_style_radius(obj, 12, 0);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+void test_draw_sw_grad_cache_shares_ramps(void)
+{
+    grad_obj_create(&grad_ver, 10, 10, 100, 80);
+    lv_refr_now(NULL);
+    size_t size = lv_cache_get_size(grad_cache, NULL);
+    TEST_ASSERT_GREATER_THAN(0, size);
+
+    /*Same stops and height, the width doesn't matter*/
+    grad_obj_create(&grad_ver, 150, 10, 200, 80);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(size, lv_cache_get_size(grad_cache, NULL));
+
+    /*A different height needs a new ramp*/
+    grad_obj_create(&grad_ver, 400, 10, 100, 90);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN(size, lv_cache_get_size(grad_cache, NULL));
+}
+
+void test_draw_sw_grad_cache_shares_complex_ramps(void)
+{
+    /*The 256 color ramp of complex gradients doesn't depend on the size*/
+    grad_obj_create(&grad_linear, 10, 10, 100, 80);
+    lv_refr_now(NULL);
+    size_t size = lv_cache_get_size(grad_cache, NULL);
+    TEST_ASSERT_GREATER_THAN(0, size);
+
+    grad_obj_create(&grad_linear, 150, 10, 200, 150);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(size, lv_cache_get_size(grad_cache, NULL));
+}
+
+void test_draw_sw_grad_cache_renders_the_same(void)
+{
+    grad_obj_create(&grad_ver, 10, 10, 200, 150);
+    grad_obj_create(&grad_hor, 250, 10, 300, 100);
+    grad_obj_create(&grad_linear, 580, 10, 200, 200);
+    grad_obj_create(&grad_radial, 10, 220, 300, 200);
+    grad_obj_create(&grad_conical, 350, 220, 250, 250);
+    /*The same ramp again*/
+    grad_obj_create(&grad_hor, 620, 250, 300, 100);
+    lv_refr_now(NULL);
+
+    /*Draw from the cached ramps*/
+    lv_draw_buf_t * cached = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(cached);
+
+    /*Compute every ramp again*/
+    lv_cache_set_max_size(grad_cache, 0, NULL);
+    lv_cache_drop_all(grad_cache, NULL);
+    lv_draw_buf_t * normal = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(normal);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(grad_cache, NULL));
+
+    TEST_ASSERT_EQUAL_UINT32(normal->data_size, cached->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(normal->data, cached->data, normal->data_size);
+
+    lv_draw_buf_destroy(cached);
+    lv_draw_buf_destroy(normal);
+}
+
+void test_draw_sw_grad_cache_stays_in_the_budget(void)
+{
+    size_t max_size = 2048;
+    lv_cache_set_max_size(grad_cache, max_size, NULL);
+
+    int32_t i;
+    for(i = 0; i < 10; i++) {
+        grad_obj_create(&grad_ver, 10 + i * 70, 10, 60, 100 + i * 10);
+    }
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_LESS_OR_EQUAL(max_size, lv_cache_get_size(grad_cache, NULL));
+    TEST_ASSERT_GREATER_THAN(0, lv_cache_get_size(grad_cache, NULL));
+}
+
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE
+
+#include "unity/unity.h"
+
+/*The largest shadow corner which is still cached*/
+#define SHADOW_W    (LV_DRAW_SW_SHADOW_CACHE_SIZE / 2)
+#define RADIUS      (LV_DRAW_SW_SHADOW_CACHE_SIZE - SHADOW_W)
+#define CORNER_SIZE (SHADOW_W + RADIUS)
+
+#define shadow_cache (LV_GLOBAL_DEFAULT()->sw_shadow_cache.cache)
+
+static uint32_t hit_start;
+static uint32_t miss_start;
+
+void setUp(void)
+{
+    lv_draw_sw_shadow_cache_drop_all();
+    lv_draw_sw_shadow_cache_get_stats(&hit_start, &miss_start);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_cache_set_max_size(shadow_cache, LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE, NULL);
+}
+
+static lv_obj_t * shadow_create(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_radius(obj, RADIUS, 0);
+    lv_obj_set_style_shadow_width(obj, SHADOW_W, 0);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_shadow_color(obj, lv_color_hex(0x102030), 0);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+static void assert_stats(uint32_t hit_cnt, uint32_t miss_cnt)
+{
+    uint32_t hit;
+    uint32_t miss;
+    lv_draw_sw_shadow_cache_get_stats(&hit, &miss);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt, hit - hit_start);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, miss - miss_start);
+}
+
+void test_draw_sw_shadow_cache_redraw_hits(void)
+{
+    lv_obj_t * obj = shadow_create(100, 100, 200, 150);
+    lv_refr_now(NULL);
+    assert_stats(0, 1);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    assert_stats(1, 1);
+}
+
+void test_draw_sw_shadow_cache_shares_corners_of_large_widgets(void)
+{
+    /*The far edges don't reach into the corner*/
+    shadow_create(50, 50, 200, 150);
+    shadow_create(350, 50, 300, 150);
+    lv_refr_now(NULL);
+    assert_stats(1, 1);
+
+    lv_obj_clean(lv_screen_active());
+    lv_draw_sw_shadow_cache_drop_all();
+    lv_draw_sw_shadow_cache_get_stats(&hit_start, &miss_start);
+
+    /*The far edges of narrow widgets change the corner*/
+    shadow_create(50, 50, CORNER_SIZE, 150);
+    shadow_create(350, 50, CORNER_SIZE + 2, 150);
+    lv_refr_now(NULL);
+    assert_stats(0, 2);
+}
+
+void test_draw_sw_shadow_cache_renders_the_same(void)
+{
+    shadow_create(30, 30, 200, 150);
+    shadow_create(300, 30, 300, 150);
+    shadow_create(30, 250, CORNER_SIZE, CORNER_SIZE);
+    shadow_create(150, 250, CORNER_SIZE + 3, 2 * CORNER_SIZE + 1);
+    lv_obj_t * spread = shadow_create(400, 250, 250, 120);
+    lv_obj_set_style_shadow_spread(spread, 3, 0);
+    lv_obj_set_style_shadow_offset_x(spread, 5, 0);
+    lv_refr_now(NULL);
+
+    /*Every corner comes from the cache now*/
+    lv_draw_sw_shadow_cache_get_stats(&hit_start, &miss_start);
+    lv_draw_buf_t * cached = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(cached);
+    assert_stats(5, 0);
+
+    /*Blur every corner again*/
+    lv_cache_set_max_size(shadow_cache, 0, NULL);
+    lv_draw_sw_shadow_cache_drop_all();
+    lv_draw_buf_t * normal = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(normal);
+    assert_stats(5, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(normal->data_size, cached->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(normal->data, cached->data, normal->data_size);
+
+    lv_draw_buf_destroy(cached);
+    lv_draw_buf_destroy(normal);
+}
+
+void test_draw_sw_shadow_cache_stays_in_the_budget(void)
+{
+    uint32_t max_size = 3 * CORNER_SIZE * CORNER_SIZE;
+    lv_cache_set_max_size(shadow_cache, max_size, NULL);
+
+    /*6 different narrow widgets need 6 corners*/
+    int32_t i;
+    for(i = 0; i < 6; i++) {
+        shadow_create(20 + i * 120, 100, CORNER_SIZE + i, 100);
+    }
+    lv_refr_now(NULL);
+
+    assert_stats(0, 6);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(max_size, lv_cache_get_size(shadow_cache, NULL));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_cache_get_size(shadow_cache, NULL));
+}
+
+#endif
+
+#endif
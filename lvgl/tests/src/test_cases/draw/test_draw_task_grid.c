@@ -0,0 +1,162 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+/* Compare the available draw tasks found with the layer's task grid with a linear check
+ * of all the older tasks. The tasks get an unknown draw unit ID so no draw unit takes them. */
+
+#define TEST_UNIT_ID    0xEE
+
+static lv_layer_t layer;
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+void setUp(void)
+{
+    lv_layer_init(&layer);
+    lv_area_set(&layer.buf_area, 0, 0, 799, 479);
+    layer._clip_area = layer.buf_area;
+    layer.phy_clip_area = layer.buf_area;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    rnd_state = 1;
+}
+
+void tearDown(void)
+{
+    /*Without OS the SW draw unit takes the first task regardless of the unit ID and renders it*/
+    if(layer.draw_buf) {
+        lv_draw_buf_destroy(layer.draw_buf);
+        layer.draw_buf = NULL;
+    }
+}
+
+static void add_tasks(uint32_t cnt)
+{
+    /*Evaluate the tasks but don't dispatch them, as if they were added in LV_EVENT_DRAW_TASK_ADDED*/
+    LV_GLOBAL_DEFAULT()->draw_info.task_running = true;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_area_t a;
+        /*Some tasks reach out of the layer*/
+        a.x1 = (int32_t)(rnd() % 840) - 20;
+        a.y1 = (int32_t)(rnd() % 520) - 20;
+        if(i % 50 == 0) {
+            a.x2 = a.x1 + 300;
+            a.y2 = a.y1 + 200;
+        }
+        else {
+            a.x2 = a.x1 + (int32_t)(rnd() % 60);
+            a.y2 = a.y1 + (int32_t)(rnd() % 40);
+        }
+
+        lv_draw_task_t * t = lv_draw_add_task(&layer, &a, LV_DRAW_TASK_TYPE_FILL);
+        lv_draw_fill_dsc_init(t->draw_dsc);
+        lv_draw_finalize_task_creation(&layer, t);
+        t->preferred_draw_unit_id = TEST_UNIT_ID;
+    }
+
+    LV_GLOBAL_DEFAULT()->draw_info.task_running = false;
+}
+
+static void set_random_states(void)
+{
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t) {
+        uint32_t r = rnd() % 8;
+        if(r == 0) t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+        else if(r <= 2) t->state = LV_DRAW_TASK_STATE_READY;
+        t = t->next;
+    }
+}
+
+static bool is_independent_ref(lv_draw_task_t * t_check)
+{
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t != t_check) {
+        lv_area_t a;
+        if(t->state != LV_DRAW_TASK_STATE_READY && lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
+            return false;
+        }
+        t = t->next;
+    }
+    return true;
+}
+
+static void check_available_tasks(void)
+{
+    uint32_t found_cnt = 0;
+    lv_draw_task_t * t_ref = layer.draw_task_head;
+    lv_draw_task_t * t = NULL;
+    while(1) {
+        while(t_ref && (t_ref->state != LV_DRAW_TASK_STATE_QUEUED || !is_independent_ref(t_ref))) {
+            t_ref = t_ref->next;
+        }
+
+        t = lv_draw_get_next_available_task(&layer, t, TEST_UNIT_ID);
+        TEST_ASSERT_EQUAL_PTR(t_ref, t);
+        if(t == NULL) break;
+
+        found_cnt++;
+        t_ref = t_ref->next;
+    }
+
+    /*Be sure both cases are tested*/
+    TEST_ASSERT_GREATER_THAN(0, found_cnt);
+}
+
+void test_draw_task_grid_matches_linear_check(void)
+{
+    add_tasks(400);
+    set_random_states();
+    check_available_tasks();
+
+#if LV_DRAW_TASK_GRID_THRESHOLD
+    TEST_ASSERT_NOT_NULL(layer.task_grid);
+#endif
+
+    /*Remove the ready tasks and add new ones to the existing grid*/
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_draw_dispatch_layer(NULL, &layer);
+        add_tasks(50);
+        set_random_states();
+        check_available_tasks();
+    }
+
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t) {
+        t->state = LV_DRAW_TASK_STATE_READY;
+        t = t->next;
+    }
+    lv_draw_dispatch_layer(NULL, &layer);
+
+    TEST_ASSERT_NULL(layer.draw_task_head);
+    TEST_ASSERT_NULL(layer.task_grid);
+}
+
+#if LV_DRAW_TASK_GRID_THRESHOLD
+void test_draw_task_grid_not_created_for_few_tasks(void)
+{
+    add_tasks(LV_DRAW_TASK_GRID_THRESHOLD / 2);
+    check_available_tasks();
+
+    TEST_ASSERT_NULL(layer.task_grid);
+
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t) {
+        t->state = LV_DRAW_TASK_STATE_READY;
+        t = t->next;
+    }
+    lv_draw_dispatch_layer(NULL, &layer);
+}
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT && LV_USE_LODEPNG
+
+#include "unity/unity.h"
+#include <unistd.h>
+
+#define req_ll (LV_GLOBAL_DEFAULT()->img_decoder_async.req_ll)
+
+/*1024x1024 PNG, the color of each row is (y / 4, 64, 160)*/
+#define PNG_LARGE "A:src/test_assets/test_img_large_1024.png"
+
+LV_IMAGE_DECLARE(test_img_lvgl_logo_png);
+LV_IMAGE_DECLARE(test_arc_bg);
+
+static uint32_t ready_cnt;
+
+void setUp(void)
+{
+    ready_cnt = 0;
+    lv_image_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_image_cache_drop(NULL);
+}
+
+static void ready_cb(const void * src, void * user_data)
+{
+    LV_UNUSED(src);
+    uint32_t * cnt = user_data;
+    (*cnt)++;
+}
+
+static bool wait_for_decoding(void)
+{
+    uint32_t i;
+    for(i = 0; i < 500; i++) {
+        if(lv_ll_get_head(&req_ll) == NULL) return true;
+        usleep(2000);
+        lv_test_fast_forward(LV_DEF_REFR_PERIOD);
+    }
+
+    return false;
+}
+
+static lv_color32_t get_px(int32_t x, int32_t y)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    return *(lv_color32_t *)lv_draw_buf_goto_xy(buf, x, y);
+}
+
+void test_image_decoder_async_placeholder_until_decoded(void)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, PNG_LARGE);
+    lv_refr_now(NULL);
+
+    /*The image is queued when it's drawn the first time*/
+    lv_color32_t px = get_px(10, 40);
+    TEST_ASSERT_EQUAL_HEX8(0x80, px.red);
+    TEST_ASSERT_EQUAL_HEX8(0x80, px.green);
+    TEST_ASSERT_EQUAL_HEX8(0x80, px.blue);
+
+    /*The widget is redrawn from the cache when the image is decoded*/
+    TEST_ASSERT_TRUE(wait_for_decoding());
+    TEST_ASSERT_GREATER_THAN(0, lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_cache, NULL));
+    px = get_px(10, 40);
+    TEST_ASSERT_EQUAL_HEX8(10, px.red);
+    TEST_ASSERT_EQUAL_HEX8(64, px.green);
+    TEST_ASSERT_EQUAL_HEX8(160, px.blue);
+}
+
+void test_image_decoder_async_calls_ready_cb(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_decode_async(PNG_LARGE, ready_cb, &ready_cnt));
+    lv_image_decoder_decode_async(PNG_LARGE, ready_cb, &ready_cnt);
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_decode_async(&test_img_lvgl_logo_png, ready_cb, &ready_cnt));
+
+    /*Once for each image*/
+    TEST_ASSERT_TRUE(wait_for_decoding());
+    TEST_ASSERT_EQUAL_UINT32(2, ready_cnt);
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_decode_async(PNG_LARGE, ready_cb, &ready_cnt));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_decode_async(&test_img_lvgl_logo_png, ready_cb, &ready_cnt));
+    TEST_ASSERT_NULL(lv_ll_get_head(&req_ll));
+}
+
+void test_image_decoder_async_plain_images_are_ready(void)
+{
+    /*Not encoded, nothing to decode*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_decode_async(&test_arc_bg, ready_cb, &ready_cnt));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_decode_async(LV_SYMBOL_OK, ready_cb, &ready_cnt));
+    TEST_ASSERT_NULL(lv_ll_get_head(&req_ll));
+    TEST_ASSERT_EQUAL_UINT32(0, ready_cnt);
+}
+
+void test_image_decoder_async_cancel(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_decode_async(PNG_LARGE, ready_cb, &ready_cnt));
+    lv_image_decoder_cancel_async(&ready_cnt);
+
+    TEST_ASSERT_TRUE(wait_for_decoding());
+    TEST_ASSERT_EQUAL_UINT32(0, ready_cnt);
+
+    /*Deleting the widget cancels its request*/
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, PNG_LARGE);
+    lv_image_cache_drop(NULL);
+    lv_refr_now(NULL);
+    lv_obj_delete(img);
+    TEST_ASSERT_TRUE(wait_for_decoding());
+}
+
+void test_image_decoder_async_probe_is_not_a_cache_hit(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_decode_async(PNG_LARGE, ready_cb, &ready_cnt));
+    TEST_ASSERT_TRUE(wait_for_decoding());
+
+    uint32_t hit_start;
+    lv_image_cache_get_stats(&hit_start, NULL, NULL);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_decode_async(PNG_LARGE, ready_cb, &ready_cnt));
+
+    uint32_t hit;
+    lv_image_cache_get_stats(&hit, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT32(hit_start, hit);
+}
+
+void test_image_decoder_async_new_src_cancels_the_old_request(void)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, PNG_LARGE);
+    lv_refr_now(NULL);
+    TEST_ASSERT_NOT_NULL(lv_ll_get_head(&req_ll));
+
+    lv_image_set_src(img, &test_arc_bg);
+
+    /*Only a request being decoded is kept, marked as cancelled*/
+    lv_image_decoder_async_req_t * req;
+    LV_LL_READ(&req_ll, req) {
+        TEST_ASSERT_TRUE(req->user_data != img || req->cancelled);
+    }
+
+    TEST_ASSERT_TRUE(wait_for_decoding());
+}
+
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#if LV_USE_OBJ_RENDER_CACHE && LV_USE_SNAPSHOT
+
+#include "unity/unity.h"
+
+static lv_obj_t * cont;
+static lv_obj_t * label;
+
+void setUp(void)
+{
+    /*An opaque, rectangular container is cached in the layer's color format and blitted as it is*/
+    cont = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 400, 300);
+    lv_obj_set_pos(cont, 20, 30);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(cont, lv_color_hex(0x3a5f6b), 0);
+
+    label = lv_label_create(cont);
+    lv_label_set_text(label, "Static label");
+    lv_obj_set_pos(label, 10, 10);
+
+    lv_obj_t * btn = lv_button_create(cont);
+    lv_obj_set_pos(btn, 50, 100);
+    lv_obj_t * btn_label = lv_label_create(btn);
+    lv_label_set_text(btn_label, "Button");
+
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_RENDER_CACHE);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    TEST_ASSERT_EQUAL_UINT32(0, LV_GLOBAL_DEFAULT()->obj_render_cache_size);
+}
+
+static void assert_same_as_without_cache(void)
+{
+    lv_draw_buf_t * cached = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(cached);
+    TEST_ASSERT_NOT_NULL(cont->spec_attr->render_cache);
+    TEST_ASSERT_NOT_NULL(cont->spec_attr->render_cache->draw_buf);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_XRGB8888, cont->spec_attr->render_cache->draw_buf->header.cf);
+
+    lv_obj_remove_flag(cont, LV_OBJ_FLAG_RENDER_CACHE);
+    TEST_ASSERT_NULL(cont->spec_attr->render_cache);
+    lv_draw_buf_t * normal = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(normal);
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_RENDER_CACHE);
+
+    TEST_ASSERT_EQUAL_UINT32(normal->data_size, cached->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(normal->data, cached->data, normal->data_size);
+
+    lv_draw_buf_destroy(cached);
+    lv_draw_buf_destroy(normal);
+}
+
+void test_obj_render_cache_matches_normal_rendering(void)
+{
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(lv_display_get_color_format(NULL), cont->spec_attr->render_cache->draw_buf->header.cf);
+
+    assert_same_as_without_cache();
+}
+
+void test_obj_render_cache_updates_invalidated_children(void)
+{
+    lv_refr_now(NULL);
+    TEST_ASSERT_FALSE(cont->spec_attr->render_cache->has_dirty);
+
+    /*Only the label's area needs to be rendered again*/
+    lv_label_set_text(label, "Changed text");
+    lv_obj_update_layout(cont);
+    lv_obj_render_cache_t * cache = cont->spec_attr->render_cache;
+    TEST_ASSERT_TRUE(cache->has_dirty);
+    TEST_ASSERT_LESS_THAN(lv_area_get_size(&cont->coords) / 4, lv_area_get_size(&cache->dirty));
+
+    assert_same_as_without_cache();
+
+    /*Moving the container keeps the cached image*/
+    lv_obj_set_pos(lv_obj_get_child(cont, 1), 150, 150);
+    lv_obj_set_pos(cont, 60, 80);
+    assert_same_as_without_cache();
+}
+
+void test_obj_render_cache_transparent_widget(void)
+{
+    lv_obj_set_style_bg_opa(cont, LV_OPA_50, 0);
+    lv_obj_set_style_radius(cont, 20, 0);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_ARGB8888, cont->spec_attr->render_cache->draw_buf->header.cf);
+}
+
+void test_obj_render_cache_is_blitted_when_covered_by_others(void)
+{
+    lv_obj_t * top = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(top, 100, 100);
+    lv_obj_set_pos(top, 100, 100);
+    lv_refr_now(NULL);
+
+    /*Redrawing the area of the widget on top must not render the cached widgets again*/
+    uint32_t task_cnt = lv_draw_get_task_created_count();
+    lv_obj_invalidate(top);
+    lv_refr_now(NULL);
+    uint32_t task_cnt_cached = lv_draw_get_task_created_count() - task_cnt;
+    TEST_ASSERT_FALSE(cont->spec_attr->render_cache->has_dirty);
+
+    lv_obj_remove_flag(cont, LV_OBJ_FLAG_RENDER_CACHE);
+    task_cnt = lv_draw_get_task_created_count();
+    lv_obj_invalidate(top);
+    lv_refr_now(NULL);
+    uint32_t task_cnt_normal = lv_draw_get_task_created_count() - task_cnt;
+
+    TEST_ASSERT_LESS_THAN_UINT32(task_cnt_normal, task_cnt_cached);
+}
+
+void test_obj_render_cache_stays_in_the_budget(void)
+{
+    /*Too large for the budget: drawn normally*/
+    lv_obj_t * large = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(large);
+    lv_obj_set_style_bg_opa(large, LV_OPA_COVER, 0);
+    int32_t large_h = LV_OBJ_RENDER_CACHE_SIZE / lv_draw_buf_width_to_stride(300, LV_COLOR_FORMAT_NATIVE) + 1;
+    lv_obj_set_size(large, 300, large_h);
+    lv_obj_set_x(large, 450);
+    lv_obj_add_flag(large, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_TRUE(large->spec_attr->render_cache == NULL || large->spec_attr->render_cache->draw_buf == NULL);
+    TEST_ASSERT_NOT_NULL(cont->spec_attr->render_cache->draw_buf);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_OBJ_RENDER_CACHE_SIZE, LV_GLOBAL_DEFAULT()->obj_render_cache_size);
+
+    /*Fits only if the least recently used container's cache is freed*/
+    lv_obj_set_height(large, large_h - 2);
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_HIDDEN);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_NOT_NULL(large->spec_attr->render_cache->draw_buf);
+    TEST_ASSERT_NULL(cont->spec_attr->render_cache->draw_buf);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_OBJ_RENDER_CACHE_SIZE, LV_GLOBAL_DEFAULT()->obj_render_cache_size);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,108 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /*Start with nothing to redraw*/
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void inv_area(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_inv_area(NULL, &a);
+}
+
+void test_refr_damage_far_areas_are_not_joined(void)
+{
+    inv_area(0, 0, 9, 9);
+    inv_area(700, 400, 709, 409);
+    lv_refr_now(NULL);
+
+    uint32_t redrawn;
+    uint32_t dirty;
+    lv_refr_get_damage_px(NULL, &redrawn, &dirty);
+    TEST_ASSERT_EQUAL_UINT32(200, dirty);
+    TEST_ASSERT_EQUAL_UINT32(200, redrawn);
+}
+
+void test_refr_damage_close_areas_are_joined_within_the_overdraw_limit(void)
+{
+    /*The bounding box adds a 1 px wide column to 2 x 100 px*/
+    inv_area(100, 100, 109, 109);
+    inv_area(111, 100, 120, 109);
+    lv_refr_now(NULL);
+
+    uint32_t redrawn;
+    uint32_t dirty;
+    lv_refr_get_damage_px(NULL, &redrawn, &dirty);
+    TEST_ASSERT_EQUAL_UINT32(200, dirty);
+    TEST_ASSERT_EQUAL_UINT32(210, redrawn);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(dirty + dirty * LV_REFR_JOIN_OVERDRAW / 100, redrawn);
+}
+
+void test_refr_damage_overdraw_does_not_add_up_over_joins(void)
+{
+    /*Each pair of neighbours is in the overdraw limit (4 px wide gap to 2 x 100 px),
+     *but joining the whole row would not be*/
+    inv_area(0, 0, 9, 9);
+    inv_area(14, 0, 23, 9);
+    inv_area(28, 0, 37, 9);
+    inv_area(42, 0, 51, 9);
+    lv_refr_now(NULL);
+
+    uint32_t redrawn;
+    uint32_t dirty;
+    lv_refr_get_damage_px(NULL, &redrawn, &dirty);
+    TEST_ASSERT_EQUAL_UINT32(400, dirty);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(dirty + dirty * LV_REFR_JOIN_OVERDRAW / 100, redrawn);
+}
+
+void test_refr_damage_overlapping_areas_are_counted_once(void)
+{
+    inv_area(0, 0, 99, 99);
+    inv_area(50, 0, 149, 99);
+    lv_refr_now(NULL);
+
+    uint32_t redrawn;
+    uint32_t dirty;
+    lv_refr_get_damage_px(NULL, &redrawn, &dirty);
+    TEST_ASSERT_EQUAL_UINT32(150 * 100, dirty);
+    TEST_ASSERT_EQUAL_UINT32(150 * 100, redrawn);
+}
+
+void test_refr_damage_overflow_does_not_redraw_the_screen(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    uint32_t scr_size = lv_display_get_horizontal_resolution(disp) * lv_display_get_vertical_resolution(disp);
+
+    /*Far more small areas than LV_INV_BUF_SIZE on a grid*/
+    uint32_t cnt = 0;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < 480 - 8; y += 40) {
+        for(x = 0; x < 800 - 8; x += 40) {
+            inv_area(x, y, x + 7, y + 7);
+            cnt++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(LV_INV_BUF_SIZE, cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_INV_BUF_SIZE, disp->inv_p);
+
+    lv_refr_now(NULL);
+
+    uint32_t redrawn;
+    uint32_t dirty;
+    lv_refr_get_damage_px(NULL, &redrawn, &dirty);
+    TEST_ASSERT_EQUAL_UINT32(cnt * 64, dirty);
+    TEST_ASSERT_LESS_THAN_UINT32(scr_size / 2, redrawn);
+}
+
+#endif
@@ -0,0 +1,181 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#if LV_REFR_OCCLUDER_MAX
+
+#include "unity/unity.h"
+
+static uint32_t draw_main_cnt;
+static lv_area_t draw_main_clip;
+
+void setUp(void)
+{
+    lv_refr_enable_occlusion(true);
+}
+
+void tearDown(void)
+{
+    lv_refr_enable_occlusion(true);
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+}
+
+static void draw_main_event_cb(lv_event_t * e)
+{
+    lv_layer_t * layer = lv_event_get_layer(e);
+    draw_main_cnt++;
+    draw_main_clip = layer->_clip_area;
+}
+
+static lv_obj_t * panel_create(lv_obj_t * parent, int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(color), 0);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+/*Redraw the whole screen and return the number of pixels covered by the draw tasks*/
+static uint32_t redraw(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    uint32_t px_cnt = lv_draw_get_task_px_count();
+    lv_refr_now(NULL);
+    return lv_draw_get_task_px_count() - px_cnt;
+}
+
+void test_refr_occlusion_skips_hidden_widgets(void)
+{
+    lv_obj_t * behind = lv_button_create(lv_screen_active());
+    lv_obj_set_pos(behind, 50, 50);
+    lv_obj_add_event_cb(behind, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*Covers the button with its shadow, but not the whole screen*/
+    panel_create(lv_screen_active(), 0, 0, 400, 300, 0x305080);
+
+    draw_main_cnt = 0;
+    redraw();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_main_cnt);
+
+    lv_refr_enable_occlusion(false);
+    redraw();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+}
+
+void test_refr_occlusion_clips_partially_hidden_widgets(void)
+{
+    lv_obj_t * behind = panel_create(lv_screen_active(), 100, 100, 200, 200, 0xff0000);
+    lv_obj_add_event_cb(behind, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*Covers the top half of the panel in its full width*/
+    panel_create(lv_screen_active(), 50, 50, 300, 150, 0x00ff00);
+
+    draw_main_cnt = 0;
+    redraw();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_INT32(100, draw_main_clip.x1);
+    TEST_ASSERT_EQUAL_INT32(200, draw_main_clip.y1);
+    TEST_ASSERT_EQUAL_INT32(299, draw_main_clip.x2);
+    TEST_ASSERT_EQUAL_INT32(299, draw_main_clip.y2);
+}
+
+void test_refr_occlusion_draws_around_opaque_children(void)
+{
+    lv_obj_t * parent = panel_create(lv_screen_active(), 100, 100, 400, 300, 0xff0000);
+    panel_create(parent, 50, 50, 300, 200, 0x0000ff);
+
+    /*The parent only above, left, right and below the child*/
+    uint32_t culled_px = redraw();
+
+    /*The screen behind the parent and the parent behind the child*/
+    lv_refr_enable_occlusion(false);
+    uint32_t normal_px = redraw();
+    TEST_ASSERT_EQUAL_UINT32(400 * 300 + 300 * 200, normal_px - culled_px);
+}
+
+void test_refr_occlusion_sends_the_draw_events_once(void)
+{
+    lv_obj_t * parent = panel_create(lv_screen_active(), 100, 100, 400, 300, 0xff0000);
+    lv_obj_add_event_cb(parent, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    panel_create(parent, 50, 50, 300, 200, 0x0000ff);
+
+    /*The handler can't be called for each piece around the child*/
+    draw_main_cnt = 0;
+    redraw();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_INT32(100, draw_main_clip.y1);
+    TEST_ASSERT_EQUAL_INT32(399, draw_main_clip.y2);
+}
+
+void test_refr_occlusion_ignores_transparent_widgets(void)
+{
+    lv_obj_t * behind = panel_create(lv_screen_active(), 100, 100, 50, 50, 0xff0000);
+    lv_obj_add_event_cb(behind, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_t * semi_transp = panel_create(lv_screen_active(), 0, 0, 400, 300, 0x00ff00);
+    lv_obj_set_style_bg_opa(semi_transp, LV_OPA_50, 0);
+
+    lv_obj_t * opa_parent = panel_create(lv_screen_active(), 0, 0, 400, 300, 0x0000ff);
+    lv_obj_set_style_opa(opa_parent, LV_OPA_50, 0);
+    panel_create(opa_parent, 0, 0, 400, 300, 0x00ffff);
+
+    lv_obj_t * rotated = panel_create(lv_screen_active(), 0, 0, 400, 300, 0xffff00);
+    lv_obj_set_style_transform_rotation(rotated, 10, 0);
+
+    draw_main_cnt = 0;
+    redraw();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_INT32(100, draw_main_clip.x1);
+    TEST_ASSERT_EQUAL_INT32(149, draw_main_clip.y2);
+}
+
+void test_refr_occlusion_renders_the_same(void)
+{
+    /*Overlapping cards, rounded and scrolled panels with text*/
+    lv_obj_t * cont = panel_create(lv_screen_active(), 20, 20, 500, 400, 0x202020);
+    lv_obj_t * card = lv_obj_create(cont);
+    lv_obj_set_size(card, 300, 200);
+    lv_obj_set_pos(card, 30, 30);
+    lv_obj_set_style_radius(card, 20, 0);
+    lv_label_set_text(lv_label_create(card), "Card behind");
+
+    lv_obj_t * scrolled = panel_create(cont, 150, 100, 300, 250, 0x405060);
+    lv_obj_t * list = lv_label_create(scrolled);
+    lv_label_set_text(list, "line 1\nline 2\nline 3\nline 4\nline 5\nline 6\nline 7\nline 8\nline 9\nline 10\nline 11");
+    lv_obj_scroll_to_y(scrolled, 40, LV_ANIM_OFF);
+
+    lv_obj_t * rounded = panel_create(lv_screen_active(), 400, 200, 300, 200, 0x806040);
+    lv_obj_set_style_radius(rounded, 40, 0);
+    lv_obj_t * btn = lv_button_create(lv_screen_active());
+    lv_obj_set_pos(btn, 380, 180);
+    lv_obj_set_size(btn, 100, 50);
+
+    /*A full width header and a dialog hiding the card*/
+    lv_obj_t * header = panel_create(lv_screen_active(), 0, 0, 800, 40, 0x101010);
+    lv_label_set_text(lv_label_create(header), "Header");
+    lv_obj_t * dialog = panel_create(lv_screen_active(), 30, 30, 360, 260, 0x606060);
+    lv_obj_set_style_radius(dialog, 10, 0);
+    lv_label_set_text(lv_label_create(dialog), "Dialog");
+
+    uint32_t culled_px = redraw();
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    uint32_t data_size = buf->header.stride * buf->header.h;
+    uint8_t * culled = lv_malloc(data_size);
+    TEST_ASSERT_NOT_NULL(culled);
+    lv_memcpy(culled, buf->data, data_size);
+
+    lv_refr_enable_occlusion(false);
+    uint32_t normal_px = redraw();
+
+    TEST_ASSERT_EQUAL_MEMORY(buf->data, culled, data_size);
+    TEST_ASSERT_LESS_THAN_UINT32(normal_px, culled_px);
+    lv_free(culled);
+}
+
+#endif
+
+#endif
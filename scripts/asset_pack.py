@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Chuyển PNG sang ảnh LVGL đúng định dạng của màn hình lúc build và gộp vào
+# một file pack có index, app mmap read-only lúc khởi động (src/asset_pack.h).
+#
+#   scripts/asset_pack.py -o build/bin/assets.pack [--depth 16] [--cf AUTO]
+#                         [--compress NONE|RLE|LZ4] [--align 1] img1.png img2.png ...
+#
+# - Tên ảnh là tên file bỏ .png (EEZ tìm ảnh theo tên này)
+# - --cf AUTO: RGB565 / RGB565A8 (PNG có alpha) khi depth 16,
+#   XRGB8888 / ARGB8888 khi depth 32. Đặt cf trong tên file để ép từng ảnh:
+#   logo.RGB565A8.png
+# - Khối nén chỉ được giữ khi nhỏ hơn ảnh gốc; ảnh không nén vẽ thẳng từ page cache
+# Cần pypng và lz4 (lvgl/scripts/prerequisites-pip.txt).
+#
+# Định dạng (little endian, khớp với src/asset_pack.c):
+#   header  magic "LVAP", version, count, index_offset   (4 x uint32)
+#   index   count x { char name[56]; uint32 offset; uint32 size }, sắp xếp theo name
+#   ảnh     file .bin của LVGL: lv_image_header_t 12 byte + pixel (hoặc khối nén),
+#           pixel bắt đầu ở offset chia hết cho --data-align
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "lvgl", "scripts"))
+import png  # noqa: E402
+from LVGLImage import (ColorFormat, CompressMethod, LVGLCompressData,  # noqa: E402
+                       LVGLImage, LVGLImageHeader)
+
+MAGIC = b"LVAP"
+VERSION = 1
+HEADER_FMT = "<4sIII"
+ENTRY_FMT = "<56sII"
+NAME_MAX = 56
+IMAGE_HEADER_SIZE = 12
+FLAG_COMPRESSED = 0x08
+
+
+def image_name(path):
+    """logo.RGB565A8.png -> logo"""
+    parts = os.path.basename(path).split(".")
+    parts = [p for p in parts[:-1] if p not in ColorFormat.__members__]
+    return ".".join(parts)
+
+
+def pick_cf(path, cf, depth):
+    for p in os.path.basename(path).split(".")[1:-1]:
+        if p in ColorFormat.__members__:
+            return ColorFormat[p]
+    if cf != "AUTO":
+        return ColorFormat[cf]
+
+    has_alpha = png.Reader(filename=path).asDirect()[3]["alpha"]
+    if depth == 16:
+        return ColorFormat.RGB565A8 if has_alpha else ColorFormat.RGB565
+    return ColorFormat.ARGB8888 if has_alpha else ColorFormat.XRGB8888
+
+
+def convert(path, cf, compress, align):
+    img = LVGLImage().from_png(path, cf)
+    img.adjust_stride(align=align)
+
+    data = img.data
+    flags = 0
+    if compress != CompressMethod.NONE:
+        packed = LVGLCompressData(img.cf, compress, img.data).compressed
+        # Nén không lợi thì để nguyên, vẽ thẳng từ mmap
+        if len(packed) < len(data):
+            data = packed
+            flags |= FLAG_COMPRESSED
+
+    header = LVGLImageHeader(img.cf, img.w, img.h, img.stride, flags=flags)
+    return img, bytes(header.binary) + bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack PNGs as native LVGL images")
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("--depth", type=int, choices=(16, 32), default=16,
+                        help="LV_COLOR_DEPTH of the display")
+    parser.add_argument("--cf", default="AUTO",
+                        choices=["AUTO", "RGB565", "RGB565A8", "XRGB8888", "ARGB8888"])
+    parser.add_argument("--compress", default="NONE", choices=["NONE", "RLE", "LZ4"])
+    parser.add_argument("--align", type=int, default=1, help="LV_DRAW_BUF_STRIDE_ALIGN")
+    parser.add_argument("--data-align", type=int, default=64,
+                        help="alignment of the pixel data in the pack, at least LV_DRAW_BUF_ALIGN")
+    parser.add_argument("images", nargs="*")
+    args = parser.parse_args()
+
+    images = {}
+    for path in args.images:
+        name = image_name(path)
+        if len(name.encode()) >= NAME_MAX:
+            sys.exit(f"{path}: name longer than {NAME_MAX - 1} bytes")
+        if name in images:
+            sys.exit(f"{path}: duplicate image name '{name}'")
+        images[name] = path
+
+    names = sorted(images, key=lambda n: n.encode())
+    header_size = struct.calcsize(HEADER_FMT)
+    pos = header_size + len(names) * struct.calcsize(ENTRY_FMT)
+
+    index = b""
+    blobs = b""
+    total_raw = 0
+    for name in names:
+        path = images[name]
+        cf = pick_cf(path, args.cf, args.depth)
+        img, blob = convert(path, cf, CompressMethod[args.compress], args.align)
+
+        # Pixel (sau header 12 byte) phải thẳng hàng để vẽ trực tiếp
+        offset = pos + (-(pos + IMAGE_HEADER_SIZE)) % args.data_align
+        blobs += b"\0" * (offset - pos) + blob
+        pos = offset + len(blob)
+        index += struct.pack(ENTRY_FMT, name.encode(), offset, len(blob))
+
+        total_raw += img.data_len
+        print(f"  {name}: {img.w}x{img.h} {img.cf.name} {len(blob)} bytes")
+
+    with open(args.output, "wb") as f:
+        f.write(struct.pack(HEADER_FMT, MAGIC, VERSION, len(names), header_size))
+        f.write(index)
+        f.write(blobs)
+
+    print(f"{args.output}: {len(names)} images, {pos} bytes ({total_raw} bytes of pixels)")
+
+
+if __name__ == "__main__":
+    main()
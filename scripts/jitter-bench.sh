@@ -0,0 +1,61 @@
+#!/usr/bin/env bash
+# So sánh jitter với thread plan tắt/bật (THREAD_PLAN=0 / THREAD_PLAN=1).
+#
+#   scripts/jitter-bench.sh [seconds] [uart_loopback_dev]
+#
+# - jitter_bench: độ trễ đánh thức thread UI và độ trễ UART loopback (nối TX-RX)
+# - APP (mặc định ~/deploy/lvglsim): nếu có thì chạy app, lấy dump frame stats
+#   bằng SIGUSR2 và tính độ lệch khoảng cách frame / thời gian render
+# LOAD=1 (mặc định) chạy thêm tải CPU trên tất cả các nhân trong lúc đo.
+set -u
+
+SECS="${1:-20}"
+UART_DEV="${2:-}"
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+BENCH="${BENCH:-$SCRIPT_DIR/../build/bin/jitter_bench}"
+APP="${APP:-$HOME/deploy/lvglsim}"
+LOAD="${LOAD:-1}"
+
+load_pids=()
+start_load(){
+  [[ "$LOAD" == "1" ]] || return 0
+  for _ in $(seq "$(nproc)"); do
+    ( while :; do :; done ) & load_pids+=($!)
+  done
+}
+stop_load(){
+  for p in "${load_pids[@]}"; do kill "$p" 2>/dev/null; done
+  wait "${load_pids[@]}" 2>/dev/null
+  load_pids=()
+}
+trap stop_load EXIT
+
+frame_summary(){
+  # Đọc cột theo tên ở dòng header (frame_stats.c), không phụ thuộc thứ tự cột
+  awk -F, 'NR==1 { for(i=1;i<=NF;i++) col[$i]=i; t=col["tick_ms"]; ru=col["render_us"]; next }
+           NR>2 { d=$t-prev; n++; s+=d; ss+=d*d; if(d>m) m=d; r+=$ru; rr+=$ru*$ru; if($ru>rm) rm=$ru }
+           { prev=$t }
+           END { if(n==0) { print "  frames: no samples"; exit }
+                 a=s/n; ra=r/n
+                 printf "  frame interval avg %.2f ms stddev %.2f max %d ms | render avg %.2f ms stddev %.2f max %.2f ms (n=%d)\n",
+                        a, sqrt(ss/n-a*a), m, ra/1000, sqrt(rr/n-ra*ra)/1000, rm/1000, n }' "$1"
+}
+
+for plan in 0 1; do
+  echo "=== THREAD_PLAN=$plan ==="
+  start_load
+  if [[ -x "$BENCH" ]]; then
+    THREAD_PLAN=$plan "$BENCH" -d "$SECS" ${UART_DEV:+-u "$UART_DEV"}
+  else
+    echo "  jitter_bench not found at $BENCH"
+  fi
+  if [[ -x "$APP" ]]; then
+    prefix="/tmp/jitter_plan$plan"
+    THREAD_PLAN=$plan FRAME_STATS_DUMP="$prefix" "$APP" >/dev/null 2>&1 & app=$!
+    sleep "$SECS"
+    kill -USR2 "$app"; sleep 1
+    kill -TERM "$app"; wait "$app" 2>/dev/null
+    [[ -f "$prefix.csv" ]] && frame_summary "$prefix.csv"
+  fi
+  stop_load
+done
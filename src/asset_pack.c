@@ -0,0 +1,157 @@
+#include "asset_pack.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Định dạng file, khớp với scripts/asset_pack.py (little endian) */
+#define PACK_MAGIC      0x5041564Cu     /* "LVAP" */
+#define PACK_VERSION    1
+#define PACK_NAME_MAX   56
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t index_offset;
+} pack_header_t;
+
+typedef struct {
+    char name[PACK_NAME_MAX];   /* kết thúc bằng NUL, index sắp xếp theo name */
+    uint32_t offset;            /* ảnh .bin của LVGL: lv_image_header_t + pixel (hoặc khối nén) */
+    uint32_t size;
+} pack_entry_t;
+
+static const uint8_t *s_base;
+static size_t s_size;
+static const pack_entry_t *s_index;
+static uint32_t s_count;
+static lv_image_dsc_t *s_dscs;  /* song song với s_index, data = NULL nếu ảnh hỏng */
+
+/* Trả về -1 nếu đường dẫn không vừa buf */
+static int default_path(char *buf, size_t len)
+{
+    /* assets.pack nằm cạnh file chạy (CMake build ra build/bin/) */
+    static const char name[] = "assets.pack";
+    ssize_t n = readlink("/proc/self/exe", buf, len - 1);
+    if(n <= 0) n = 0;
+    else if((size_t)n >= len - 1) return -1;
+    buf[n] = '\0';
+    char *slash = strrchr(buf, '/');
+    size_t dir_len = slash ? (size_t)(slash - buf) + 1 : 0;
+    if(dir_len + sizeof(name) > len) return -1;
+    memcpy(buf + dir_len, name, sizeof(name));
+    return 0;
+}
+
+/* Kiểm tra một ảnh và trỏ descriptor vào vùng mmap, không copy pixel */
+static int load_entry(const pack_entry_t *e, lv_image_dsc_t *dsc)
+{
+    if(e->name[PACK_NAME_MAX - 1] != '\0') return -1;
+    if(e->size < sizeof(lv_image_header_t) || e->offset > s_size || e->size > s_size - e->offset) return -1;
+
+    const uint8_t *p = s_base + e->offset;
+    memcpy(&dsc->header, p, sizeof(lv_image_header_t));
+    if(dsc->header.magic != LV_IMAGE_HEADER_MAGIC) return -1;
+
+    dsc->data = p + sizeof(lv_image_header_t);
+    dsc->data_size = e->size - sizeof(lv_image_header_t);
+
+    /* Khối nén được bin decoder giải nén vào image cache, tự kiểm tra kích thước */
+    if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) return 0;
+
+    if((uintptr_t)dsc->data % LV_DRAW_BUF_ALIGN) return -1;
+    uint64_t need = (uint64_t)dsc->header.stride * dsc->header.h;
+    if(dsc->header.cf == LV_COLOR_FORMAT_RGB565A8) need += dsc->header.stride / 2 * dsc->header.h;
+    if(dsc->data_size < need) return -1;
+    return 0;
+}
+
+int asset_pack_init(void)
+{
+    /* static: PATH_MAX trên stack vượt giới hạn -Wstack-usage, init chỉ chạy một lần */
+    static char path[PATH_MAX];
+    const char *env = getenv("ASSET_PACK");
+    if(env && *env == '\0') return 0;
+    if(env ? snprintf(path, sizeof(path), "%s", env) >= (int)sizeof(path) : default_path(path, sizeof(path)) != 0) {
+        printf("[assets] pack path too long\n");
+        return env ? -1 : 0;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+        /* Không có pack ở chỗ mặc định thì chỉ dùng ảnh biên dịch sẵn */
+        if(env || errno != ENOENT) printf("[assets] cannot open %s: %s\n", path, strerror(errno));
+        return env ? -1 : 0;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(pack_header_t)) {
+        printf("[assets] %s: too short\n", path);
+        close(fd);
+        return -1;
+    }
+
+    /* MAP_SHARED read-only: pixel nằm luôn trong page cache, không tốn heap */
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(base == MAP_FAILED) {
+        printf("[assets] mmap %s failed: %s\n", path, strerror(errno));
+        return -1;
+    }
+    madvise(base, (size_t)st.st_size, MADV_WILLNEED);
+
+    const pack_header_t *h = (const pack_header_t *)base;
+    size_t size = (size_t)st.st_size;
+    if(h->magic != PACK_MAGIC || h->version != PACK_VERSION || h->index_offset > size ||
+       h->count > (size - h->index_offset) / sizeof(pack_entry_t) || h->index_offset % 4) {
+        printf("[assets] %s: not an asset pack (version %u)\n", path, PACK_VERSION);
+        munmap(base, size);
+        return -1;
+    }
+
+    lv_image_dsc_t *dscs = calloc(h->count ? h->count : 1, sizeof(lv_image_dsc_t));
+    if(!dscs) {
+        munmap(base, size);
+        return -1;
+    }
+
+    s_base = base;
+    s_size = size;
+    s_index = (const pack_entry_t *)(s_base + h->index_offset);
+    s_count = h->count;
+    s_dscs = dscs;
+
+    uint32_t bad = 0;
+    for(uint32_t i = 0; i < s_count; i++) {
+        if(load_entry(&s_index[i], &s_dscs[i]) != 0) {
+            printf("[assets] %.*s: invalid image, skipped\n", PACK_NAME_MAX, s_index[i].name);
+            memset(&s_dscs[i], 0, sizeof(lv_image_dsc_t));
+            bad++;
+        }
+    }
+
+    printf("[assets] %s: %u images, %zu KiB mapped\n", path, s_count - bad, s_size / 1024);
+    return (int)(s_count - bad);
+}
+
+static int cmp_entry(const void *key, const void *elem)
+{
+    return strncmp((const char *)key, ((const pack_entry_t *)elem)->name, PACK_NAME_MAX);
+}
+
+const lv_image_dsc_t *asset_pack_get(const char *name)
+{
+    if(!s_index || !name) return NULL;
+
+    const pack_entry_t *e = bsearch(name, s_index, s_count, sizeof(pack_entry_t), cmp_entry);
+    if(!e) return NULL;
+
+    const lv_image_dsc_t *dsc = &s_dscs[e - s_index];
+    return dsc->data ? dsc : NULL;
+}
@@ -0,0 +1,39 @@
+/**
+ * Asset pack: images converted at build time by scripts/asset_pack.py to the
+ * display's native color format (RGB565, RGB565A8, XRGB8888...) and packed
+ * into one indexed file. The file is mmapped read-only at startup, so
+ * uncompressed images are drawn straight from the page cache with no decode
+ * and no heap; RLE/LZ4 compressed ones are decompressed by the LVGL bin
+ * decoder into the image cache. EEZ looks images up by name in the pack first;
+ * the screens built by create_screens() inside ui_init() still use the
+ * compiled-in images[] (they reference the descriptors directly).
+ *
+ * Env:
+ *   ASSET_PACK=<path>     pack file (default assets.pack next to the executable, "" = off)
+ */
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include "lvgl/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* mmap pack, gọi sau lv_init().
+ * Trả về số ảnh, 0 khi không có pack, -1 khi file hỏng */
+int asset_pack_init(void);
+
+/* Ảnh theo tên (tên file PNG bỏ .png), NULL nếu không có trong pack */
+const lv_image_dsc_t *asset_pack_get(const char *name);
+
+/* Gắn hook tìm ảnh theo tên của EEZ, gọi sau ui_init(): eez_flow_init() đặt lại hook.
+ * Định nghĩa trong asset_pack_eez.cpp (hook của EEZ nằm trong namespace C++) */
+void asset_pack_install_eez_hook(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASSET_PACK_H */
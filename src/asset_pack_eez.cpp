@@ -0,0 +1,19 @@
+#include "asset_pack.h"
+#include "ui/eez-flow.h"
+
+/* Hook cũ (tìm trong bảng images[] của EEZ), dùng khi ảnh không có trong pack */
+static const void *(*s_prev_hook)(const char *name) = nullptr;
+
+static const void *get_image_by_name(const char *name)
+{
+    const lv_image_dsc_t *dsc = asset_pack_get(name);
+    if(dsc) return dsc;
+    return s_prev_hook ? s_prev_hook(name) : nullptr;
+}
+
+extern "C" void asset_pack_install_eez_hook(void)
+{
+    if(s_prev_hook) return;
+    s_prev_hook = eez::flow::getLvglImageByNameHook;
+    eez::flow::getLvglImageByNameHook = get_image_by_name;
+}
@@ -0,0 +1,261 @@
+#include "frame_stats.h"
+#include "lvgl/src/draw/sw/lv_draw_sw.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#include <inttypes.h>
+
+/* Số frame gần nhất dùng cho giá trị trung bình/max trên overlay */
+#define OVERLAY_WINDOW   60
+#define OVERLAY_PERIOD_MS 500
+
+static frame_stats_rec_t s_ring[FRAME_STATS_RING];
+static uint32_t s_count = 0;          /* tổng số frame đã ghi (vị trí = s_count % RING) */
+
+/* Trạng thái frame đang refresh */
+static frame_stats_rec_t s_cur;
+static uint64_t s_refr_start_us = 0;
+static uint64_t s_flush_start_us = 0;
+static uint64_t s_wait_start_us = 0;
+static uint32_t s_task_cnt_start = 0;
+static uint32_t s_task_px_start = 0;
+static uint32_t s_shadow_hit_start = 0;
+static uint32_t s_shadow_miss_start = 0;
+static uint32_t s_img_hit_start = 0;
+static uint32_t s_img_miss_start = 0;
+static uint32_t s_img_evict_start = 0;
+static uint32_t s_ui_tick_acc_us = 0;
+
+static lv_obj_t *s_overlay = NULL;
+static lv_timer_t *s_overlay_timer = NULL;
+static const char *s_dump_prefix = "/tmp/frame_stats";
+
+/* Cờ đặt từ signal handler, xử lý trong thread LVGL */
+static volatile sig_atomic_t s_req_toggle = 0;
+static volatile sig_atomic_t s_req_dump = 0;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/* Bộ đếm cộng dồn của shadow cache, 0 nếu tắt LV_DRAW_SW_SHADOW_CACHE_SIZE hoặc LV_DRAW_SW_COMPLEX */
+static void shadow_cache_stats(uint32_t *hit, uint32_t *miss)
+{
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX && LV_DRAW_SW_SHADOW_CACHE_SIZE
+    lv_draw_sw_shadow_cache_get_stats(hit, miss);
+#else
+    *hit = 0;
+    *miss = 0;
+#endif
+}
+
+static void on_sigusr(int signum)
+{
+    if(signum == SIGUSR1) s_req_toggle = 1;
+    else if(signum == SIGUSR2) s_req_dump = 1;
+}
+
+static void disp_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    uint64_t t = now_us();
+
+    switch(code) {
+    case LV_EVENT_REFR_START:
+        s_refr_start_us = t;
+        s_cur.render_us = 0;
+        s_cur.flush_us = 0;
+        s_cur.area_px = 0;
+        s_cur.tick_ms = lv_tick_get();
+        s_task_cnt_start = lv_draw_get_task_created_count();
+        s_task_px_start = lv_draw_get_task_px_count();
+        shadow_cache_stats(&s_shadow_hit_start, &s_shadow_miss_start);
+        lv_image_cache_get_stats(&s_img_hit_start, &s_img_miss_start, &s_img_evict_start);
+        break;
+    case LV_EVENT_FLUSH_START: {
+        const lv_area_t *a = (const lv_area_t *)lv_event_get_param(e);
+        if(a) s_cur.area_px += (uint32_t)lv_area_get_size(a);
+        s_flush_start_us = t;
+        break;
+    }
+    case LV_EVENT_FLUSH_FINISH:
+        s_cur.flush_us += (uint32_t)(t - s_flush_start_us);
+        break;
+    case LV_EVENT_FLUSH_WAIT_START:
+        s_wait_start_us = t;
+        break;
+    case LV_EVENT_FLUSH_WAIT_FINISH:
+        s_cur.flush_us += (uint32_t)(t - s_wait_start_us);
+        break;
+    case LV_EVENT_REFR_READY: {
+        /* Bỏ qua các lần refresh không có vùng nào cần vẽ */
+        if(s_cur.area_px == 0 || s_refr_start_us == 0) break;
+        uint32_t total = (uint32_t)(t - s_refr_start_us);
+        s_cur.render_us = total > s_cur.flush_us ? total - s_cur.flush_us : 0;
+        s_cur.draw_tasks = lv_draw_get_task_created_count() - s_task_cnt_start;
+        s_cur.draw_px = lv_draw_get_task_px_count() - s_task_px_start;
+        shadow_cache_stats(&s_cur.shadow_hit, &s_cur.shadow_miss);
+        s_cur.shadow_hit -= s_shadow_hit_start;
+        s_cur.shadow_miss -= s_shadow_miss_start;
+        lv_image_cache_get_stats(&s_cur.img_hit, &s_cur.img_miss, &s_cur.img_evict);
+        s_cur.img_hit -= s_img_hit_start;
+        s_cur.img_miss -= s_img_miss_start;
+        s_cur.img_evict -= s_img_evict_start;
+        lv_refr_get_damage_px(lv_event_get_target(e), NULL, &s_cur.dirty_px);
+        s_cur.ui_tick_us = s_ui_tick_acc_us;
+        s_cur.seq = s_count;
+        s_ui_tick_acc_us = 0;
+        s_ring[s_count % FRAME_STATS_RING] = s_cur;
+        s_count++;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static void overlay_update(lv_timer_t *timer)
+{
+    (void)timer;
+    if(!s_overlay || s_count == 0) return;
+
+    uint32_t n = s_count < OVERLAY_WINDOW ? s_count : OVERLAY_WINDOW;
+    uint64_t sum_r = 0, sum_f = 0, sum_u = 0, sum_px = 0, sum_dirty = 0, sum_t = 0, sum_draw = 0;
+    uint64_t sum_sh_hit = 0, sum_sh_miss = 0;
+    uint64_t sum_img_hit = 0, sum_img_miss = 0, sum_img_evict = 0;
+    uint32_t max_r = 0, max_f = 0, fps = 0;
+    uint32_t now = lv_tick_get();
+    for(uint32_t i = 0; i < n; i++) {
+        const frame_stats_rec_t *r = &s_ring[(s_count - 1 - i) % FRAME_STATS_RING];
+        sum_r += r->render_us; sum_f += r->flush_us; sum_u += r->ui_tick_us;
+        sum_px += r->area_px; sum_dirty += r->dirty_px; sum_t += r->draw_tasks; sum_draw += r->draw_px;
+        sum_sh_hit += r->shadow_hit; sum_sh_miss += r->shadow_miss;
+        sum_img_hit += r->img_hit; sum_img_miss += r->img_miss; sum_img_evict += r->img_evict;
+        if(r->render_us > max_r) max_r = r->render_us;
+        if(r->flush_us > max_f) max_f = r->flush_us;
+        if(now - r->tick_ms < 1000) fps++;
+    }
+
+    /* snprintf của libc: lv_snprintf có thể không hỗ trợ %f */
+    char buf[288];
+    snprintf(buf, sizeof(buf),
+             "fps %" PRIu32 "\n"
+             "render %.2f / %.2f ms\n"
+             "flush  %.2f / %.2f ms\n"
+             "ui_tick %.2f ms\n"
+             "area %u px  dirty %u px\n"
+             "tasks %u  overdraw %.2f\n"
+             "shadow hit %.0f%% (%u/%u)\n"
+             "img hit %.0f%% (%u/%u)  evict %u",
+             fps,
+             (double)sum_r / n / 1000.0, (double)max_r / 1000.0,
+             (double)sum_f / n / 1000.0, (double)max_f / 1000.0,
+             (double)sum_u / n / 1000.0,
+             (unsigned)(sum_px / n), (unsigned)(sum_dirty / n), (unsigned)(sum_t / n),
+             sum_px ? (double)sum_draw / sum_px : 0.0,
+             sum_sh_hit + sum_sh_miss ? 100.0 * (double)sum_sh_hit / (double)(sum_sh_hit + sum_sh_miss) : 0.0,
+             (unsigned)sum_sh_hit, (unsigned)(sum_sh_hit + sum_sh_miss),
+             sum_img_hit + sum_img_miss ? 100.0 * (double)sum_img_hit / (double)(sum_img_hit + sum_img_miss) : 0.0,
+             (unsigned)sum_img_hit, (unsigned)(sum_img_hit + sum_img_miss), (unsigned)sum_img_evict);
+    lv_label_set_text(s_overlay, buf);
+}
+
+void frame_stats_init(lv_display_t *disp)
+{
+    if(!disp) return;
+
+    lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_REFR_READY, NULL);
+    lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_FLUSH_START, NULL);
+    lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_FLUSH_FINISH, NULL);
+    lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_FLUSH_WAIT_START, NULL);
+    lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_FLUSH_WAIT_FINISH, NULL);
+
+    const char *p = getenv("FRAME_STATS_DUMP");
+    if(p && *p) s_dump_prefix = p;
+
+    signal(SIGUSR1, on_sigusr);
+    signal(SIGUSR2, on_sigusr);
+
+    p = getenv("FRAME_STATS_OVERLAY");
+    if(p && *p == '1') frame_stats_set_overlay(1);
+}
+
+void frame_stats_add_ui_tick(uint32_t us)
+{
+    s_ui_tick_acc_us += us;
+}
+
+void frame_stats_set_overlay(int enable)
+{
+    if(enable && !s_overlay) {
+        /* Đặt trên sys layer để luôn nằm trên mọi screen/popup */
+        s_overlay = lv_label_create(lv_layer_sys());
+        lv_obj_set_style_bg_color(s_overlay, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(s_overlay, LV_OPA_70, 0);
+        lv_obj_set_style_text_color(s_overlay, lv_color_make(0x40, 0xff, 0x40), 0);
+        lv_obj_set_style_pad_all(s_overlay, 6, 0);
+        lv_obj_align(s_overlay, LV_ALIGN_TOP_RIGHT, -8, 8);
+        lv_label_set_text(s_overlay, "frame stats...");
+        s_overlay_timer = lv_timer_create(overlay_update, OVERLAY_PERIOD_MS, NULL);
+    }
+    else if(!enable && s_overlay) {
+        lv_timer_delete(s_overlay_timer);
+        s_overlay_timer = NULL;
+        lv_obj_delete(s_overlay);
+        s_overlay = NULL;
+    }
+}
+
+void frame_stats_poll(void)
+{
+    if(s_req_toggle) {
+        s_req_toggle = 0;
+        frame_stats_set_overlay(s_overlay == NULL);
+    }
+    if(s_req_dump) {
+        s_req_dump = 0;
+        int n = frame_stats_dump(s_dump_prefix);
+        printf("[frame_stats] dumped %d frames to %s.{csv,json}\n", n, s_dump_prefix);
+        fflush(stdout);
+    }
+}
+
+int frame_stats_dump(const char *prefix)
+{
+    char path[256];
+    uint32_t n = s_count < FRAME_STATS_RING ? s_count : FRAME_STATS_RING;
+    uint32_t first = s_count - n;
+
+    snprintf(path, sizeof(path), "%s.csv", prefix);
+    FILE *csv = fopen(path, "w");
+    if(!csv) return -1;
+    snprintf(path, sizeof(path), "%s.json", prefix);
+    FILE *json = fopen(path, "w");
+    if(!json) { fclose(csv); return -1; }
+
+    fprintf(csv, "seq,tick_ms,render_us,flush_us,ui_tick_us,area_px,dirty_px,draw_tasks,draw_px,shadow_hit,shadow_miss,img_hit,img_miss,img_evict\n");
+    fprintf(json, "[\n");
+    for(uint32_t i = 0; i < n; i++) {
+        const frame_stats_rec_t *r = &s_ring[(first + i) % FRAME_STATS_RING];
+        fprintf(csv, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32
+                ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\n",
+                r->seq, r->tick_ms, r->render_us, r->flush_us, r->ui_tick_us, r->area_px, r->dirty_px, r->draw_tasks,
+                r->draw_px, r->shadow_hit, r->shadow_miss, r->img_hit, r->img_miss, r->img_evict);
+        fprintf(json, "  {\"seq\":%" PRIu32 ",\"tick_ms\":%" PRIu32 ",\"render_us\":%" PRIu32
+                ",\"flush_us\":%" PRIu32 ",\"ui_tick_us\":%" PRIu32 ",\"area_px\":%" PRIu32
+                ",\"dirty_px\":%" PRIu32 ",\"draw_tasks\":%" PRIu32 ",\"draw_px\":%" PRIu32
+                ",\"shadow_hit\":%" PRIu32 ",\"shadow_miss\":%" PRIu32
+                ",\"img_hit\":%" PRIu32 ",\"img_miss\":%" PRIu32 ",\"img_evict\":%" PRIu32 "}%s\n",
+                r->seq, r->tick_ms, r->render_us, r->flush_us, r->ui_tick_us, r->area_px, r->dirty_px, r->draw_tasks,
+                r->draw_px, r->shadow_hit, r->shadow_miss, r->img_hit, r->img_miss, r->img_evict, i + 1 < n ? "," : "");
+    }
+    fprintf(json, "]\n");
+    fclose(csv);
+    fclose(json);
+    return (int)n;
+}
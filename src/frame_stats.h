@@ -0,0 +1,61 @@
+/**
+ * Frame timing statistics (render/flush/ui_tick) with on-screen overlay
+ * and CSV/JSON dump, for profiling on the target without a debugger.
+ *
+ * Env:
+ *   FRAME_STATS_OVERLAY=1      show the overlay from start
+ *   FRAME_STATS_DUMP=<prefix>  dump path prefix (default /tmp/frame_stats)
+ * Signals:
+ *   SIGUSR1  toggle overlay
+ *   SIGUSR2  write <prefix>.csv and <prefix>.json
+ */
+
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <stdint.h>
+#include "lvgl/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Số frame giữ lại trong ring buffer */
+#define FRAME_STATS_RING 512
+
+typedef struct {
+    uint32_t seq;         /* số thứ tự frame */
+    uint32_t tick_ms;     /* lv_tick_get() lúc bắt đầu refresh */
+    uint32_t render_us;   /* refresh trừ thời gian flush */
+    uint32_t flush_us;    /* flush_cb + chờ flush */
+    uint32_t ui_tick_us;  /* ui_tick() (eez_flow_tick + tick_screen) từ frame trước */
+    uint32_t area_px;     /* tổng số pixel đã flush */
+    uint32_t dirty_px;    /* số pixel thực sự bị invalidate (area_px - dirty_px = vẽ thừa do gộp vùng) */
+    uint32_t draw_tasks;  /* số draw task tạo trong frame */
+    uint32_t draw_px;     /* tổng pixel của các draw task (draw_px / area_px = overdraw) */
+    uint32_t shadow_hit;  /* số shadow lấy góc blur từ cache */
+    uint32_t shadow_miss; /* số shadow phải blur lại góc */
+    uint32_t img_hit;     /* số ảnh lấy từ image cache */
+    uint32_t img_miss;    /* số ảnh phải decode lại */
+    uint32_t img_evict;   /* số ảnh bị đẩy khỏi image cache */
+} frame_stats_rec_t;
+
+/* Gắn vào display và cài handler SIGUSR1/SIGUSR2 */
+void frame_stats_init(lv_display_t *disp);
+
+/* Cộng dồn thời gian ui_tick cho frame kế tiếp */
+void frame_stats_add_ui_tick(uint32_t us);
+
+/* Gọi trong thread LVGL: xử lý yêu cầu từ signal (overlay, dump) */
+void frame_stats_poll(void);
+
+void frame_stats_set_overlay(int enable);
+
+/* Ghi ring buffer ra <prefix>.csv và <prefix>.json, trả về số frame đã ghi hoặc -1 */
+int frame_stats_dump(const char *prefix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAME_STATS_H */
@@ -0,0 +1,75 @@
+#include "image_prefetch.h"
+#include <stdlib.h>
+
+typedef enum {
+    ACT_PREFETCH,
+    ACT_PIN,
+    ACT_UNPIN,
+} act_t;
+
+typedef struct {
+    act_t act;
+    uint32_t cached;    /* số ảnh đã nằm trong cache */
+} walk_ctx_t;
+
+static int s_enabled = 1;
+
+static void handle_src(walk_ctx_t *ctx, const void *src)
+{
+    /* Symbol là font, không qua decoder */
+    lv_image_src_t type = lv_image_src_get_type(src);
+    if(type != LV_IMAGE_SRC_FILE && type != LV_IMAGE_SRC_VARIABLE) return;
+
+    switch(ctx->act) {
+    case ACT_PREFETCH:
+        if(lv_image_cache_prefetch(src) == LV_RESULT_OK) ctx->cached++;
+        break;
+    case ACT_PIN:
+        if(lv_image_cache_pin(src) == LV_RESULT_OK) ctx->cached++;
+        break;
+    case ACT_UNPIN:
+        lv_image_cache_unpin(src);
+        break;
+    }
+}
+
+static lv_obj_tree_walk_res_t walk_cb(lv_obj_t *obj, void *user_data)
+{
+    walk_ctx_t *ctx = (walk_ctx_t *)user_data;
+
+    if(lv_obj_check_type(obj, &lv_image_class)) {
+        const void *src = lv_image_get_src(obj);
+        if(src) handle_src(ctx, src);
+    }
+
+    const void *bg_src = lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN);
+    if(bg_src) handle_src(ctx, bg_src);
+
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+void image_prefetch_init(void)
+{
+    const char *p = getenv("IMG_CACHE_MB");
+    if(p && *p) lv_image_cache_resize((uint32_t)strtoul(p, NULL, 10) * 1024u * 1024u, true);
+
+    p = getenv("IMG_PREFETCH");
+    if(p && atoi(p) == 0) s_enabled = 0;
+}
+
+uint32_t image_prefetch_screen(lv_obj_t *screen, int pin)
+{
+    if(!s_enabled || !screen || !lv_image_cache_is_enabled()) return 0;
+
+    walk_ctx_t ctx = { pin ? ACT_PIN : ACT_PREFETCH, 0 };
+    lv_obj_tree_walk(screen, walk_cb, &ctx);
+    return ctx.cached;
+}
+
+void image_prefetch_unpin_screen(lv_obj_t *screen)
+{
+    if(!screen || !lv_image_cache_is_enabled()) return;
+
+    walk_ctx_t ctx = { ACT_UNPIN, 0 };
+    lv_obj_tree_walk(screen, walk_cb, &ctx);
+}
@@ -0,0 +1,39 @@
+/**
+ * Image prefetch: decode every image a screen refers to (lv_image widgets and
+ * bg_image_src styles) into the LVGL image cache before the screen is shown,
+ * so the first frame after navigation doesn't stall on the PNG decoder.
+ *
+ * Env:
+ *   IMG_CACHE_MB          image cache budget in MiB (default LV_CACHE_DEF_SIZE, 0 = off)
+ *   IMG_PREFETCH=0        don't prefetch at startup / before loading a screen
+ */
+
+#ifndef IMAGE_PREFETCH_H
+#define IMAGE_PREFETCH_H
+
+#include "lvgl/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Đọc IMG_CACHE_MB/IMG_PREFETCH, gọi sau lv_init() */
+void image_prefetch_init(void);
+
+/* Decode trước mọi ảnh của screen vào cache; pin=1 giữ chúng không bị evict
+ * cho tới image_prefetch_unpin_screen. Trả về số ảnh đã nằm trong cache */
+uint32_t image_prefetch_screen(lv_obj_t *screen, int pin);
+
+/* Bỏ pin các ảnh của screen (chúng vẫn ở trong cache tới khi bị evict) */
+void image_prefetch_unpin_screen(lv_obj_t *screen);
+
+/* Định nghĩa trong image_prefetch_eez.cpp: bọc replacePageHook của EEZ để prefetch
+ * ảnh của màn hình trước khi chuyển trang (eez_flow_set_screen/push/pop, action
+ * ChangeScreen). Gọi sau ui_init() vì eez_flow_init() gán lại hook */
+void image_prefetch_install_eez_hook(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMAGE_PREFETCH_H */
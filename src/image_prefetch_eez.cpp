@@ -0,0 +1,20 @@
+#include "image_prefetch.h"
+#include "ui/eez-flow.h"
+
+/* Hook cũ của eez_flow_init(): tạo screen rồi lv_scr_load_anim() */
+static void (*s_prev_hook)(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t delay) = nullptr;
+
+static void replace_page(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t delay)
+{
+    /* pageId bắt đầu từ 1, giống ScreensEnum; screen chưa tạo thì bỏ qua */
+    lv_obj_t *screen = eez::flow::getLvglObjectFromIndexHook(pageId - 1);
+    if(screen) image_prefetch_screen(screen, 0);
+    s_prev_hook(pageId, animType, speed, delay);
+}
+
+extern "C" void image_prefetch_install_eez_hook(void)
+{
+    if(s_prev_hook) return;
+    s_prev_hook = eez::flow::replacePageHook;
+    eez::flow::replacePageHook = replace_page;
+}
@@ -18,6 +18,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <strings.h>
 
 #include "lvgl/lvgl.h"
 #if LV_USE_LINUX_FBDEV
@@ -92,6 +93,21 @@ static lv_display_t *init_fbdev(void)
         return NULL;
     }
 
+    /* LV_LINUX_FBDEV_RENDER_CF=RGB565: render 16 bpp and convert on flush for 32 bpp framebuffers */
+    if (strcasecmp(getenv_default("LV_LINUX_FBDEV_RENDER_CF", "NATIVE"), "RGB565") == 0) {
+        lv_linux_fbdev_set_render_format(disp, LV_COLOR_FORMAT_RGB565);
+    }
+
+    /* LV_LINUX_FBDEV_TILE_SIZE=<bytes>: render theo tile vừa L2 (0: cả buffer),
+     * LV_LINUX_FBDEV_TILE_AUTO=0/1: đo vài cỡ tile lúc chạy và giữ cỡ nhanh nhất */
+    const char *tile_size = getenv("LV_LINUX_FBDEV_TILE_SIZE");
+    const char *tile_auto = getenv("LV_LINUX_FBDEV_TILE_AUTO");
+    if (tile_size != NULL || tile_auto != NULL) {
+        lv_linux_fbdev_set_tile_size(disp,
+                                     tile_size ? (uint32_t)strtoul(tile_size, NULL, 0) : LV_LINUX_FBDEV_TILE_SIZE,
+                                     tile_auto ? atoi(tile_auto) != 0 : LV_LINUX_FBDEV_TILE_AUTO);
+    }
+
     lv_linux_fbdev_set_file(disp, device);
 
     return disp;
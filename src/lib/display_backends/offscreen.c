@@ -0,0 +1,377 @@
+/**
+ * @file offscreen.c
+ *
+ * Headless backend rendering into a memory framebuffer
+ *
+ * Needs no display hardware, compositor or X server so the real UI can
+ * be run and benchmarked in containers and CI. The framebuffer is a memfd
+ * (an anonymous mapping if memfd is not available) and frames can be
+ * dumped to PNG or raw files.
+ *
+ * Env:
+ *   LV_SIM_OFFSCREEN_CF          RGB565 (default), RGB888, XRGB8888, ARGB8888
+ *   LV_SIM_OFFSCREEN_DUMP        path prefix of the dumped frames, e.g. /tmp/frame
+ *                                writes /tmp/frame_00060.png (default: no dump)
+ *   LV_SIM_OFFSCREEN_DUMP_FMT    png (default, needs LV_USE_LODEPNG) or raw
+ *   LV_SIM_OFFSCREEN_DUMP_EVERY  dump every Nth frame (default 60)
+ *
+ * The resolution is taken from -W/-H (or LV_SIM_WINDOW_WIDTH/HEIGHT).
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _GNU_SOURCE
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "lvgl/lvgl.h"
+#if LV_USE_LODEPNG
+#include "lvgl/src/libs/lodepng/lodepng.h"
+#endif
+#include "../simulator_util.h"
+#include "../simulator_settings.h"
+#include "../backends.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint8_t *fb;                /* The memory framebuffer */
+    size_t fb_size;
+    uint32_t stride;
+    uint32_t px_size;
+    int32_t hor_res;
+    int32_t ver_res;
+    lv_color_format_t cf;
+    uint32_t frame_cnt;
+    const char *dump_prefix;
+    bool dump_png;
+    uint32_t dump_every;
+} offscreen_t;
+
+/**********************
+ *  EXTERNAL VARIABLES
+ **********************/
+extern simulator_settings_t settings;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_display_t *init_offscreen(void);
+static void run_loop_offscreen(void);
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+static uint8_t *alloc_fb(size_t size);
+static uint32_t tick_get_cb(void);
+static lv_color_format_t cf_from_env(void);
+static void dump_frame(void);
+#if LV_USE_LODEPNG
+static int dump_png(const char *path);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static char *backend_name = "OFFSCREEN";
+static offscreen_t offscreen;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register the backend
+ *
+ * @param backend the backend descriptor
+ * @description configures the descriptor
+ */
+int backend_init_offscreen(backend_t *backend)
+{
+    LV_ASSERT_NULL(backend);
+
+    backend->handle->display = malloc(sizeof(display_backend_t));
+    LV_ASSERT_NULL(backend->handle->display);
+
+    backend->handle->display->init_display = init_offscreen;
+    backend->handle->display->run_loop = run_loop_offscreen;
+    backend->name = backend_name;
+    backend->type = BACKEND_DISPLAY;
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the offscreen display
+ *
+ * @return the LVGL display
+ */
+static lv_display_t *init_offscreen(void)
+{
+    offscreen_t *o = &offscreen;
+    const char *fmt;
+    size_t draw_buf_size;
+    uint8_t *draw_buf;
+    uint8_t *draw_buf_2;
+    lv_display_t *disp;
+
+    o->hor_res = settings.window_width;
+    o->ver_res = settings.window_height;
+    if (o->hor_res <= 0 || o->ver_res <= 0) {
+        LV_LOG_ERROR("Invalid offscreen resolution %" LV_PRId32 "x%" LV_PRId32, o->hor_res, o->ver_res);
+        return NULL;
+    }
+
+    o->cf = cf_from_env();
+    o->px_size = lv_color_format_get_size(o->cf);
+    o->stride = o->hor_res * o->px_size;
+    o->fb_size = (size_t)o->stride * o->ver_res;
+    o->fb = alloc_fb(o->fb_size);
+    if (o->fb == NULL) {
+        return NULL;
+    }
+
+    o->dump_prefix = getenv("LV_SIM_OFFSCREEN_DUMP");
+    if (o->dump_prefix != NULL && *o->dump_prefix == '\0') {
+        o->dump_prefix = NULL;
+    }
+    fmt = getenv_default("LV_SIM_OFFSCREEN_DUMP_FMT", "png");
+    o->dump_png = strcasecmp(fmt, "raw") != 0;
+#if !LV_USE_LODEPNG
+    if (o->dump_png && o->dump_prefix != NULL) {
+        LV_LOG_WARN("PNG dump needs LV_USE_LODEPNG, dumping raw frames");
+    }
+    o->dump_png = false;
+#endif
+    o->dump_every = atoi(getenv_default("LV_SIM_OFFSCREEN_DUMP_EVERY", "60"));
+    if (o->dump_every == 0) {
+        o->dump_every = 1;
+    }
+
+    disp = lv_display_create(o->hor_res, o->ver_res);
+    if (disp == NULL) {
+        return NULL;
+    }
+    lv_display_set_color_format(disp, o->cf);
+
+    /* No driver ticks LVGL here, without a tick source only the first frame is rendered */
+    lv_tick_set_cb(tick_get_cb);
+
+    /* Same buffering as the fbdev backend so the render cost is comparable */
+    draw_buf_size = lv_draw_buf_width_to_stride(o->hor_res, o->cf) * o->ver_res;
+    draw_buf = malloc(draw_buf_size);
+    draw_buf_2 = malloc(draw_buf_size);
+    if (draw_buf == NULL || draw_buf_2 == NULL) {
+        free(draw_buf);
+        free(draw_buf_2);
+        lv_display_delete(disp);
+        return NULL;
+    }
+    lv_display_set_buffers(disp, draw_buf, draw_buf_2, draw_buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    LV_LOG_USER("Offscreen %" LV_PRId32 "x%" LV_PRId32 ", %u bytes per pixel%s%s",
+                o->hor_res, o->ver_res, (unsigned)o->px_size,
+                o->dump_prefix ? ", dumping to " : "", o->dump_prefix ? o->dump_prefix : "");
+
+    return disp;
+}
+
+/**
+ * The run loop of the offscreen driver
+ */
+static void run_loop_offscreen(void)
+{
+    uint32_t idle_time;
+
+    /* Handle LVGL tasks */
+    while (true) {
+
+        /* Returns the time to the next timer execution */
+        idle_time = lv_timer_handler();
+        usleep(idle_time * 1000);
+    }
+}
+
+/**
+ * Copy a rendered area to the memory framebuffer
+ */
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    offscreen_t *o = &offscreen;
+    uint32_t src_stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), o->cf);
+    size_t row_size = (size_t)lv_area_get_width(area) * o->px_size;
+    const uint8_t *src = px_map;
+    uint8_t *dst = o->fb + (size_t)area->y1 * o->stride + (size_t)area->x1 * o->px_size;
+    int32_t y;
+
+    for (y = area->y1; y <= area->y2; y++) {
+        memcpy(dst, src, row_size);
+        dst += o->stride;
+        src += src_stride;
+    }
+
+    if (lv_display_flush_is_last(disp)) {
+        o->frame_cnt++;
+        if (o->dump_prefix != NULL && o->frame_cnt % o->dump_every == 0) {
+            dump_frame();
+        }
+    }
+
+    lv_display_flush_ready(disp);
+}
+
+/**
+ * Tick source of LVGL, the same as the fbdev driver's
+ */
+static uint32_t tick_get_cb(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    uint64_t time_ms = t.tv_sec * 1000 + (t.tv_nsec / 1000000);
+    return time_ms;
+}
+
+/**
+ * Allocate the framebuffer, in a memfd so it can be inspected from
+ * /proc/<pid>/fd while the UI runs
+ */
+static uint8_t *alloc_fb(size_t size)
+{
+    void *p = MAP_FAILED;
+    int fd = memfd_create("lvgl-offscreen", 0);
+
+    if (fd >= 0) {
+        if (ftruncate(fd, (off_t)size) == 0) {
+            p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        if (p == MAP_FAILED) {
+            close(fd);
+        }
+    }
+
+    if (p == MAP_FAILED) {
+        p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if (p == MAP_FAILED) {
+        LV_LOG_ERROR("Failed to allocate a %zu byte offscreen framebuffer", size);
+        return NULL;
+    }
+
+    return p;
+}
+
+/**
+ * Get the color format from LV_SIM_OFFSCREEN_CF
+ */
+static lv_color_format_t cf_from_env(void)
+{
+    const char *name = getenv_default("LV_SIM_OFFSCREEN_CF", "RGB565");
+
+    if (strcasecmp(name, "RGB565") == 0) {
+        return LV_COLOR_FORMAT_RGB565;
+    } else if (strcasecmp(name, "RGB888") == 0) {
+        return LV_COLOR_FORMAT_RGB888;
+    } else if (strcasecmp(name, "XRGB8888") == 0) {
+        return LV_COLOR_FORMAT_XRGB8888;
+    } else if (strcasecmp(name, "ARGB8888") == 0) {
+        return LV_COLOR_FORMAT_ARGB8888;
+    }
+
+    LV_LOG_WARN("Unsupported LV_SIM_OFFSCREEN_CF %s, using RGB565", name);
+    return LV_COLOR_FORMAT_RGB565;
+}
+
+/**
+ * Write the current framebuffer content to <prefix>_<frame>.png or .raw
+ */
+static void dump_frame(void)
+{
+    offscreen_t *o = &offscreen;
+    char path[512];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s_%05u.%s", o->dump_prefix, (unsigned)o->frame_cnt,
+             o->dump_png ? "png" : "raw");
+
+#if LV_USE_LODEPNG
+    if (o->dump_png) {
+        if (dump_png(path) != 0) {
+            LV_LOG_WARN("Failed to write %s", path);
+        }
+        return;
+    }
+#endif
+
+    f = fopen(path, "wb");
+    if (f == NULL || fwrite(o->fb, 1, o->fb_size, f) != o->fb_size) {
+        LV_LOG_WARN("Failed to write %s", path);
+    }
+    if (f != NULL) {
+        fclose(f);
+    }
+}
+
+#if LV_USE_LODEPNG
+/**
+ * Convert the framebuffer to RGB888 and encode it as PNG
+ */
+static int dump_png(const char *path)
+{
+    offscreen_t *o = &offscreen;
+    uint8_t *rgb = malloc((size_t)o->hor_res * o->ver_res * 3);
+    uint8_t *dst = rgb;
+    int32_t x;
+    int32_t y;
+    unsigned err;
+
+    if (rgb == NULL) {
+        return -1;
+    }
+
+    for (y = 0; y < o->ver_res; y++) {
+        const uint8_t *row = o->fb + (size_t)y * o->stride;
+        for (x = 0; x < o->hor_res; x++) {
+            if (o->cf == LV_COLOR_FORMAT_RGB565) {
+                uint16_t c = ((const uint16_t *)row)[x];
+                dst[0] = (uint8_t)(((c >> 11) & 0x1F) * 255 / 31);
+                dst[1] = (uint8_t)(((c >> 5) & 0x3F) * 255 / 63);
+                dst[2] = (uint8_t)((c & 0x1F) * 255 / 31);
+            } else {
+                /* RGB888 and (X|A)RGB8888 are stored as B, G, R(, A) */
+                const uint8_t *px = row + (size_t)x * o->px_size;
+                dst[0] = px[2];
+                dst[1] = px[1];
+                dst[2] = px[0];
+            }
+            dst += 3;
+        }
+    }
+
+    err = lodepng_encode24_file(path, rgb, o->hor_res, o->ver_res);
+    free(rgb);
+
+    return err ? -1 : 0;
+}
+#endif
@@ -84,6 +84,9 @@ backend_init_t available_backends[] = {
     backend_init_glfw3,
 #endif
 
+    /* Memory framebuffer, needs no display - always available */
+    backend_init_offscreen,
+
 #if LV_USE_EVDEV
     backend_init_evdev,
 #endif
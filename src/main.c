@@ -26,9 +26,11 @@
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <linux/fb.h>
+#include <time.h>
 
 #include "lvgl/lvgl.h"
 #include "lvgl/demos/lv_demos.h"
+#include "lvgl/src/draw/sw/lv_draw_sw.h"
 
 #include "src/lib/driver_backends.h"
 #include "src/lib/simulator_util.h"
@@ -36,10 +38,18 @@
 #include <pthread.h>
 #include "ui/ui.h"
 #include "ui/actions.h"
+#include "ui/screens.h"
 #include "msp_service.h"
 #include "common/buzzer_api.h"
 #include "uartx.h"
 #include "msp_service.h"
+#include "frame_stats.h"
+#include "ui_watchdog.h"
+#include "thread_plan.h"
+#include "startup_prof.h"
+#include "vsync_pacer.h"
+#include "image_prefetch.h"
+#include "asset_pack.h"
 
 /* Internal functions */
 static void configure_simulator(int argc, char **argv);
@@ -49,8 +59,12 @@ static void cleanup_and_black_screen(void);
 static void on_signal(int signum);
 static void *lvgl_thread(void *arg);
 static int write_fb_blank(int value);
-static void clear_framebuffer(void);
+static void screen_blank(void);
+static void screen_wake(void);
+static int fb_retain_io(int restore);
+static uint64_t now_us(void);
 static void indev_wake_event_cb(lv_event_t * e);
+static void *msp_init_thread(void *arg);
 /* MSP service (giao tiếp CPU chính) */
 static struct msp_service *s_msp = NULL;
 
@@ -77,7 +91,12 @@ static int s_beep_freq = 1800;
 static int s_beep_ms   = 80;
 /* Wake coordination */
 static volatile int s_wake_requested = 0;
-static volatile int s_refresh_frames = 0;
+/* Thời điểm chạm đánh thức (us, CLOCK_MONOTONIC) để đo touch→frame */
+static volatile uint64_t s_wake_touch_us = 0;
+/* Bản sao frame cuối khi blank (bật bằng SCREEN_WAKE_RETAIN=1) cho driver làm mất nội dung fb */
+static int s_wake_retain = 0;
+static uint8_t *s_retain_buf = NULL;
+static size_t s_retain_size = 0;
 static unsigned int s_idle_timeout_ms = 2*60000; /* default 60s, có thể override bằng SCREEN_IDLE_MS */
 
 /* UART test glue: removed */
@@ -102,6 +121,7 @@ static void print_usage(void)
     fprintf(stdout, "\nlvglsim [-V] [-B] [-b backend_name] [-W window_width] [-H window_height]\n\n");
     fprintf(stdout, "-V print LVGL version\n");
     fprintf(stdout, "-B list supported backends\n");
+    fprintf(stdout, "-b OFFSCREEN renders into memory without a display (see src/lib/display_backends/offscreen.c)\n");
     fprintf(stdout, "-C serial (COM3|COM4|/dev/ttySx) [default COM3→/dev/ttyS2]\n");
     fprintf(stdout, "-U baudrate [default 115200]\n");
 }
@@ -212,25 +232,94 @@ int main(int argc, char **argv)
     signal(SIGTERM, on_signal);
 
     /* Initialize LVGL. */
+    int ph = startup_phase_begin("lv_init");
     lv_init();
+    startup_phase_end(ph);
+
+    /* DRAW_THREADS=n: số thread render song song các band của draw task lớn,
+     * 1 = tắt (mặc định LV_DRAW_SW_BAND_THREAD_CNT trong lv_conf.h) */
+    {
+        const char *p = getenv("DRAW_THREADS");
+        if(p && *p) lv_draw_sw_set_band_thread_count((uint32_t)strtoul(p, NULL, 10));
+    }
+
+    /* Thread render của LVGL (lv_thread_init đặt tên) theo role "draw" của THREAD_PLAN */
+    thread_plan_apply_named("draw", "swdraw");
+    thread_plan_apply_named("draw", "swband");
+
+    /* IMG_CACHE_MB / IMG_PREFETCH: xem image_prefetch.h */
+    image_prefetch_init();
+
+    /* ASSET_PACK: ảnh đã chuyển sẵn sang định dạng màn hình lúc build, mmap read-only */
+    ph = startup_phase_begin("asset pack");
+    int asset_cnt = asset_pack_init();
+    startup_phase_end(ph);
 
     /* Initialize the configured backend */
+    ph = startup_phase_begin("display backend");
     if (driver_backends_init_backend(selected_backend) == -1) {
         die("Failed to initialize display backend");
     }
+    startup_phase_end(ph);
+
+    /* Khởi tạo MSP service (CPU chính) song song với evdev/ui_init:
+     * mở UART + hub không gọi API LVGL nên chạy được ở thread riêng */
+    pthread_t th_msp;
+    int msp_async = (pthread_create(&th_msp, NULL, msp_init_thread, NULL) == 0);
+    if(!msp_async) msp_init_thread(NULL);
 
     /* Enable for EVDEV support */
 #if LV_USE_EVDEV
+    ph = startup_phase_begin("evdev");
     if (driver_backends_init_backend("EVDEV") == -1) {
         die("Failed to initialize evdev");
     }
+    startup_phase_end(ph);
 #endif
 
     /* EEZ UI: khởi tạo trước khi bắt đầu vòng lặp tick */
+    ph = startup_phase_begin("ui_init");
     ui_init();
+    startup_phase_end(ph);
+
+    /* Sau ui_init(): eez_flow_init() ghi đè hook tìm ảnh theo tên */
+    if(asset_cnt > 0) asset_pack_install_eez_hook();
+    image_prefetch_install_eez_hook();
+
+    /* Ảnh của màn hình main được pin trong cache, các màn hình khác decode trước
+     * để frame đầu tiên sau khi chuyển trang không phải chờ decode PNG */
+    ph = startup_phase_begin("image prefetch");
+    image_prefetch_screen(objects.main, 1);
+    image_prefetch_screen(objects.page_test1, 0);
+    startup_phase_end(ph);
+
+#if LV_USE_OBJ_RENDER_CACHE
+    /* RENDER_CACHE=0: tắt cache render cho phần tĩnh của màn hình main (bàn phím, tiêu đề).
+     * Khi thứ khác vẽ đè lên (con trỏ chuột, overlay thống kê...) chỉ cần blit lại từ cache */
+    {
+        const char *p = getenv("RENDER_CACHE");
+        if(p == NULL || atoi(p) != 0) {
+            lv_obj_add_flag(objects.obj1, LV_OBJ_FLAG_RENDER_CACHE);
+            lv_obj_add_flag(objects.lbtxt, LV_OBJ_FLAG_RENDER_CACHE);
+        }
+    }
+#endif
+    /* REFR_OCCLUSION=0: vẽ cả các widget bị che bởi widget đục phía trên (để so overdraw trên overlay) */
+    {
+        const char *p = getenv("REFR_OCCLUSION");
+        if(p && atoi(p) == 0) lv_refr_enable_occlusion(false);
+    }
+    startup_watch_first_frame(lv_display_get_default());
 
-    /* Khởi tạo MSP service (CPU chính) */
-    s_msp = create_msp_service();
+    /* Thống kê thời gian frame: overlay bật/tắt bằng SIGUSR1, dump CSV/JSON bằng SIGUSR2 */
+    frame_stats_init(lv_display_get_default());
+
+#if LV_USE_LINUX_FBDEV
+    /* VSYNC_PACE=1: render theo vblank thay cho refresh timer 33ms (xem vsync_pacer.h) */
+    if(selected_backend == NULL || strcmp(selected_backend, "FBDEV") == 0) {
+        vsync_pacer_start(lv_display_get_default());
+    }
+#endif
 
     /* UART test bridge removed */
 
@@ -252,6 +341,12 @@ int main(int argc, char **argv)
         if(p && *p) s_beep_ms = (int)strtol(p, NULL, 10);
     }
 
+    /* Khoá bộ nhớ sau khi draw buffer/UI đã cấp phát (THREAD_PLAN, xem thread_plan.h) */
+    thread_plan_lock_memory();
+
+    /* Action của UI gửi qua event hub tới MSP service: chờ khởi tạo xong trước khi chạy thread UI */
+    if(msp_async) pthread_join(th_msp, NULL);
+
     /* Tự tạo thread tick để vừa xử lý LVGL vừa gọi ui_tick();
      * Không dùng driver_backends_run_loop vì nó chạy lv_timer_handler() vô hạn
      * và không gọi ui_tick() của EEZ. */
@@ -259,6 +354,8 @@ int main(int argc, char **argv)
     if(pthread_create(&th_ui, NULL, lvgl_thread, NULL) != 0) {
         die("Failed to create LVGL thread\n");
     }
+    /* Watchdog cho thread LVGL: log backtrace + component flow khi bị treo quá UI_WDT_MS */
+    ui_watchdog_start(th_ui);
     /* Đọc timeout từ env nếu có */
     {
         const char *idle_env = getenv("SCREEN_IDLE_MS");
@@ -266,6 +363,8 @@ int main(int argc, char **argv)
             unsigned long v = strtoul(idle_env, NULL, 10);
             if(v >= 1000 && v <= 24UL*60*60*1000UL) s_idle_timeout_ms = (unsigned int)v;
         }
+        const char *retain_env = getenv("SCREEN_WAKE_RETAIN");
+        s_wake_retain = (retain_env && *retain_env == '1');
     }
 
     /* Chờ thread LVGL kết thúc (sẽ kết thúc khi nhận tín hiệu) */
@@ -277,23 +376,32 @@ int main(int argc, char **argv)
     return 0;
 }
 
+static void *msp_init_thread(void *arg)
+{
+    (void)arg;
+    int ph = startup_phase_begin("msp_service (uart)");
+    s_msp = create_msp_service();
+    startup_phase_end(ph);
+    return NULL;
+}
+
 static void *lvgl_thread(void *arg)
 {
     (void)arg;
     uint32_t last_dim_check = 0;
+    thread_plan_apply("ui");
     while(!exit_flag) {
+        uint64_t t_tick = now_us();
         ui_tick();
+        frame_stats_add_ui_tick((uint32_t)(now_us() - t_tick));
+        frame_stats_poll();
         /* lv_timer_handler trả về thời gian tới lần gọi tiếp theo (ms) */
         uint32_t idle = lv_timer_handler();
-        /* Yêu cầu refresh sau unblank sẽ invalidate trong thread an toàn */
-        if(s_refresh_frames > 0) {
-            lv_display_t *disp = lv_display_get_default();
-            if(disp == NULL) disp = lv_display_get_next(NULL);
-            if(disp) {
-                lv_obj_t *scr = lv_display_get_screen_active(disp);
-                if(scr) lv_obj_invalidate(scr);
-            }
-            s_refresh_frames--;
+
+        /* Đánh thức ngay khi callback chạm yêu cầu, không chờ chu kỳ kiểm tra 200ms */
+        if(s_is_blank && s_wake_requested) {
+            screen_wake();
+            idle = 0;
         }
 
         /* Kiểm tra inactivity/blank mỗi ~200ms trong cùng thread để tránh race */
@@ -307,35 +415,85 @@ static void *lvgl_thread(void *arg)
                 /* Kiểm tra lần nữa ngay trước khi tắt để hủy nếu vừa có tương tác */
                 uint32_t recheck = lv_display_get_inactive_time(NULL);
                 if(recheck + s_cancel_window_ms >= s_idle_timeout_ms) {
-                    /* Dùng 1 (blank) thay vì 4 (powerdown) để tránh rủi ro với mmap của fbdev */
-                    if(write_fb_blank(1) == 0) {
-                        s_is_blank = 1;
-                        /* UART test bridge removed */
-                        /* screen blanked */
-                    }
+                    screen_blank();
                 }
             }
 
-            /* Đánh thức theo yêu cầu từ callback hoặc nếu LVGL báo có hoạt động */
-            if(s_is_blank && (s_wake_requested || inactive < 200)) {
-                if(write_fb_blank(0) == 0) {
-                    s_is_blank = 0;
-                    s_wake_requested = 0;
-                    /* Làm tươi lại framebuffer/screen để tránh vùng đen */
-                    clear_framebuffer();
-                    lv_display_trigger_activity(NULL);
-                    s_refresh_frames = 3; /* sẽ invalidate ở trên */
-                    /* UART test bridge removed */
-                    /* screen unblanked */
-                }
+            /* LVGL báo có hoạt động (không qua callback chạm) cũng đánh thức */
+            if(s_is_blank && inactive < 200) {
+                screen_wake();
             }
             /* UART test bridge removed */
         }
-        usleep(idle * 1000);
+        ui_watchdog_beat(idle);
+        if(vsync_pacer_enabled()) vsync_pacer_sleep(idle, !s_is_blank);
+        else usleep(idle * 1000);
     }
     return NULL;
 }
 
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/* Tắt màn hình: dừng refresh timer, LVGL chỉ tích luỹ vùng invalid trong lúc ngủ */
+static void screen_blank(void)
+{
+    /* Giữ bản sao frame đang hiển thị (chỉ cần với driver làm mất nội dung fb khi blank) */
+    if(s_wake_retain) (void)fb_retain_io(0);
+    /* Dùng 1 (blank) thay vì 4 (powerdown) để tránh rủi ro với mmap của fbdev */
+    if(write_fb_blank(1) != 0) return;
+    s_is_blank = 1;
+
+    lv_display_t *disp = lv_display_get_default();
+    if(disp) {
+        lv_timer_t *refr = lv_display_get_refr_timer(disp);
+        if(refr) lv_timer_pause(refr);
+    }
+    /* UART test bridge removed */
+    /* screen blanked */
+}
+
+/* Bật lại màn hình: frame cuối vẫn còn trong fb (hoặc khôi phục từ bản sao),
+ * chỉ vẽ lại các vùng đã đổi trong lúc ngủ rồi mới unblank */
+static void screen_wake(void)
+{
+    uint64_t t_touch = s_wake_touch_us ? s_wake_touch_us : now_us();
+
+    if(s_wake_retain) (void)fb_retain_io(1);
+
+    /* Vẽ ngay vùng invalid tích luỹ, không chờ chu kỳ refresh tiếp theo
+     * (lv_refr_now chạy được cả khi refresh timer đang dừng) */
+    lv_display_t *disp = lv_display_get_default();
+    if(disp) {
+        if(vsync_pacer_enabled()) vsync_pacer_refr_now();
+        else lv_refr_now(disp);
+    }
+    if(write_fb_blank(0) != 0) {
+        /* Unblank lỗi: vẫn blank, refresh timer vẫn dừng. Bỏ yêu cầu chạm để vòng lặp
+         * không gọi lại liên tục, lần chạm/hoạt động tiếp theo sẽ thử lại */
+        s_wake_requested = 0;
+        return;
+    }
+
+    if(disp) {
+        lv_timer_t *refr = lv_display_get_refr_timer(disp);
+        if(refr) lv_timer_resume(refr);
+        lv_display_trigger_activity(disp);
+    }
+    s_is_blank = 0;
+    s_wake_requested = 0;
+    s_wake_touch_us = 0;
+    printf("[wake] touch -> first frame %.2f ms%s\n",
+           (double)(now_us() - t_touch) / 1000.0, s_wake_retain ? " (retained copy)" : "");
+    fflush(stdout);
+    /* UART test bridge removed */
+    /* screen unblanked */
+}
+
 /* dim_thread đã được hợp nhất vào lvgl_thread để đảm bảo thread-safety cho các API LVGL */
 
 /* Ghi vào sysfs để blank/unblank fb0: 0=unblank, 4=powerdown */
@@ -352,24 +510,35 @@ static int write_fb_blank(int value)
     return rc < 0 ? -1 : 0;
 }
 
-/* Xoá nội dung fb về 0 để tránh lưu ảnh cũ khi bật lại */
-static void clear_framebuffer(void)
+/* Lưu (restore=0) hoặc khôi phục (restore=1) vùng fb đang hiển thị.
+ * Bộ đệm cấp phát một lần và dùng lại, không còn ghi cả fb bằng 0 khi bật lại */
+static int fb_retain_io(int restore)
 {
-    int fb = open("/dev/fb0", O_RDWR);
-    if(fb < 0) return;
+    const char *fb_path = getenv("LV_LINUX_FBDEV_DEVICE");
+    if(!fb_path || fb_path[0] == '\0') fb_path = "/dev/fb0";
+
+    int fb = open(fb_path, O_RDWR);
+    if(fb < 0) return -1;
     struct fb_var_screeninfo vinfo;
     struct fb_fix_screeninfo finfo;
     if(ioctl(fb, FBIOGET_FSCREENINFO, &finfo) < 0 || ioctl(fb, FBIOGET_VSCREENINFO, &vinfo) < 0) {
         close(fb);
-        return;
+        return -1;
     }
     size_t screen_size = (size_t)finfo.line_length * (size_t)vinfo.yres;
-    void *zero_buf = calloc(1, screen_size);
-    if(zero_buf) {
-        (void)write(fb, zero_buf, screen_size);
-        free(zero_buf);
+    off_t offset = (off_t)finfo.line_length * (off_t)vinfo.yoffset;
+    ssize_t rc = -1;
+    if(!restore) {
+        if(s_retain_size != screen_size) {
+            uint8_t *nb = (uint8_t *)realloc(s_retain_buf, screen_size);
+            if(nb) { s_retain_buf = nb; s_retain_size = screen_size; }
+        }
+        if(s_retain_buf && s_retain_size == screen_size) rc = pread(fb, s_retain_buf, screen_size, offset);
+    } else if(s_retain_buf && s_retain_size == screen_size) {
+        rc = pwrite(fb, s_retain_buf, screen_size, offset);
     }
     close(fb);
+    return rc == (ssize_t)screen_size ? 0 : -1;
 }
 
 /* Chặn PRESS đầu tiên để đánh thức: không bung xuống widget khi đang ngủ */
@@ -378,6 +547,7 @@ static void indev_wake_event_cb(lv_event_t * e)
     if(!s_is_blank) return; /* màn hình đang bật → không can thiệp */
 
     /* Chỉ đặt cờ yêu cầu wake, xử lý toàn bộ trong thread LVGL để an toàn */
+    if(!s_wake_requested) s_wake_touch_us = now_us();
     s_wake_requested = 1;
 
     /* Không dừng xử lý/không reset input trong callback để tránh crash */
@@ -417,7 +587,8 @@ static void cleanup_and_black_screen(void)
         return;
     }
 
-    ssize_t written = write(fb, zero_buf, screen_size);
+    /* Ghi vào trang đang hiển thị (yoffset != 0 khi fbdev lật trang) */
+    ssize_t written = pwrite(fb, zero_buf, screen_size, (off_t)finfo.line_length * (off_t)vinfo.yoffset);
     (void)written;
     free(zero_buf);
     close(fb);
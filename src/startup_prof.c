@@ -0,0 +1,121 @@
+#include "startup_prof.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define MAX_PHASES 16
+
+typedef struct {
+    const char *name;
+    uint64_t begin_us;
+    uint64_t end_us;    /* 0: chưa xong */
+} startup_phase_t;
+
+static startup_phase_t s_phases[MAX_PHASES];
+static int s_phase_cnt = 0;
+static uint64_t s_t0_us = 0;          /* lần gọi đầu tiên (≈ đầu main) */
+static uint64_t s_first_frame_us = 0;
+static int s_printed = 0;
+static pthread_mutex_t s_mu = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/* Thời gian từ lúc process được tạo (exec, nạp thư viện) tới đầu main, theo /proc/self/stat */
+static long process_age_ms(void)
+{
+    FILE *f = fopen("/proc/self/stat", "r");
+    if(!f) return -1;
+    char buf[1024];
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+    /* Trường 22 (starttime) nằm sau ")" của comm */
+    char *p = strrchr(buf, ')');
+    if(!p) return -1;
+    unsigned long long start_ticks = 0;
+    int field = 2;
+    for(p++; *p && field < 22; p++) {
+        if(*p == ' ') {
+            field++;
+            if(field == 22) start_ticks = strtoull(p + 1, NULL, 10);
+        }
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    long hz = sysconf(_SC_CLK_TCK);
+    if(hz <= 0 || start_ticks == 0) return -1;
+    uint64_t now_ms = (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+    uint64_t start_ms = start_ticks * 1000ULL / (uint64_t)hz;
+    return now_ms > start_ms ? (long)(now_ms - start_ms) : 0;
+}
+
+/* In bảng tổng kết một lần khi đã có frame đầu và không còn phase nào đang chạy (giữ s_mu) */
+static void try_summary_locked(void)
+{
+    if(s_printed || !s_first_frame_us) return;
+    for(int i = 0; i < s_phase_cnt; i++) if(!s_phases[i].end_us) return;
+    s_printed = 1;
+
+    printf("[startup] phase                 start(ms)  dur(ms)\n");
+    for(int i = 0; i < s_phase_cnt; i++) {
+        printf("[startup] %-20s %9.2f %8.2f\n", s_phases[i].name,
+               (double)(s_phases[i].begin_us - s_t0_us) / 1000.0,
+               (double)(s_phases[i].end_us - s_phases[i].begin_us) / 1000.0);
+    }
+    printf("[startup] main -> first frame %.2f ms\n", (double)(s_first_frame_us - s_t0_us) / 1000.0);
+    fflush(stdout);
+}
+
+int startup_phase_begin(const char *name)
+{
+    uint64_t t = now_us();
+    pthread_mutex_lock(&s_mu);
+    if(!s_t0_us) {
+        s_t0_us = t;
+        long age = process_age_ms();
+        if(age >= 0) printf("[startup] process start -> main ~%ld ms\n", age);
+    }
+    int id = -1;
+    if(s_phase_cnt < MAX_PHASES) {
+        id = s_phase_cnt++;
+        s_phases[id].name = name;
+        s_phases[id].begin_us = t;
+        s_phases[id].end_us = 0;
+    }
+    pthread_mutex_unlock(&s_mu);
+    return id;
+}
+
+void startup_phase_end(int id)
+{
+    uint64_t t = now_us();
+    if(id < 0 || id >= MAX_PHASES) return;
+    pthread_mutex_lock(&s_mu);
+    s_phases[id].end_us = t;
+    try_summary_locked();
+    pthread_mutex_unlock(&s_mu);
+}
+
+static void first_flush_cb(lv_event_t *e)
+{
+    lv_display_t *disp = (lv_display_t *)lv_event_get_current_target(e);
+    pthread_mutex_lock(&s_mu);
+    if(!s_first_frame_us) s_first_frame_us = now_us();
+    try_summary_locked();
+    pthread_mutex_unlock(&s_mu);
+    lv_display_remove_event_cb_with_user_data(disp, first_flush_cb, NULL);
+}
+
+void startup_watch_first_frame(lv_display_t *disp)
+{
+    if(!disp) return;
+    lv_display_add_event_cb(disp, first_flush_cb, LV_EVENT_FLUSH_FINISH, NULL);
+}
@@ -0,0 +1,27 @@
+/**
+ * Startup phase profiler: timestamped phases (possibly on different threads)
+ * and a one-shot summary printed once the first frame has been flushed
+ * and every phase has ended.
+ */
+
+#ifndef STARTUP_PROF_H
+#define STARTUP_PROF_H
+
+#include "lvgl/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bắt đầu một phase, trả về id dùng cho startup_phase_end (-1 nếu hết chỗ) */
+int startup_phase_begin(const char *name);
+void startup_phase_end(int id);
+
+/* Theo dõi frame đầu tiên được flush trên display */
+void startup_watch_first_frame(lv_display_t *disp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STARTUP_PROF_H */
@@ -0,0 +1,211 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "thread_plan.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <malloc.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+
+/* Phần stack chạm trước để tránh page fault lần đầu trong thread RT */
+#define STACK_PREFAULT_SIZE (64 * 1024)
+
+typedef struct {
+    const char *role;
+    const char *name;   /* tên hiển thị trong top/perf (tối đa 15 ký tự) */
+    int cpu_first;      /* -1: không đặt affinity */
+    int cpu_last;
+    int prio;           /* 0: SCHED_OTHER, >0: SCHED_FIFO */
+    int logged;         /* đã in cấu hình (thread buzzer được tạo lại mỗi lần beep) */
+} thread_plan_entry_t;
+
+/* Plan mặc định cho H618 4 nhân: cpu0 để kernel/IRQ, UART và UI mỗi thread một nhân riêng */
+static thread_plan_entry_t s_plan[] = {
+    { "ui",     "lv_ui",   3,  3, 50 },
+    { "uart",   "uart_rx", 2,  2, 60 },
+    { "buzzer", "buzzer",  1,  1, 0 },
+    { "wdt",    "ui_wdt",  1,  1, 0 },
+    { "draw",   "lv_draw", 1,  2, 0 },
+    { "vsync",  "vsync",   2,  2, 55 },
+};
+
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+static int s_enabled = 0;
+static int s_mlock = 1;
+
+static thread_plan_entry_t *find_entry(const char *role, size_t len)
+{
+    for(size_t i = 0; i < sizeof(s_plan) / sizeof(s_plan[0]); i++) {
+        if(strlen(s_plan[i].role) == len && strncmp(s_plan[i].role, role, len) == 0) return &s_plan[i];
+    }
+    return NULL;
+}
+
+/* Cú pháp: role=cpus:prio[,role=cpus:prio...] */
+static void parse_overrides(const char *spec)
+{
+    const char *p = spec;
+    while(*p) {
+        const char *eq = strchr(p, '=');
+        if(!eq) break;
+        thread_plan_entry_t *e = find_entry(p, (size_t)(eq - p));
+        char *end;
+        long first = strtol(eq + 1, &end, 10);
+        long last = first;
+        if(*end == '-' && end[1] >= '0' && end[1] <= '9') last = strtol(end + 1, &end, 10);
+        long prio = 0;
+        if(*end == ':') prio = strtol(end + 1, &end, 10);
+        if(e) {
+            e->cpu_first = (int)first;
+            e->cpu_last = (int)(first < 0 ? first : last);
+            e->prio = (int)prio;
+        }
+        else {
+            fprintf(stderr, "[thread_plan] unknown role in THREAD_PLAN: %.*s\n", (int)(eq - p), p);
+        }
+        p = strchr(end, ',');
+        if(!p) break;
+        p++;
+    }
+}
+
+static void plan_init(void)
+{
+    const char *p = getenv("THREAD_PLAN");
+    if(!p || !*p || strcmp(p, "0") == 0) return;
+    s_enabled = 1;
+    if(strcmp(p, "1") != 0) parse_overrides(p);
+
+    p = getenv("THREAD_PLAN_MLOCK");
+    if(p && *p == '0') s_mlock = 0;
+}
+
+int thread_plan_enabled(void)
+{
+    pthread_once(&s_once, plan_init);
+    return s_enabled;
+}
+
+static void prefault_stack(void)
+{
+    volatile unsigned char buf[STACK_PREFAULT_SIZE];
+    memset((void *)buf, 0, sizeof(buf));
+}
+
+/* Affinity + priority cho thread tid (0 = thread đang gọi) */
+static int apply_sched(const thread_plan_entry_t *e, pid_t tid)
+{
+    int rc = 0;
+    if(e->cpu_first >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for(int c = e->cpu_first; c <= e->cpu_last; c++) CPU_SET(c, &set);
+        if(sched_setaffinity(tid, sizeof(set), &set) != 0) {
+            fprintf(stderr, "[thread_plan] %s: affinity %d-%d failed (%s)\n", e->name, e->cpu_first, e->cpu_last,
+                    strerror(errno));
+            rc = -1;
+        }
+    }
+    if(e->prio > 0) {
+        struct sched_param sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = e->prio;
+        if(sched_setscheduler(tid, SCHED_FIFO, &sp) != 0) {
+            /* Thường do thiếu CAP_SYS_NICE/RLIMIT_RTPRIO: vẫn chạy tiếp với SCHED_OTHER */
+            fprintf(stderr, "[thread_plan] %s: SCHED_FIFO %d failed (%s)\n", e->name, e->prio, strerror(errno));
+            rc = -1;
+        }
+    }
+    return rc;
+}
+
+static void log_entry(thread_plan_entry_t *e)
+{
+    if(!e->logged) {
+        e->logged = 1;
+        printf("[thread_plan] %s: cpu %d-%d, %s %d\n", e->name, e->cpu_first, e->cpu_last,
+               e->prio > 0 ? "fifo" : "other", e->prio);
+        fflush(stdout);
+    }
+}
+
+int thread_plan_apply(const char *role)
+{
+    pthread_once(&s_once, plan_init);
+    thread_plan_entry_t *e = find_entry(role, strlen(role));
+    if(!e) return -1;
+
+    pthread_setname_np(pthread_self(), e->name);
+    if(!s_enabled) return 0;
+
+    int rc = apply_sched(e, 0);
+    if(e->prio > 0) prefault_stack();
+    log_entry(e);
+    return rc;
+}
+
+int thread_plan_apply_named(const char *role, const char *thread_name)
+{
+    pthread_once(&s_once, plan_init);
+    thread_plan_entry_t *e = find_entry(role, strlen(role));
+    if(!e || !s_enabled) return 0;
+
+    /* Thread do thư viện tạo (không chạy code của app): tìm theo tên trong /proc */
+    DIR *dir = opendir("/proc/self/task");
+    if(!dir) return 0;
+
+    int cnt = 0;
+    struct dirent *de;
+    while((de = readdir(dir)) != NULL) {
+        if(de->d_name[0] < '0' || de->d_name[0] > '9') continue;
+
+        char path[64];
+        char comm[32] = "";
+        snprintf(path, sizeof(path), "/proc/self/task/%.20s/comm", de->d_name);
+        FILE *f = fopen(path, "r");
+        if(!f) continue;
+        if(!fgets(comm, sizeof(comm), f)) comm[0] = '\0';
+        fclose(f);
+        comm[strcspn(comm, "\n")] = '\0';
+        if(strcmp(comm, thread_name) != 0) continue;
+
+        apply_sched(e, (pid_t)atoi(de->d_name));
+        cnt++;
+    }
+    closedir(dir);
+
+    if(cnt) log_entry(e);
+    return cnt;
+}
+
+int thread_plan_lock_memory(void)
+{
+    pthread_once(&s_once, plan_init);
+    if(!s_enabled || !s_mlock) return 0;
+
+    /* Giữ heap đã cấp phát, không trim/mmap riêng để vùng đã khoá không bị trả lại rồi fault lại */
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    /* MCL_CURRENT nạp sẵn mọi trang hiện có (draw buffer, heap LVGL, stack) */
+    if(mlockall(MCL_CURRENT) != 0) {
+        fprintf(stderr, "[thread_plan] mlockall failed (%s)\n", strerror(errno));
+        return -1;
+    }
+#ifdef MCL_ONFAULT
+    /* Vùng mới (heap tăng thêm, stack thread buzzer tạo mỗi lần beep) chỉ khoá khi chạm tới,
+     * tránh nạp trọn stack 8 MB mỗi khi tạo thread */
+    if(mlockall(MCL_CURRENT | MCL_FUTURE | MCL_ONFAULT) != 0) {
+        fprintf(stderr, "[thread_plan] mlockall(MCL_FUTURE) failed (%s)\n", strerror(errno));
+    }
+#endif
+    printf("[thread_plan] memory locked\n");
+    fflush(stdout);
+    return 0;
+}
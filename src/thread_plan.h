@@ -0,0 +1,42 @@
+/**
+ * Threading plan: CPU affinity, SCHED_FIFO priority and name per thread role,
+ * plus memory locking once the draw buffers are allocated.
+ *
+ * Env:
+ *   THREAD_PLAN unset/0   only set thread names
+ *   THREAD_PLAN=1         default plan for the 4-core H618 (see thread_plan.c)
+ *   THREAD_PLAN=role=cpus:prio,...   override the default plan per role,
+ *                         cpus is "n" or "a-b" (-1 = any), prio 0 = SCHED_OTHER
+ *                         e.g. THREAD_PLAN="ui=3:50,uart=2:60"
+ *   THREAD_PLAN_MLOCK=0   keep the plan but skip mlockall
+ *
+ * Roles: ui, uart, buzzer, wdt, draw, vsync
+ * ("draw" covers the LVGL SW render threads "swdraw" and band threads "swband")
+ */
+
+#ifndef THREAD_PLAN_H
+#define THREAD_PLAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Áp dụng plan cho thread đang gọi (tên, affinity, priority); trả về 0 nếu OK */
+int thread_plan_apply(const char *role);
+
+/* Áp dụng plan (affinity, priority) cho các thread đã chạy có tên thread_name,
+ * dùng cho thread LVGL tự tạo: thread_plan_apply_named("draw", "swdraw").
+ * Trả về số thread tìm thấy */
+int thread_plan_apply_named(const char *role, const char *thread_name);
+
+/* mlockall + không trả heap về OS; gọi sau khi đã cấp phát draw buffer */
+int thread_plan_lock_memory(void);
+
+/* 1 nếu THREAD_PLAN đang bật */
+int thread_plan_enabled(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREAD_PLAN_H */
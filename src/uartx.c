@@ -9,6 +9,8 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/ioctl.h>
+#include <poll.h>
+#include "thread_plan.h"
 
 struct uartx_handle {
     int fd;
@@ -93,13 +95,17 @@ static void *reader_thread(void *arg)
 {
     uartx_handle_t *h = (uartx_handle_t *)arg;
     uint8_t buf[512];
+    thread_plan_apply("uart");
     while(h->run) {
         int n = (int)read(h->fd, buf, sizeof(buf));
         if(n > 0) {
             if(h->cb) h->cb(buf, (uint32_t)n, h->user);
         } else if(n < 0) {
             if(errno == EAGAIN || errno == EWOULDBLOCK) {
-                usleep(2000);
+                /* Chờ dữ liệu bằng poll thay vì ngủ cố định 2ms: giảm độ trễ/jitter nhận,
+                 * timeout ngắn để vẫn kiểm tra h->run khi dừng */
+                struct pollfd pfd = { .fd = h->fd, .events = POLLIN, .revents = 0 };
+                (void)poll(&pfd, 1, 50);
                 continue;
             } else {
                 usleep(10000);
@@ -0,0 +1,167 @@
+#include "ui_watchdog.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <execinfo.h>
+#include "thread_plan.h"
+
+#define BT_MAX      48
+#define HIST_BUCKETS 12
+
+/* Ngưỡng bucket (ms), bucket cuối là >= 2000 ms */
+static const uint32_t s_hist_edges_ms[HIST_BUCKETS - 1] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000 };
+static uint32_t s_hist[HIST_BUCKETS];
+static uint32_t s_lag_max_us = 0;
+
+static pthread_t s_ui_thread;
+static uint32_t s_threshold_ms = 500;
+static uint32_t s_report_s = 0;
+
+/* Heartbeat: thời điểm (us) thread UI dự kiến quay lại vòng lặp */
+static uint64_t s_expected_us = 0;
+static uint32_t s_beat_seq = 0;
+static uint32_t s_stall_seq = UINT32_MAX;
+
+/* Backtrace lấy trong signal handler chạy trên thread UI */
+static void *s_bt[BT_MAX];
+static volatile int s_bt_depth = 0;
+static volatile sig_atomic_t s_bt_ready = 0;
+
+/* Component flow EEZ đang chạy lúc bị treo, cũng lấy trong signal handler */
+static int32_t s_flow_index = -1;
+static int32_t s_component_index = -1;
+static int32_t s_component_type = -1;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static void on_bt_signal(int signum)
+{
+    (void)signum;
+    s_bt_depth = backtrace(s_bt, BT_MAX);
+    if(ui_watchdog_eez_executing(&s_flow_index, &s_component_index, &s_component_type) != 0) {
+        s_flow_index = s_component_index = s_component_type = -1;
+    }
+    s_bt_ready = 1;
+}
+
+void ui_watchdog_print_histogram(void)
+{
+    printf("[wdt] loop lag histogram (ms):");
+    for(int i = 0; i < HIST_BUCKETS; i++) {
+        if(i < HIST_BUCKETS - 1) printf(" <%u:%u", s_hist_edges_ms[i], s_hist[i]);
+        else printf(" >=%u:%u", s_hist_edges_ms[HIST_BUCKETS - 2], s_hist[i]);
+    }
+    printf("  max %.1f ms\n", (double)s_lag_max_us / 1000.0);
+    fflush(stdout);
+}
+
+static void report_stall(uint64_t late_us)
+{
+    /* Lấy backtrace của thread UI đang bị treo */
+    s_bt_ready = 0;
+    pthread_kill(s_ui_thread, SIGRTMIN + 1);
+    for(int i = 0; i < 100 && !s_bt_ready; i++) usleep(1000);
+
+    printf("[wdt] UI thread stalled %.1f ms (threshold %u ms)\n", (double)late_us / 1000.0, s_threshold_ms);
+    if(s_bt_ready) {
+        printf("[wdt] flow %d component %d type %d\n",
+               (int)s_flow_index, (int)s_component_index, (int)s_component_type);
+        printf("[wdt] backtrace:\n");
+        fflush(stdout);
+        backtrace_symbols_fd(s_bt, s_bt_depth, STDOUT_FILENO);
+    }
+    else {
+        printf("[wdt] backtrace not available\n");
+    }
+    ui_watchdog_print_histogram();
+}
+
+static void *watchdog_thread(void *arg)
+{
+    (void)arg;
+    uint32_t poll_ms = s_threshold_ms / 4;
+    if(poll_ms < 5) poll_ms = 5;
+    if(poll_ms > 50) poll_ms = 50;
+    uint64_t last_report = now_us();
+    thread_plan_apply("wdt");
+
+    for(;;) {
+        usleep(poll_ms * 1000);
+        uint64_t now = now_us();
+        uint64_t expected = __atomic_load_n(&s_expected_us, __ATOMIC_ACQUIRE);
+        uint32_t seq = __atomic_load_n(&s_beat_seq, __ATOMIC_ACQUIRE);
+
+        /* Chỉ báo một lần cho mỗi lần treo */
+        if(expected && now > expected && now - expected > (uint64_t)s_threshold_ms * 1000 &&
+           __atomic_load_n(&s_stall_seq, __ATOMIC_ACQUIRE) != seq) {
+            __atomic_store_n(&s_stall_seq, seq, __ATOMIC_RELEASE);
+            report_stall(now - expected);
+        }
+
+        if(s_report_s && now - last_report >= (uint64_t)s_report_s * 1000000ULL) {
+            last_report = now;
+            ui_watchdog_print_histogram();
+        }
+    }
+    return NULL;
+}
+
+int ui_watchdog_start(pthread_t ui_thread)
+{
+    const char *p = getenv("UI_WDT_MS");
+    if(p && *p) s_threshold_ms = (uint32_t)strtoul(p, NULL, 10);
+    if(s_threshold_ms == 0) return 0;
+    p = getenv("UI_WDT_REPORT_S");
+    if(p && *p) s_report_s = (uint32_t)strtoul(p, NULL, 10);
+
+    s_ui_thread = ui_thread;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_bt_signal;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGRTMIN + 1, &sa, NULL);
+
+    /* Gọi backtrace một lần trước để libgcc được nạp sẵn (tránh malloc trong signal handler) */
+    void *tmp[2];
+    (void)backtrace(tmp, 2);
+
+    pthread_t th;
+    if(pthread_create(&th, NULL, watchdog_thread, NULL) != 0) return -1;
+    pthread_detach(th);
+    printf("[wdt] UI watchdog started, threshold %u ms\n", s_threshold_ms);
+    fflush(stdout);
+    return 0;
+}
+
+void ui_watchdog_beat(uint32_t next_sleep_ms)
+{
+    uint64_t now = now_us();
+    uint64_t expected = __atomic_load_n(&s_expected_us, __ATOMIC_RELAXED);
+
+    if(expected) {
+        uint64_t lag = now > expected ? now - expected : 0;
+        uint32_t lag_ms = (uint32_t)(lag / 1000);
+        int b = 0;
+        while(b < HIST_BUCKETS - 1 && lag_ms >= s_hist_edges_ms[b]) b++;
+        s_hist[b]++;
+        if(lag > s_lag_max_us) s_lag_max_us = (uint32_t)lag;
+
+        if(__atomic_load_n(&s_stall_seq, __ATOMIC_ACQUIRE) == s_beat_seq) {
+            printf("[wdt] UI thread resumed after %.1f ms\n", (double)lag / 1000.0);
+            fflush(stdout);
+        }
+    }
+
+    __atomic_store_n(&s_beat_seq, s_beat_seq + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&s_expected_us, now + (uint64_t)next_sleep_ms * 1000ULL, __ATOMIC_RELEASE);
+}
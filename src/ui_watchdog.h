@@ -0,0 +1,37 @@
+/**
+ * Watchdog for the LVGL/UI thread: heartbeat, loop-lag histogram and
+ * backtrace of the stuck thread when a stall exceeds the threshold.
+ *
+ * Env:
+ *   UI_WDT_MS=<ms>        stall threshold (default 500, 0 disables the watchdog)
+ *   UI_WDT_REPORT_S=<s>   print the lag histogram periodically (default 0 = only on stall)
+ */
+
+#ifndef UI_WATCHDOG_H
+#define UI_WATCHDOG_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Khởi động watchdog cho thread UI chỉ định; trả về 0 nếu OK hoặc bị tắt */
+int ui_watchdog_start(pthread_t ui_thread);
+
+/* Gọi mỗi vòng lvgl_thread, trước khi ngủ next_sleep_ms */
+void ui_watchdog_beat(uint32_t next_sleep_ms);
+
+/* In histogram độ trễ vòng lặp ra stdout */
+void ui_watchdog_print_histogram(void);
+
+/* Định nghĩa trong ui_watchdog_eez.cpp: component flow EEZ đang chạy, -1 nếu không có.
+ * Chỉ gọi trên thread UI (trong signal handler khi thread UI bị treo) */
+int ui_watchdog_eez_executing(int32_t *flow_index, int32_t *component_index, int32_t *component_type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UI_WATCHDOG_H */
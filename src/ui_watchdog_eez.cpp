@@ -0,0 +1,29 @@
+#include "ui_watchdog.h"
+#include "ui/eez-flow.h"
+
+using namespace eez::flow;
+
+/* Giống NO_COMPONENT_INDEX (static trong eez-flow.cpp) */
+static const unsigned NO_COMPONENT_INDEX = 0xFFFFFFFF;
+
+/* tick() của engine gán executingComponentIndex trước executeComponent và xoá sau đó */
+static FlowState *find_executing(FlowState *flowState)
+{
+    for(; flowState; flowState = flowState->nextSibling) {
+        if(flowState->executingComponentIndex != NO_COMPONENT_INDEX) return flowState;
+        FlowState *child = find_executing(flowState->firstChild);
+        if(child) return child;
+    }
+    return nullptr;
+}
+
+extern "C" int ui_watchdog_eez_executing(int32_t *flow_index, int32_t *component_index, int32_t *component_type)
+{
+    FlowState *flowState = find_executing(g_firstFlowState);
+    if(!flowState) return -1;
+
+    *flow_index = flowState->flowIndex;
+    *component_index = (int32_t)flowState->executingComponentIndex;
+    *component_type = flowState->flow->components[flowState->executingComponentIndex]->type;
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include "vsync_pacer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <linux/fb.h>
+#include "thread_plan.h"
+
+#define DEFAULT_PERIOD_US 16667
+
+static int s_enabled = 0;
+static lv_display_t *s_disp = NULL;
+static int s_fd = -1;
+static uint32_t s_margin_us = 1500;
+
+/* Thread vsync ghi, thread UI đọc; bảo vệ bởi s_mu */
+static pthread_mutex_t s_mu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_cond;
+static uint64_t s_vblank_us = 0;                /* vblank gần nhất */
+static uint32_t s_period_us = DEFAULT_PERIOD_US;
+static int s_hw_vsync = 1;                      /* 0: đồng hồ mềm, không biết pha thật */
+
+/* Chỉ dùng trên thread UI */
+static int s_refr_requested = 1;
+static int s_rendered = 0;                      /* lần refresh vừa rồi có vẽ gì không */
+static uint32_t s_cost_us = 0;                  /* chi phí render ước lượng */
+static uint64_t s_last_target_us = 0;           /* vblank đã render cho */
+static uint32_t s_frames = 0;
+static uint32_t s_missed = 0;
+static uint64_t s_miss_log_us = 0;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static struct timespec to_timespec(uint64_t t_us)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(t_us / 1000000ULL);
+    ts.tv_nsec = (long)(t_us % 1000000ULL) * 1000L;
+    return ts;
+}
+
+/* Chu kỳ làm tươi theo timing của mode (pixclock tính bằng ps) */
+static uint32_t period_from_timings(const struct fb_var_screeninfo *v)
+{
+    uint64_t htotal = (uint64_t)v->xres + v->left_margin + v->right_margin + v->hsync_len;
+    uint64_t vtotal = (uint64_t)v->yres + v->upper_margin + v->lower_margin + v->vsync_len;
+    if(v->pixclock == 0) return DEFAULT_PERIOD_US;
+    uint64_t p = (uint64_t)v->pixclock * htotal * vtotal / 1000000ULL;
+    if(p < 1000 || p > 100000) return DEFAULT_PERIOD_US;
+    return (uint32_t)p;
+}
+
+static void *vsync_thread(void *arg)
+{
+    (void)arg;
+    thread_plan_apply("vsync");
+    uint32_t too_fast = 0;
+    uint64_t last = now_us();
+    uint64_t soft_next = last;
+
+    for(;;) {
+        int hw = __atomic_load_n(&s_hw_vsync, __ATOMIC_RELAXED);
+        if(hw) {
+            uint32_t crtc = 0;
+            if(ioctl(s_fd, FBIO_WAITFORVSYNC, &crtc) == -1) {
+                if(errno == EINTR) continue;
+                if(errno == ENOTTY || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP) {
+                    printf("[vsync] FBIO_WAITFORVSYNC not supported (%s), using software clock\n", strerror(errno));
+                    fflush(stdout);
+                    __atomic_store_n(&s_hw_vsync, 0, __ATOMIC_RELAXED);
+                    soft_next = now_us();
+                    continue;
+                }
+                /* Lỗi tạm thời (vd. đang blank): bỏ qua một chu kỳ */
+                usleep(s_period_us);
+                continue;
+            }
+        }
+        else {
+            soft_next += s_period_us;
+            struct timespec ts = to_timespec(soft_next);
+            while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+        }
+
+        uint64_t t = now_us();
+        uint64_t dt = t - last;
+        last = t;
+
+        pthread_mutex_lock(&s_mu);
+        if(hw) {
+            /* Có driver trả về ngay mà không chờ vblank: coi như không hỗ trợ */
+            if(dt < s_period_us / 4) {
+                if(++too_fast >= 8) {
+                    printf("[vsync] FBIO_WAITFORVSYNC returns immediately, using software clock\n");
+                    fflush(stdout);
+                    __atomic_store_n(&s_hw_vsync, 0, __ATOMIC_RELAXED);
+                    soft_next = t;
+                }
+            }
+            else {
+                too_fast = 0;
+                /* Bỏ qua khoảng bị lỡ vblank khi cập nhật chu kỳ */
+                if(dt > s_period_us * 3 / 4 && dt < s_period_us * 5 / 4)
+                    s_period_us = (uint32_t)((int64_t)s_period_us + ((int64_t)dt - (int64_t)s_period_us) / 16);
+            }
+        }
+        s_vblank_us = t;
+        pthread_cond_broadcast(&s_cond);
+        pthread_mutex_unlock(&s_mu);
+    }
+    return NULL;
+}
+
+static void refr_request_cb(lv_event_t *e)
+{
+    (void)e;
+    s_refr_requested = 1;
+}
+
+static void render_start_cb(lv_event_t *e)
+{
+    (void)e;
+    s_rendered = 1;
+}
+
+/* Refresh display; target_us = vblank mục tiêu (0: không tính trễ) */
+static void do_render(uint64_t vblank_us, uint64_t target_us)
+{
+#if LV_USE_LINUX_FBDEV
+    /* Driver page flip không cần chờ vsync nếu đã có vblank sau lần flip trước */
+    if(__atomic_load_n(&s_hw_vsync, __ATOMIC_RELAXED)) lv_linux_fbdev_set_vblank_time(s_disp, vblank_us);
+#else
+    (void)vblank_us;
+#endif
+    s_refr_requested = 0;
+    s_rendered = 0;
+    uint64_t t0 = now_us();
+    lv_anim_refr_now();
+    lv_display_refr_timer(NULL);
+    uint64_t t1 = now_us();
+    if(target_us) s_last_target_us = target_us;
+    if(!s_rendered) return;
+
+    /* Tăng nhanh, giảm chậm để một frame nặng không làm lỡ liên tiếp */
+    uint32_t c = (uint32_t)(t1 - t0);
+    int had_estimate = s_cost_us != 0;
+    if(c > s_cost_us) s_cost_us = (s_cost_us + c + 1) / 2;
+    else s_cost_us -= (s_cost_us - c) / 8;
+    if(s_cost_us > s_period_us * 4) s_cost_us = s_period_us * 4;
+
+    if(!target_us || !had_estimate) return;
+    s_frames++;
+    if(t1 > target_us) {
+        s_missed++;
+        if(t1 - s_miss_log_us >= 1000000ULL) {
+            s_miss_log_us = t1;
+            printf("[vsync] missed vblank by %.2f ms (render %.2f ms, est %.2f ms), %u/%u frames missed\n",
+                   (double)(t1 - target_us) / 1000.0, (double)c / 1000.0, (double)s_cost_us / 1000.0,
+                   s_missed, s_frames);
+            fflush(stdout);
+        }
+    }
+}
+
+/* Vblank mục tiêu: vblank sớm nhất mà render bắt đầu từ bây giờ vẫn kịp và chưa render cho nó */
+static uint64_t pick_target(uint64_t now, uint64_t vb, uint32_t period, uint64_t lead)
+{
+    uint64_t k = 1;
+    if(now + lead > vb + period) k = (now + lead - vb + period - 1) / period;
+    uint64_t target = vb + k * period;
+    if(target < s_last_target_us + period / 2) target += period;
+    return target;
+}
+
+void vsync_pacer_sleep(uint32_t idle_ms, int can_render)
+{
+    if(idle_ms > 1000) idle_ms = 1000;
+    uint64_t now = now_us();
+    uint64_t wake = now + (uint64_t)idle_ms * 1000ULL;
+    int render = can_render && (s_refr_requested || lv_anim_count_running() > 0);
+    uint64_t lead = (uint64_t)s_cost_us + s_margin_us;
+
+    pthread_mutex_lock(&s_mu);
+    uint64_t vb = s_vblank_us;
+    uint32_t period = s_period_us;
+    uint64_t target = render ? pick_target(now, vb, period, lead) : 0;
+
+    for(;;) {
+        uint64_t until = wake;
+        if(render && target - lead < until) until = target - lead;
+        if(now >= until) break;
+        struct timespec ts = to_timespec(until);
+        pthread_cond_timedwait(&s_cond, &s_mu, &ts);
+        now = now_us();
+
+        /* Có vblank mới: neo lại mục tiêu theo pha vừa đo */
+        if(render && s_vblank_us != vb) {
+            vb = s_vblank_us;
+            period = s_period_us;
+            if(target > vb) target = vb + (target - vb + period / 2) / period * period;
+            if(target <= vb) target = vb + period;
+        }
+    }
+    pthread_mutex_unlock(&s_mu);
+
+    if(render && now + lead >= target) do_render(vb, target);
+}
+
+void vsync_pacer_refr_now(void)
+{
+    pthread_mutex_lock(&s_mu);
+    uint64_t vb = s_vblank_us;
+    pthread_mutex_unlock(&s_mu);
+    do_render(vb, 0);
+}
+
+int vsync_pacer_enabled(void)
+{
+    return s_enabled;
+}
+
+int vsync_pacer_start(lv_display_t *disp)
+{
+    const char *p = getenv("VSYNC_PACE");
+    if(!disp || !p || *p != '1') return -1;
+
+    const char *dev = getenv("LV_LINUX_FBDEV_DEVICE");
+    if(!dev || !*dev) dev = "/dev/fb0";
+    s_fd = open(dev, O_RDWR);
+    if(s_fd < 0) {
+        printf("[vsync] cannot open %s, pacing disabled\n", dev);
+        return -1;
+    }
+    struct fb_var_screeninfo vinfo;
+    if(ioctl(s_fd, FBIOGET_VSCREENINFO, &vinfo) == 0) s_period_us = period_from_timings(&vinfo);
+
+    p = getenv("VSYNC_MARGIN_US");
+    if(p && *p) s_margin_us = (uint32_t)strtoul(p, NULL, 10);
+    p = getenv("VSYNC_SOFT");
+    if(p && *p == '1') s_hw_vsync = 0;
+
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+    pthread_cond_init(&s_cond, &ca);
+    pthread_condattr_destroy(&ca);
+
+    s_vblank_us = now_us();
+    pthread_t th;
+    if(pthread_create(&th, NULL, vsync_thread, NULL) != 0) {
+        close(s_fd);
+        s_fd = -1;
+        return -1;
+    }
+    pthread_detach(th);
+
+    /* Thread UI tự quyết định lúc render, không dùng refresh timer 33ms của LVGL */
+    s_disp = disp;
+    lv_display_delete_refr_timer(disp);
+    lv_display_add_event_cb(disp, refr_request_cb, LV_EVENT_REFR_REQUEST, NULL);
+    lv_display_add_event_cb(disp, render_start_cb, LV_EVENT_RENDER_START, NULL);
+    s_enabled = 1;
+
+    printf("[vsync] pacing on: %s, period %u us, margin %u us\n",
+           s_hw_vsync ? "FBIO_WAITFORVSYNC" : "software clock", s_period_us, s_margin_us);
+    fflush(stdout);
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * Vsync pacing for the fbdev backend: a dedicated thread waits for vertical
+ * blank (FBIO_WAITFORVSYNC, or a software clock at the panel refresh rate if
+ * the ioctl is not supported) and the UI loop starts each render so that it
+ * finishes just before the next vblank, based on the measured render cost.
+ *
+ * Env:
+ *   VSYNC_PACE=1          enable (default off: LVGL refresh timer as before)
+ *   VSYNC_SOFT=1          ignore FBIO_WAITFORVSYNC, always use the software clock
+ *   VSYNC_MARGIN_US       safety margin before vblank (default 1500)
+ */
+
+#ifndef VSYNC_PACER_H
+#define VSYNC_PACER_H
+
+#include "lvgl/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Khởi động thread vsync và tắt refresh timer của LVGL; trả về 0 nếu pacing bật */
+int vsync_pacer_start(lv_display_t *disp);
+
+/* 1 nếu pacing đang bật */
+int vsync_pacer_enabled(void);
+
+/* Thay cho usleep(idle) trong vòng lặp UI: ngủ tối đa idle_ms,
+ * render khi tới slot của vblank kế tiếp (nếu can_render và có vùng cần vẽ) */
+void vsync_pacer_sleep(uint32_t idle_ms, int can_render);
+
+/* Render ngay (ví dụ khi đánh thức màn hình), không chờ slot */
+void vsync_pacer_refr_now(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VSYNC_PACER_H */
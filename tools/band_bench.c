@@ -0,0 +1,151 @@
+/**
+ * band_bench - đo khả năng scale của render song song theo band (LV_DRAW_SW_BAND_THREAD_CNT)
+ * khi chạy benchmark demo của LVGL với 1, 2, 3, 4 thread.
+ *
+ * band_bench [-t 1,2,3,4] [-W width] [-H height] [-s speed] [-c 16|32]
+ *
+ * Tick là tick ảo tăng 16 ms mỗi vòng nên mọi lần chạy render đúng cùng các frame,
+ * kết quả chỉ khác nhau ở thời gian render. -s chia thời gian mỗi scene để chạy nhanh hơn
+ * (vd. -s 4: 1/4 số frame). "fb" là bộ nhớ thường, flush chỉ báo xong ngay.
+ * -c chọn định dạng màu của display: 16 = RGB565 (mặc định, giống app với LV_COLOR_DEPTH 16),
+ * 32 = XRGB8888.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "lvgl/lvgl.h"
+#include "lvgl/demos/lv_demos.h"
+#include "lvgl/src/draw/sw/lv_draw_sw.h"
+
+#define TICK_STEP_MS 16
+
+static int32_t s_hor_res = 1920;
+static int32_t s_ver_res = 1080;
+static uint32_t s_tick;
+static uint32_t s_speed = 1;
+static lv_color_format_t s_cf = LV_COLOR_FORMAT_RGB565;
+static int s_done;
+
+static uint64_t s_refr_start_us;
+static uint64_t s_refr_us;
+static uint32_t s_frames;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static uint32_t tick_cb(void)
+{
+    return s_tick;
+}
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+    lv_display_flush_ready(disp);
+}
+
+static void refr_event_cb(lv_event_t *e)
+{
+    if(lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        s_refr_start_us = now_us();
+    }
+    else {
+        s_refr_us += now_us() - s_refr_start_us;
+        s_frames++;
+    }
+}
+
+static void end_cb(const lv_demo_benchmark_summary_t *summary)
+{
+    (void)summary;
+    s_done = 1;
+}
+
+static void run(uint32_t threads)
+{
+    lv_init();
+    lv_tick_set_cb(tick_cb);
+    lv_draw_sw_set_band_thread_count(threads);
+
+    lv_display_t *disp = lv_display_create(s_hor_res, s_ver_res);
+    lv_display_set_color_format(disp, s_cf);
+    uint32_t buf_size = lv_draw_buf_width_to_stride(s_hor_res, s_cf) * s_ver_res;
+    void *buf = malloc(buf_size);
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+
+    s_done = 0;
+    s_refr_us = 0;
+    s_frames = 0;
+    s_tick = 0;
+    lv_demo_benchmark_set_end_cb(end_cb);
+    lv_demo_benchmark();
+
+    uint64_t t0 = now_us();
+    while(!s_done) {
+        s_tick += TICK_STEP_MS * s_speed;
+        lv_timer_handler();
+    }
+    uint64_t total = now_us() - t0;
+
+    printf("%7u %8u %10.2f %10.2f %10.2f\n", threads, s_frames,
+           (double)s_refr_us / s_frames / 1000.0, (double)total / 1000000.0,
+           (double)s_refr_us / 1000000.0);
+    fflush(stdout);
+
+    lv_deinit();
+    free(buf);
+}
+
+int main(int argc, char **argv)
+{
+    const char *threads = "1,2,3,4";
+    int opt;
+
+    while((opt = getopt(argc, argv, "t:W:H:s:c:h")) != -1) {
+        switch(opt) {
+        case 't': threads = optarg; break;
+        case 'W': s_hor_res = atoi(optarg); break;
+        case 'H': s_ver_res = atoi(optarg); break;
+        case 's': s_speed = (uint32_t)atoi(optarg); break;
+        case 'c':
+            if(atoi(optarg) == 16) s_cf = LV_COLOR_FORMAT_RGB565;
+            else if(atoi(optarg) == 32) s_cf = LV_COLOR_FORMAT_XRGB8888;
+            else {
+                fprintf(stderr, "-c: 16 hoặc 32\n");
+                return 1;
+            }
+            break;
+        default:
+            fprintf(stderr, "band_bench [-t 1,2,3,4] [-W width] [-H height] [-s speed] [-c 16|32]\n");
+            return 1;
+        }
+    }
+    if(s_hor_res <= 0 || s_ver_res <= 0 || s_speed == 0) return 1;
+
+    printf("%dx%d %s, benchmark demo, LV_DRAW_SW_BAND_THREAD_CNT %d\n", (int)s_hor_res, (int)s_ver_res,
+           s_cf == LV_COLOR_FORMAT_RGB565 ? "RGB565" : "XRGB8888", LV_DRAW_SW_BAND_THREAD_CNT);
+    printf("%7s %8s %10s %10s %10s\n", "threads", "frames", "ms/frame", "total s", "render s");
+
+    const char *p = threads;
+    while(*p) {
+        char *end;
+        unsigned long n = strtoul(p, &end, 10);
+        if(end == p) break;
+        if(n > 0) run((uint32_t)n);
+        p = *end == ',' ? end + 1 : end;
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * dispatch_bench - đo chi phí dispatch draw task trên màn hình có rất nhiều widget
+ * (LV_DRAW_TASK_GRID_THRESHOLD: kiểm tra phụ thuộc giữa các draw task bằng lưới thay vì duyệt hết).
+ *
+ * dispatch_bench [-n widgets] [-f frames] [-W width] [-H height]
+ *
+ * Mỗi widget là một nút nhỏ có chữ (nền, viền, label) nên mỗi frame có vài nghìn draw task
+ * nhưng phần render rất nhẹ; thời gian frame chủ yếu là tạo + dispatch task.
+ * So sánh bằng cách build lại với LV_DRAW_TASK_GRID_THRESHOLD 0.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "lvgl/lvgl.h"
+
+static int32_t s_hor_res = 1920;
+static int32_t s_ver_res = 1080;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static uint32_t tick_cb(void)
+{
+    return (uint32_t)(now_us() / 1000ULL);
+}
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+    lv_display_flush_ready(disp);
+}
+
+static void build_scene(lv_display_t *disp, int widgets)
+{
+    lv_obj_t *scr = lv_display_get_screen_active(disp);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x3a5f6b), 0);
+
+    /* Chia màn hình thành lưới gần vuông đủ chỗ cho mọi widget */
+    int cols = 1;
+    while(cols * cols * s_ver_res < widgets * s_hor_res) cols++;
+    int rows = (widgets + cols - 1) / cols;
+    int32_t cw = s_hor_res / cols;
+    int32_t ch = s_ver_res / rows;
+
+    for(int i = 0; i < widgets; i++) {
+        lv_obj_t *btn = lv_button_create(scr);
+        lv_obj_remove_style_all(btn);
+        lv_obj_set_size(btn, cw - 4, ch - 4);
+        lv_obj_set_pos(btn, (i % cols) * cw + 2, (i / cols) * ch + 2);
+        lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x2a2a2a), 0);
+        lv_obj_set_style_border_width(btn, 1, 0);
+        lv_obj_set_style_border_color(btn, lv_color_hex(0x6294a5), 0);
+        lv_obj_set_style_radius(btn, 3, 0);
+        lv_obj_t *label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%d", i % 100);
+        lv_obj_set_style_text_color(label, lv_color_white(), 0);
+        lv_obj_center(label);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int widgets = 1200;
+    int frames = 50;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:f:W:H:h")) != -1) {
+        switch(opt) {
+        case 'n': widgets = atoi(optarg); break;
+        case 'f': frames = atoi(optarg); break;
+        case 'W': s_hor_res = atoi(optarg); break;
+        case 'H': s_ver_res = atoi(optarg); break;
+        default:
+            fprintf(stderr, "dispatch_bench [-n widgets] [-f frames] [-W width] [-H height]\n");
+            return 1;
+        }
+    }
+    if(widgets <= 0 || frames <= 0 || s_hor_res <= 0 || s_ver_res <= 0) return 1;
+
+    lv_init();
+    lv_tick_set_cb(tick_cb);
+
+    lv_display_t *disp = lv_display_create(s_hor_res, s_ver_res);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+    uint32_t buf_size = lv_draw_buf_width_to_stride(s_hor_res, LV_COLOR_FORMAT_XRGB8888) * s_ver_res;
+    void *buf = malloc(buf_size);
+    if(!buf) return 1;
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, flush_cb);
+    build_scene(disp, widgets);
+
+    /* Frame đầu để nạp cache font/glyph */
+    lv_refr_now(disp);
+
+    uint64_t total = 0, best = UINT64_MAX;
+    uint32_t task_cnt = lv_draw_get_task_created_count();
+    for(int i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_display_get_screen_active(disp));
+        uint64_t t0 = now_us();
+        lv_refr_now(disp);
+        uint64_t dt = now_us() - t0;
+        total += dt;
+        if(dt < best) best = dt;
+    }
+    task_cnt = lv_draw_get_task_created_count() - task_cnt;
+
+    printf("%dx%d, %d widgets, %d frames, LV_DRAW_TASK_GRID_THRESHOLD %d\n", (int)s_hor_res, (int)s_ver_res,
+           widgets, frames, LV_DRAW_TASK_GRID_THRESHOLD);
+    printf("tasks/frame %u, avg %.2f ms, best %.2f ms\n", task_cnt / (uint32_t)frames,
+           (double)total / frames / 1000.0, (double)best / 1000.0);
+
+    lv_display_delete(disp);
+    free(buf);
+    lv_deinit();
+    return 0;
+}
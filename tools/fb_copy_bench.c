@@ -0,0 +1,160 @@
+/**
+ * fb_copy_bench - đo tốc độ copy (MB/s) vào framebuffer: memcpy từng dòng, memcpy gộp
+ * thành một lần copy khi vùng rộng hết dòng, và hàm copy của driver fbdev
+ * (lv_linux_fbdev_copy_rows: gộp + store non-temporal STNP trên aarch64).
+ *
+ * fb_copy_bench [-f /dev/fbN] [-m] [-t ms]
+ *
+ * -f  thiết bị framebuffer (mặc định /dev/fb0)
+ * -m  dùng memfd 1920x1080 RGB565 thay cho framebuffer thật (bộ nhớ cached)
+ * -t  thời gian đo mỗi trường hợp (mặc định 500 ms)
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/fb.h>
+#include "../lvgl/src/drivers/display/fb/lv_linux_fbdev_copy.h"
+
+typedef struct {
+    const char *name;
+    uint32_t w;     /* 0: rộng hết màn hình */
+    uint32_t h;
+} bench_area_t;
+
+static const bench_area_t s_areas[] = {
+    { "full frame",       0, 0 },
+    { "full-width band",  0, 108 },
+    { "narrow 480x108", 480, 108 },
+    { "narrow 64x64",    64, 64 },
+};
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+typedef enum {
+    MODE_ROWS,      /* một memcpy mỗi dòng (trước đây) */
+    MODE_MERGED,    /* gộp các dòng liền nhau */
+    MODE_DRIVER,    /* lv_linux_fbdev_copy_rows của driver */
+} copy_mode_t;
+
+static const char *s_mode_names[] = { "rows", "merged", "driver" };
+
+static void copy_area(copy_mode_t mode, uint8_t *fb, size_t fb_stride, const uint8_t *src,
+                      size_t row_size, uint32_t rows)
+{
+    if(mode == MODE_DRIVER) {
+        lv_linux_fbdev_copy_rows(fb, fb_stride, src, row_size, row_size, (int32_t)rows);
+        return;
+    }
+    if(mode == MODE_MERGED && fb_stride == row_size) {
+        row_size *= rows;
+        rows = 1;
+    }
+    for(; rows > 0; rows--) {
+        memcpy(fb, src, row_size);
+        fb += fb_stride;
+        src += row_size;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *dev = "/dev/fb0";
+    int use_memfd = 0;
+    int time_ms = 500;
+    int opt;
+
+    while((opt = getopt(argc, argv, "f:mt:h")) != -1) {
+        switch(opt) {
+        case 'f': dev = optarg; break;
+        case 'm': use_memfd = 1; break;
+        case 't': time_ms = atoi(optarg); break;
+        default:
+            fprintf(stderr, "fb_copy_bench [-f /dev/fbN] [-m] [-t ms]\n");
+            return 1;
+        }
+    }
+    if(time_ms <= 0) return 1;
+
+    uint32_t xres = 1920, yres = 1080, bpp = 16;
+    size_t stride = xres * 2;
+    int fd;
+    if(use_memfd) {
+        fd = memfd_create("fb_copy_bench", 0);
+        if(fd < 0 || ftruncate(fd, (off_t)(stride * yres)) != 0) {
+            perror("memfd");
+            return 1;
+        }
+        dev = "memfd";
+    }
+    else {
+        fd = open(dev, O_RDWR);
+        struct fb_var_screeninfo vinfo;
+        struct fb_fix_screeninfo finfo;
+        if(fd < 0 || ioctl(fd, FBIOGET_VSCREENINFO, &vinfo) != 0 || ioctl(fd, FBIOGET_FSCREENINFO, &finfo) != 0) {
+            perror(dev);
+            return 1;
+        }
+        xres = vinfo.xres;
+        yres = vinfo.yres;
+        bpp = vinfo.bits_per_pixel;
+        stride = finfo.line_length;
+    }
+
+    uint32_t px_size = bpp / 8;
+    uint8_t *fb = mmap(NULL, stride * yres, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(fb == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    /* Nguồn giống draw buffer của LVGL: liền nhau, stride = w * px_size */
+    size_t src_size = (size_t)xres * yres * px_size;
+    uint8_t *src = aligned_alloc(64, (src_size + 63) & ~(size_t)63);
+    if(!src) return 1;
+    for(size_t i = 0; i < src_size; i++) src[i] = (uint8_t)(i * 7);
+
+    printf("%s: %ux%u %ubpp, line_length %zu\n", dev, xres, yres, bpp, stride);
+    printf("%-18s %10s %10s %10s  MB/s\n", "area", s_mode_names[0], s_mode_names[1], s_mode_names[2]);
+
+    for(size_t a = 0; a < sizeof(s_areas) / sizeof(s_areas[0]); a++) {
+        uint32_t w = s_areas[a].w ? s_areas[a].w : xres;
+        uint32_t h = s_areas[a].h ? s_areas[a].h : yres;
+        if(w > xres) w = xres;
+        if(h > yres) h = yres;
+        size_t row_size = (size_t)w * px_size;
+        printf("%-18s", s_areas[a].name);
+
+        for(int m = MODE_ROWS; m <= MODE_DRIVER; m++) {
+            uint64_t bytes = 0;
+            uint64_t t0 = now_us();
+            uint64_t t = t0;
+            uint32_t y = 0;
+            /* Dời vị trí vùng mỗi lần để không đo mãi cùng một chỗ */
+            while(t - t0 < (uint64_t)time_ms * 1000ULL) {
+                uint32_t x = (xres - w) / 2;
+                copy_area((copy_mode_t)m, fb + (size_t)y * stride + (size_t)x * px_size, stride, src, row_size, h);
+                bytes += row_size * h;
+                y = (y + h) % (yres - h + 1);
+                t = now_us();
+            }
+            printf(" %10.1f", (double)bytes / (double)(t - t0));
+        }
+        printf("\n");
+    }
+
+    munmap(fb, stride * yres);
+    close(fd);
+    free(src);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * jitter_bench - đo jitter đánh thức thread và độ trễ UART loopback,
+ * dùng để so sánh THREAD_PLAN=0 và THREAD_PLAN=1 (xem scripts/jitter-bench.sh).
+ *
+ * jitter_bench [-d seconds] [-p period_us] [-u /dev/ttySx] [-b baud]
+ *
+ * - Thread đo chạy với role "ui" của thread plan, ngủ theo chu kỳ tuyệt đối
+ *   (kiểu cyclictest) và ghi độ trễ đánh thức.
+ * - Với -u: cần nối TX-RX của cổng, mỗi 20ms gửi 1 byte qua uartx và đo
+ *   thời gian tới khi callback của reader thread (role "uart") nhận lại.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "thread_plan.h"
+#include "uartx.h"
+
+#define MAX_SAMPLES 200000
+
+typedef struct {
+    uint32_t *v;
+    uint32_t n;
+} samples_t;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void print_stats(const char *name, samples_t *s)
+{
+    if(s->n == 0) {
+        printf("%-8s no samples\n", name);
+        return;
+    }
+    double sum = 0, sq = 0;
+    for(uint32_t i = 0; i < s->n; i++) sum += s->v[i];
+    double avg = sum / s->n;
+    for(uint32_t i = 0; i < s->n; i++) sq += (s->v[i] - avg) * (s->v[i] - avg);
+    qsort(s->v, s->n, sizeof(uint32_t), cmp_u32);
+    printf("%-8s n=%u min=%u avg=%.1f stddev=%.1f p99=%u max=%u us\n", name, s->n, s->v[0], avg,
+           sqrt(sq / s->n), s->v[(uint32_t)((s->n - 1) * 0.99)], s->v[s->n - 1]);
+}
+
+/* ---- UART loopback ---- */
+static volatile uint64_t s_uart_sent_us = 0;
+static samples_t s_uart = { NULL, 0 };
+
+static void on_uart_data(const uint8_t *data, uint32_t len, void *user)
+{
+    (void)data; (void)len; (void)user;
+    uint64_t t = s_uart_sent_us;
+    if(t && s_uart.n < MAX_SAMPLES) s_uart.v[s_uart.n++] = (uint32_t)(now_us() - t);
+    s_uart_sent_us = 0;
+}
+
+int main(int argc, char **argv)
+{
+    int seconds = 10;
+    int period_us = 1000;
+    const char *uart_dev = NULL;
+    int baud = 115200;
+    int opt;
+
+    while((opt = getopt(argc, argv, "d:p:u:b:h")) != -1) {
+        switch(opt) {
+        case 'd': seconds = atoi(optarg); break;
+        case 'p': period_us = atoi(optarg); break;
+        case 'u': uart_dev = optarg; break;
+        case 'b': baud = atoi(optarg); break;
+        default:
+            fprintf(stderr, "jitter_bench [-d seconds] [-p period_us] [-u /dev/ttySx] [-b baud]\n");
+            return 1;
+        }
+    }
+    if(seconds <= 0 || period_us <= 0) return 1;
+
+    samples_t wake = { calloc(MAX_SAMPLES, sizeof(uint32_t)), 0 };
+    s_uart.v = calloc(MAX_SAMPLES, sizeof(uint32_t));
+    if(!wake.v || !s_uart.v) return 1;
+
+    uartx_handle_t *uart = NULL;
+    if(uart_dev) {
+        uart = uartx_open(uart_dev, baud);
+        if(!uart) return 1;
+        uartx_set_callback(uart, on_uart_data, NULL);
+        uartx_start(uart);
+    }
+
+    thread_plan_lock_memory();
+    thread_plan_apply("ui");
+    printf("THREAD_PLAN=%s period %d us, %d s%s%s\n", thread_plan_enabled() ? getenv("THREAD_PLAN") : "0",
+           period_us, seconds, uart_dev ? ", uart " : "", uart_dev ? uart_dev : "");
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    uint64_t end = now_us() + (uint64_t)seconds * 1000000ULL;
+    uint64_t last_uart = 0;
+    while(now_us() < end) {
+        next.tv_nsec += period_us * 1000L;
+        while(next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        uint64_t t = now_us();
+        uint64_t target = (uint64_t)next.tv_sec * 1000000ULL + (uint64_t)next.tv_nsec / 1000ULL;
+        if(wake.n < MAX_SAMPLES) wake.v[wake.n++] = (uint32_t)(t > target ? t - target : 0);
+
+        /* Byte bị mất thì bỏ qua sau 100ms */
+        if(uart && t - last_uart >= 20000 && (s_uart_sent_us == 0 || t - s_uart_sent_us > 100000)) {
+            last_uart = t;
+            uint8_t b = 0x55;
+            s_uart_sent_us = now_us();
+            uartx_write(uart, &b, 1);
+        }
+    }
+
+    if(uart) {
+        uartx_stop(uart);
+        uartx_close(uart);
+    }
+    print_stats("wake", &wake);
+    if(uart_dev) print_stats("uart", &s_uart);
+    return 0;
+}
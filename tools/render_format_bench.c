@@ -0,0 +1,153 @@
+/**
+ * render_format_bench - so sánh chi phí một frame trên framebuffer 32 bpp:
+ * render XRGB8888 rồi copy, với render RGB565 rồi chuyển sang XRGB8888 khi flush
+ * (LV_LINUX_FBDEV_RENDER_CF=RGB565, xem lv_linux_fbdev_set_render_format).
+ *
+ * render_format_bench [-n frames] [-W width] [-H height]
+ *
+ * Scene giống màn hình bàn phím của UI: nền gradient, ~50 nút bo góc có chữ.
+ * Mỗi frame invalidate toàn màn hình; "fb" là bộ nhớ thường nên trên máy thật
+ * phần flush sẽ chậm hơn (bộ nhớ fb thường uncached/write-combine).
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "lvgl/lvgl.h"
+
+static uint32_t *s_fb;
+static int32_t s_hor_res = 1920;
+static int32_t s_ver_res = 1080;
+static uint64_t s_flush_us;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static uint32_t tick_cb(void)
+{
+    return (uint32_t)(now_us() / 1000ULL);
+}
+
+/* Giống write_to_fb / convert_to_fb của driver fbdev (bản mmap) */
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint64_t t0 = now_us();
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    int32_t w = lv_area_get_width(area);
+    uint32_t src_stride = lv_draw_buf_width_to_stride(w, cf);
+    uint32_t *dst = s_fb + (size_t)area->y1 * s_hor_res + area->x1;
+
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        if(cf == LV_COLOR_FORMAT_RGB565) lv_draw_sw_rgb565_to_xrgb8888(px_map, dst, (uint32_t)w);
+        else memcpy(dst, px_map, (size_t)w * 4);
+        dst += s_hor_res;
+        px_map += src_stride;
+    }
+    s_flush_us += now_us() - t0;
+    lv_display_flush_ready(disp);
+}
+
+static void build_scene(lv_display_t *disp)
+{
+    static const char *keys = "1qwertyuiopXAasdfghjklE_-zxcvbnm.,:K<  >V";
+    lv_obj_t *scr = lv_display_get_screen_active(disp);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x6294a5), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x3a5f6b), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t *title = lv_label_create(scr);
+    lv_label_set_text(title, "SDKD DEMO VERSION!");
+    lv_obj_set_style_text_font(title, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_color(title, lv_color_white(), 0);
+    lv_obj_set_pos(title, 20, 20);
+
+    lv_obj_t *ta = lv_textarea_create(scr);
+    lv_obj_set_size(ta, 1220, 70);
+    lv_obj_set_pos(ta, 405, 110);
+
+    int32_t kw = (s_hor_res - 60) / 12;
+    int32_t kh = (s_ver_res - 280) / 4;
+    for(int i = 0; keys[i]; i++) {
+        lv_obj_t *btn = lv_button_create(scr);
+        lv_obj_set_size(btn, kw - 10, kh - 12);
+        lv_obj_set_pos(btn, 30 + (i % 12) * kw, 265 + (i / 12) * kh);
+        lv_obj_set_style_radius(btn, 8, 0);
+        lv_obj_set_style_bg_color(btn, lv_color_white(), 0);
+        lv_obj_set_style_shadow_width(btn, 0, 0);
+        lv_obj_t *label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%c", keys[i]);
+        lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+        lv_obj_set_style_text_color(label, lv_color_black(), 0);
+        lv_obj_center(label);
+    }
+}
+
+static void run(lv_color_format_t cf, const char *name, int frames)
+{
+    lv_display_t *disp = lv_display_create(s_hor_res, s_ver_res);
+    lv_display_set_color_format(disp, cf);
+    uint32_t buf_size = lv_draw_buf_width_to_stride(s_hor_res, cf) * s_ver_res;
+    void *buf = malloc(buf_size);
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+    build_scene(disp);
+
+    /* Frame đầu để nạp cache font/glyph */
+    lv_refr_now(disp);
+
+    uint64_t total = 0, best = UINT64_MAX;
+    s_flush_us = 0;
+    for(int i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_display_get_screen_active(disp));
+        uint64_t t0 = now_us();
+        lv_refr_now(disp);
+        uint64_t dt = now_us() - t0;
+        total += dt;
+        if(dt < best) best = dt;
+    }
+    printf("%-22s %9.2f %9.2f %9.2f %9.2f\n", name,
+           (double)total / frames / 1000.0, (double)best / 1000.0,
+           (double)(total - s_flush_us) / frames / 1000.0, (double)s_flush_us / frames / 1000.0);
+
+    lv_display_delete(disp);
+    free(buf);
+}
+
+int main(int argc, char **argv)
+{
+    int frames = 100;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:W:H:h")) != -1) {
+        switch(opt) {
+        case 'n': frames = atoi(optarg); break;
+        case 'W': s_hor_res = atoi(optarg); break;
+        case 'H': s_ver_res = atoi(optarg); break;
+        default:
+            fprintf(stderr, "render_format_bench [-n frames] [-W width] [-H height]\n");
+            return 1;
+        }
+    }
+    if(frames <= 0 || s_hor_res <= 0 || s_ver_res <= 0) return 1;
+
+    lv_init();
+    lv_tick_set_cb(tick_cb);
+    s_fb = malloc((size_t)s_hor_res * s_ver_res * 4);
+    if(!s_fb) return 1;
+
+    printf("%dx%d, %d frames, XRGB8888 framebuffer\n", (int)s_hor_res, (int)s_ver_res, frames);
+    printf("%-22s %9s %9s %9s %9s  ms/frame\n", "render", "avg", "best", "render", "flush");
+    run(LV_COLOR_FORMAT_XRGB8888, "XRGB8888 + copy", frames);
+    run(LV_COLOR_FORMAT_RGB565, "RGB565 + convert", frames);
+
+    free(s_fb);
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * tile_bench - đo thời gian frame của benchmark demo ở PARTIAL mode khi render theo tile
+ * nhiều hàng khác nhau (LV_LINUX_FBDEV_TILE_SIZE / LV_LINUX_FBDEV_TILE_AUTO của driver fbdev).
+ *
+ * tile_bench [-r 16,32,64,128,1080] [-c 16|32] [-W width] [-H height] [-s speed]
+ *
+ * Buffer được cấp phát cỡ cả màn hình, số hàng mỗi tile được giới hạn giống driver (giảm data_size).
+ * Flush copy từng tile vào "fb" là bộ nhớ thường nên thời gian gồm cả ghi ra framebuffer.
+ * Tick ảo tăng 16 ms mỗi vòng nên mọi lần chạy render đúng cùng các frame.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "lvgl/lvgl.h"
+#include "lvgl/demos/lv_demos.h"
+#include "lvgl/src/display/lv_display_private.h"
+
+#define TICK_STEP_MS 16
+
+static int32_t s_hor_res = 1920;
+static int32_t s_ver_res = 1080;
+static lv_color_format_t s_cf = LV_COLOR_FORMAT_RGB565;
+static uint32_t s_tick;
+static uint32_t s_speed = 1;
+static int s_done;
+static uint8_t *s_fb;
+
+static uint64_t s_refr_start_us;
+static uint64_t s_refr_us;
+static uint32_t s_frames;
+static uint32_t s_flushes;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static uint32_t tick_cb(void)
+{
+    return s_tick;
+}
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint32_t px_size = lv_color_format_get_size(s_cf);
+    uint32_t row_size = lv_area_get_width(area) * px_size;
+    uint32_t fb_stride = s_hor_res * px_size;
+    uint8_t *dst = s_fb + area->y1 * fb_stride + area->x1 * px_size;
+
+    /* Tile rộng hết màn hình thì liền nhau trong fb, copy một lần */
+    if(row_size == fb_stride) {
+        memcpy(dst, px_map, row_size * lv_area_get_height(area));
+    }
+    else {
+        for(int32_t y = area->y1; y <= area->y2; y++) {
+            memcpy(dst, px_map, row_size);
+            dst += fb_stride;
+            px_map += row_size;
+        }
+    }
+    s_flushes++;
+    lv_display_flush_ready(disp);
+}
+
+static void refr_event_cb(lv_event_t *e)
+{
+    if(lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        s_refr_start_us = now_us();
+    }
+    else {
+        s_refr_us += now_us() - s_refr_start_us;
+        s_frames++;
+    }
+}
+
+static void end_cb(const lv_demo_benchmark_summary_t *summary)
+{
+    (void)summary;
+    s_done = 1;
+}
+
+static void run(int32_t rows)
+{
+    lv_init();
+    lv_tick_set_cb(tick_cb);
+
+    lv_display_t *disp = lv_display_create(s_hor_res, s_ver_res);
+    lv_display_set_color_format(disp, s_cf);
+    uint32_t stride = lv_draw_buf_width_to_stride(s_hor_res, s_cf);
+    uint32_t buf_size = stride * s_ver_res;
+    void *buf = malloc(buf_size);
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    /* Giống tile_set_rows() của driver: buffer giữ nguyên, chỉ giảm cỡ LVGL thấy */
+    if(rows > s_ver_res) rows = s_ver_res;
+    disp->buf_1->data_size = stride * rows;
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+
+    s_done = 0;
+    s_refr_us = 0;
+    s_frames = 0;
+    s_flushes = 0;
+    s_tick = 0;
+    lv_demo_benchmark_set_end_cb(end_cb);
+    lv_demo_benchmark();
+
+    while(!s_done) {
+        s_tick += TICK_STEP_MS * s_speed;
+        lv_timer_handler();
+    }
+
+    printf("%6d %9u %8u %10.2f %10.2f\n", (int)rows, stride * rows / 1024, s_frames,
+           (double)s_flushes / s_frames, (double)s_refr_us / s_frames / 1000.0);
+    fflush(stdout);
+
+    lv_deinit();
+    free(buf);
+}
+
+int main(int argc, char **argv)
+{
+    const char *rows = "16,32,64,128,1080";
+    int opt;
+
+    while((opt = getopt(argc, argv, "r:c:W:H:s:h")) != -1) {
+        switch(opt) {
+        case 'r': rows = optarg; break;
+        case 'c': s_cf = atoi(optarg) == 32 ? LV_COLOR_FORMAT_XRGB8888 : LV_COLOR_FORMAT_RGB565; break;
+        case 'W': s_hor_res = atoi(optarg); break;
+        case 'H': s_ver_res = atoi(optarg); break;
+        case 's': s_speed = (uint32_t)atoi(optarg); break;
+        default:
+            fprintf(stderr, "tile_bench [-r 16,32,64,128,1080] [-c 16|32] [-W width] [-H height] [-s speed]\n");
+            return 1;
+        }
+    }
+    if(s_hor_res <= 0 || s_ver_res <= 0 || s_speed == 0) return 1;
+
+    s_fb = malloc((size_t)s_hor_res * s_ver_res * lv_color_format_get_size(s_cf));
+    if(s_fb == NULL) return 1;
+
+    printf("%dx%d %s, benchmark demo, PARTIAL mode\n", (int)s_hor_res, (int)s_ver_res,
+           s_cf == LV_COLOR_FORMAT_RGB565 ? "RGB565" : "XRGB8888");
+    printf("%6s %9s %8s %10s %10s\n", "rows", "tile KiB", "frames", "tiles/fr", "ms/frame");
+
+    const char *p = rows;
+    while(*p) {
+        char *end;
+        long n = strtol(p, &end, 10);
+        if(end == p) break;
+        if(n > 0) run((int32_t)n);
+        p = *end == ',' ? end + 1 : end;
+    }
+
+    free(s_fb);
+    return 0;
+}